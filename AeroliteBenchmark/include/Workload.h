@@ -0,0 +1,157 @@
+#ifndef AERO_BENCHMARK_WORKLOAD_H
+#define AERO_BENCHMARK_WORKLOAD_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "AeroWorld2D.h"
+
+namespace Aerolite {
+
+    /**
+     * @class Workload
+     * @brief A headless copy of one of the visualizer scenes, driven by a fixed time step instead of SDL.
+     *
+     * Mouse and keyboard input of the scenes is replaced by scripted events drawn from a seeded
+     * generator, so running the same workload with the same seed always simulates the same steps.
+     */
+    class Workload {
+    protected:
+        std::unique_ptr<AeroWorld2D> world;
+        std::mt19937 rng;
+        aero_uint64 stepIndex = 0;
+
+        static constexpr real WIDTH = 1920; ///< Window width of the visualizer.
+        static constexpr real HEIGHT = 1080; ///< Window height of the visualizer.
+
+    public:
+        Workload() = default;
+        virtual ~Workload() = default;
+
+        /**
+         * @brief Gets the name the workload is selected by and reported as.
+         */
+        virtual const char* GetName() const = 0;
+
+        /**
+         * @brief Builds the world of the scene.
+         * @param seed Seed of every random number the workload draws.
+         */
+        virtual void Setup(aero_uint32 seed) = 0;
+
+        /**
+         * @brief Runs one frame of the scene: the scripted input, the world update and the scene's own
+         * per-frame logic.
+         * @param dt The time step of the frame.
+         */
+        virtual void Step(real dt);
+
+        /**
+         * @brief Hashes the state of every body and particle, to check that two runs simulated the same thing.
+         */
+        aero_uint64 GetChecksum() const;
+
+        /**
+         * @brief Frees the world, so the memory of a finished workload does not count towards the next one.
+         */
+        void Destroy() { world.reset(); }
+
+        AeroWorld2D* GetWorld() const { return world.get(); }
+    };
+
+    /**
+     * @brief The pyramid of boxes of TheGreatPyramidScene.
+     */
+    class PyramidWorkload : public Workload {
+    private:
+        int pyramidHeight;
+    public:
+        explicit PyramidWorkload(int height = 20) : pyramidHeight(height) {}
+        const char* GetName() const override { return "pyramid"; }
+        void Setup(aero_uint32 seed) override;
+    };
+
+    /**
+     * @brief A wall of about 4200 small boxes resting on each other, with no visualizer counterpart. It settles
+     * into a single island with around 10k contacts, the case the graph coloring of the solver is made for.
+     */
+    class BoxWallWorkload : public Workload {
+    public:
+        const char* GetName() const override { return "box_wall"; }
+        void Setup(aero_uint32 seed) override;
+    };
+
+    /**
+     * @brief The 3000 bouncing circles of LargeParticleTestScene.
+     */
+    class LargeParticleWorkload : public Workload {
+    public:
+        const char* GetName() const override { return "particles"; }
+        void Setup(aero_uint32 seed) override;
+        void Step(real dt) override;
+    };
+
+    /**
+     * @brief The 10000 particles orbiting a fixed sun of SolarSystemScene.
+     */
+    class SolarSystemWorkload : public Workload {
+    private:
+        std::unique_ptr<Particle2D> sun;
+    public:
+        const char* GetName() const override { return "solar_system"; }
+        void Setup(aero_uint32 seed) override;
+        void Step(real dt) override;
+    };
+
+    /**
+     * @brief The rag doll of RagdollJointScene. The mouse dragging the doll around is replaced by random
+     * targets and the clicks by circles and pentagons dropped at random positions.
+     */
+    class RagdollWorkload : public Workload {
+    private:
+        AeroBody2D* bob = nullptr;
+        AeroVec2 target;
+    public:
+        const char* GetName() const override { return "ragdoll"; }
+        void Setup(aero_uint32 seed) override;
+        void Step(real dt) override;
+    };
+
+    /**
+     * @brief The towers, bridge and bird of FiveDollarFlappyBirdScene. The arrow keys are replaced by random
+     * impulses on the bird and the clicks by circles and boxes dropped at random positions.
+     */
+    class FlappyBirdWorkload : public Workload {
+    private:
+        AeroBody2D* bird = nullptr;
+    public:
+        const char* GetName() const override { return "flappy_bird"; }
+        void Setup(aero_uint32 seed) override;
+        void Step(real dt) override;
+    };
+
+    /**
+     * @brief Game server style churn with no visualizer counterpart: every step a volley of small projectiles
+     * is fired at a row of static targets, and projectiles are removed once they expire or leave the window.
+     */
+    class ProjectileWorkload : public Workload {
+    private:
+        struct Projectile {
+            AeroBodyHandle2D handle;
+            aero_uint64 spawnStep;
+        };
+        std::vector<Projectile> projectiles;
+    public:
+        const char* GetName() const override { return "projectiles"; }
+        void Setup(aero_uint32 seed) override;
+        void Step(real dt) override;
+    };
+
+    /**
+     * @brief Creates every workload of the suite, in the order they are run.
+     */
+    std::vector<std::unique_ptr<Workload>> CreateWorkloads();
+}
+
+#endif
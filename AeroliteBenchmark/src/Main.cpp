@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Workload.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Aerolite;
+
+namespace {
+    struct Options {
+        std::string workload; ///< Empty to run every workload.
+        std::string broadPhase = "scene"; ///< "scene" keeps the broad-phase the scene picked.
+        std::string output; ///< Empty to write to stdout.
+        int steps = 1000;
+        int warmup = 60;
+        aero_uint32 seed = 1;
+        aero_int32 workers = 1;
+        AeroWorldSettings2D settings;
+        real dt = make_real<real>(0.016);
+    };
+
+    struct StepStats {
+        double mean = 0, min = 0, max = 0, p50 = 0, p95 = 0;
+    };
+
+    void PrintUsage(std::ostream& out)
+    {
+        out << "Usage: AeroliteBenchmark [options]\n"
+            << "  --workload <name>     Run a single workload (default: all)\n"
+            << "  --steps <n>           Measured steps per workload (default: 1000)\n"
+            << "  --warmup <n>          Unmeasured steps run before measuring (default: 60)\n"
+            << "  --seed <n>            Seed of the scripted input and random layouts (default: 1)\n"
+            << "  --workers <n>         Worker threads of the world (default: 1)\n"
+            << "  --dt <seconds>        Time step (default: 0.016, the visualizer's cap)\n"
+            << "  --broadphase <alg>    scene, brute_force, shg, bvh or sap (default: scene)\n"
+            << "  --iterations <n>      Velocity iterations per sub-step (default: 3)\n"
+            << "  --relax <n>           Relax iterations per sub-step (default: 0)\n"
+            << "  --substeps <n>        Sub-steps per step (default: 1)\n"
+            << "  --block-solver <on|off>  Solve two-point manifolds as a block (default: on)\n"
+            << "  --coloring <n>        Constraints from which an island is graph colored, 0 for none, needs --workers > 1 (default: 0)\n"
+            << "  --output <file>       Write the JSON report to a file instead of stdout\n"
+            << "  --list                List the workloads and exit\n";
+    }
+
+    bool ParseOptions(const int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") {
+                PrintUsage(std::cout);
+                std::exit(EXIT_SUCCESS);
+            }
+            if (arg == "--list") {
+                for (const auto& workload : CreateWorkloads()) {
+                    std::cout << workload->GetName() << '\n';
+                }
+                std::exit(EXIT_SUCCESS);
+            }
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << '\n';
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            try {
+                if (arg == "--workload") options.workload = value;
+                else if (arg == "--steps") options.steps = std::max(1, std::stoi(value));
+                else if (arg == "--warmup") options.warmup = std::max(0, std::stoi(value));
+                else if (arg == "--seed") options.seed = static_cast<aero_uint32>(std::stoul(value));
+                else if (arg == "--workers") options.workers = std::max(1, std::stoi(value));
+                else if (arg == "--dt") options.dt = static_cast<real>(std::stod(value));
+                else if (arg == "--broadphase") options.broadPhase = value;
+                else if (arg == "--iterations") options.settings.velocity_iterations = std::max(0, std::stoi(value));
+                else if (arg == "--relax") options.settings.relax_iterations = std::max(0, std::stoi(value));
+                else if (arg == "--substeps") options.settings.sub_steps = std::max(1, std::stoi(value));
+                else if (arg == "--coloring") options.settings.coloring_threshold = std::max(0, std::stoi(value));
+                else if (arg == "--block-solver") {
+                    if (value != "on" && value != "off") throw std::invalid_argument(value);
+                    options.settings.block_solver = value == "on";
+                }
+                else if (arg == "--output") options.output = value;
+                else {
+                    std::cerr << "Unknown option " << arg << '\n';
+                    return false;
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "Invalid value for " << arg << ": " << value << '\n';
+                return false;
+            }
+        }
+
+        if (options.broadPhase != "scene" && options.broadPhase != "brute_force" &&
+            options.broadPhase != "shg" && options.broadPhase != "bvh" && options.broadPhase != "sap") {
+            std::cerr << "Unknown broad-phase " << options.broadPhase << '\n';
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Resets the peak resident memory of the process where the platform allows it, so that the
+     * peak reported for a workload is not the peak of an earlier one.
+     */
+    void ResetPeakMemory()
+    {
+#if defined(__linux__)
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        if (clearRefs) clearRefs << "5";
+#endif
+    }
+
+    /**
+     * @brief Gets the peak resident memory of the process in kilobytes.
+     */
+    long long GetPeakMemoryKb()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<long long>(counters.PeakWorkingSetSize / 1024);
+        }
+        return 0;
+#else
+#if defined(__linux__)
+        // VmHWM follows the resets done by ResetPeakMemory, ru_maxrss does not.
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::stoll(line.substr(6));
+            }
+        }
+#endif
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+    StepStats ComputeStepStats(std::vector<double> stepMs)
+    {
+        StepStats stats;
+        if (stepMs.empty()) return stats;
+
+        std::sort(stepMs.begin(), stepMs.end());
+        double sum = 0;
+        for (const double ms : stepMs) sum += ms;
+        stats.mean = sum / static_cast<double>(stepMs.size());
+        stats.min = stepMs.front();
+        stats.max = stepMs.back();
+        stats.p50 = stepMs[stepMs.size() / 2];
+        stats.p95 = stepMs[std::min(stepMs.size() - 1, stepMs.size() * 95 / 100)];
+        return stats;
+    }
+
+    void ApplyBroadPhase(AeroWorld2D& world, const std::string& broadPhase)
+    {
+        if (broadPhase == "brute_force") world.SetBroadPhaseAlgorithm(BroadPhaseAlg::BruteForce);
+        else if (broadPhase == "shg") world.SetBroadPhaseAlgorithm(BroadPhaseAlg::SHG);
+        else if (broadPhase == "bvh") world.SetBroadPhaseAlgorithm(BroadPhaseAlg::BVH);
+        else if (broadPhase == "sap") world.SetBroadPhaseAlgorithm(BroadPhaseAlg::SAP);
+    }
+
+    void RunWorkload(Workload& workload, const Options& options, std::ostream& out)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        ResetPeakMemory();
+        const auto setupStart = Clock::now();
+        workload.Setup(options.seed);
+        const double setupMs = std::chrono::duration<double, std::milli>(Clock::now() - setupStart).count();
+
+        AeroWorld2D& world = *workload.GetWorld();
+        ApplyBroadPhase(world, options.broadPhase);
+        world.SetWorkerCount(options.workers);
+        world.SetSettings(options.settings);
+
+        for (int i = 0; i < options.warmup; i++) {
+            workload.Step(options.dt);
+        }
+
+        AeroProfiler& profiler = world.GetProfiler();
+        profiler.SetCapacity(static_cast<std::size_t>(options.steps));
+
+        std::vector<double> stepMs;
+        stepMs.reserve(options.steps);
+        const auto runStart = Clock::now();
+        for (int i = 0; i < options.steps; i++) {
+            const auto stepStart = Clock::now();
+            workload.Step(options.dt);
+            stepMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count());
+        }
+        const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - runStart).count();
+
+        const StepStats stats = ComputeStepStats(stepMs);
+        const AeroStepProfile average = profiler.GetAverage();
+        const long long peakMemoryKb = GetPeakMemoryKb();
+
+        out << "    {\n"
+            << "      \"name\": \"" << workload.GetName() << "\",\n"
+            << "      \"bodies\": " << world.GetBodies().size() << ",\n"
+            << "      \"particles\": " << world.GetParticle2Ds().size() << ",\n"
+            << "      \"joints\": " << world.GetConstraints().size() << ",\n"
+            << "      \"setup_ms\": " << setupMs << ",\n"
+            << "      \"total_ms\": " << totalMs << ",\n"
+            << "      \"steps_per_second\": " << (options.steps * 1000.0 / totalMs) << ",\n"
+            << "      \"step_ms\": {\"mean\": " << stats.mean << ", \"min\": " << stats.min << ", \"max\": " << stats.max
+            << ", \"p50\": " << stats.p50 << ", \"p95\": " << stats.p95 << "},\n"
+            << "      \"phases_ms\": {";
+        for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            out << (phase == 0 ? "" : ", ") << '"' << AeroProfiler::GetPhaseName(static_cast<ProfilePhase>(phase))
+                << "\": " << average.phase_ms[phase];
+        }
+        out << "},\n"
+            << "      \"counters\": {\"pairs\": " << average.pair_count << ", \"contacts\": " << average.contact_count
+            << ", \"constraints\": " << average.constraint_count << ", \"awake_bodies\": " << average.awake_body_count
+            << ", \"islands\": " << average.island_count << "},\n"
+            << "      \"peak_memory_kb\": " << peakMemoryKb << ",\n"
+            << "      \"frame_arena_high_water_bytes\": " << world.GetFrameArena().GetHighWaterMark() << ",\n"
+            << "      \"checksum\": \"" << std::hex << std::setw(16) << std::setfill('0') << workload.GetChecksum()
+            << std::dec << std::setfill(' ') << "\"\n"
+            << "    }";
+
+        workload.Destroy();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::unique_ptr<Workload>> workloads = CreateWorkloads();
+    if (!options.workload.empty()) {
+        std::erase_if(workloads, [&options](const std::unique_ptr<Workload>& workload) {
+            return options.workload != workload->GetName();
+        });
+        if (workloads.empty()) {
+            std::cerr << "Unknown workload " << options.workload << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ostringstream report;
+    report << std::setprecision(9);
+    report << "{\n"
+           << "  \"real\": \"" << (sizeof(real) == sizeof(double) ? "double" : "float") << "\",\n"
+#ifdef AERO_ENABLE_PROFILER
+           << "  \"profiler\": true,\n"
+#else
+           << "  \"profiler\": false,\n"
+#endif
+           << "  \"steps\": " << options.steps << ",\n"
+           << "  \"warmup\": " << options.warmup << ",\n"
+           << "  \"seed\": " << options.seed << ",\n"
+           << "  \"workers\": " << options.workers << ",\n"
+           << "  \"dt\": " << options.dt << ",\n"
+           << "  \"broadphase\": \"" << options.broadPhase << "\",\n"
+           << "  \"velocity_iterations\": " << options.settings.velocity_iterations << ",\n"
+           << "  \"relax_iterations\": " << options.settings.relax_iterations << ",\n"
+           << "  \"sub_steps\": " << options.settings.sub_steps << ",\n"
+           << "  \"block_solver\": " << (options.settings.block_solver ? "true" : "false") << ",\n"
+           << "  \"coloring_threshold\": " << options.settings.coloring_threshold << ",\n"
+           << "  \"workloads\": [\n";
+    for (std::size_t i = 0; i < workloads.size(); i++) {
+        RunWorkload(*workloads[i], options, report);
+        report << (i + 1 < workloads.size() ? ",\n" : "\n");
+    }
+    report << "  ]\n}\n";
+
+    if (options.output.empty()) {
+        std::cout << report.str();
+    }
+    else {
+        std::ofstream file(options.output);
+        if (!file) {
+            std::cerr << "Could not open " << options.output << '\n';
+            return EXIT_FAILURE;
+        }
+        file << report.str();
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,450 @@
+#include <cmath>
+#include <cstring>
+#include "Constants.h"
+#include "pfgen.h"
+#include "Shape.h"
+#include "Workload.h"
+
+namespace Aerolite {
+
+    namespace {
+        // Friction and restitution the visualizer forces onto every body of the running scene.
+        constexpr real GLOBAL_FRICTION = 0.5;
+        constexpr real GLOBAL_RESTITUTION = 0.1;
+
+        void ApplyGlobalMaterial(const AeroWorld2D& world)
+        {
+            for (const auto& body : world.GetBodies()) {
+                body->SetFriction(GLOBAL_FRICTION);
+                body->SetRestitution(GLOBAL_RESTITUTION);
+            }
+        }
+
+        void HashValue(aero_uint64& hash, const real value)
+        {
+            // FNV-1a over the bits of the value, so that any divergence between two runs changes the hash.
+            unsigned char bytes[sizeof(real)];
+            std::memcpy(bytes, &value, sizeof(real));
+            for (const unsigned char byte : bytes) {
+                hash ^= byte;
+                hash *= 1099511628211ull;
+            }
+        }
+    }
+
+    void Workload::Step(const real dt)
+    {
+        world->Update(dt);
+        stepIndex++;
+    }
+
+    aero_uint64 Workload::GetChecksum() const
+    {
+        aero_uint64 hash = 14695981039346656037ull;
+        for (const auto& body : world->GetBodies()) {
+            HashValue(hash, body->GetPosition().x);
+            HashValue(hash, body->GetPosition().y);
+            HashValue(hash, body->GetRotation());
+            HashValue(hash, body->GetLinearVelocity().x);
+            HashValue(hash, body->GetLinearVelocity().y);
+            HashValue(hash, body->GetAngularVelocity());
+        }
+        for (const Particle2D* particle : world->GetParticle2Ds()) {
+            HashValue(hash, particle->position.x);
+            HashValue(hash, particle->position.y);
+            HashValue(hash, particle->velocity.x);
+            HashValue(hash, particle->velocity.y);
+        }
+        return hash;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // TheGreatPyramidScene
+    ///////////////////////////////////////////////////////////////////////////////
+    void PyramidWorkload::Setup(const aero_uint32 seed)
+    {
+        rng.seed(seed);
+        stepIndex = 0;
+        world = std::make_unique<AeroWorld2D>(-9.8);
+        world->ShgSetBounds({ 0, 0 }, { WIDTH, HEIGHT });
+        world->ShgSetCellWidth(100);
+        world->ShgSetCellHeight(100);
+        world->SetBroadPhaseAlgorithm(BroadPhaseAlg::SHG);
+
+        world->CreateBody2D(std::make_shared<BoxShape>(WIDTH, 500), WIDTH / 2, HEIGHT + 230, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT), 0, HEIGHT / 2 - 35, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT * 10), WIDTH, HEIGHT / 2 - 35, 0);
+
+        const auto boxShape = std::make_shared<BoxShape>(50, 50);
+        for (int row = 0; row < pyramidHeight; ++row) {
+            for (int col = 0; col <= row; ++col) {
+                const real x = WIDTH / 2 + (col - row / make_real<real>(2.0)) * 50;
+                const real y = 40 + row * make_real<real>(50.0);
+                world->CreateBody2D(boxShape, x, y, 1);
+            }
+        }
+
+        ApplyGlobalMaterial(*world);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Box wall (no visualizer scene)
+    ///////////////////////////////////////////////////////////////////////////////
+    void BoxWallWorkload::Setup(const aero_uint32 seed)
+    {
+        rng.seed(seed);
+        stepIndex = 0;
+        world = std::make_unique<AeroWorld2D>(-9.8);
+        world->ShgSetBounds({ 0, 0 }, { WIDTH, HEIGHT });
+        world->ShgSetCellWidth(50);
+        world->ShgSetCellHeight(50);
+        world->SetBroadPhaseAlgorithm(BroadPhaseAlg::SHG);
+
+        world->CreateBody2D(std::make_shared<BoxShape>(WIDTH, 500), WIDTH / 2, HEIGHT + 230, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT), 0, HEIGHT / 2 - 35, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT * 10), WIDTH, HEIGHT / 2 - 35, 0);
+
+        // Columns of 20 pixel boxes a pixel apart, from the floor (at HEIGHT - 20) almost to the top.
+        constexpr int columns = 88;
+        constexpr int rows = 48;
+        constexpr real spacing = 21;
+        const real left = WIDTH / 2 - (columns - 1) * spacing / 2;
+        const auto boxShape = std::make_shared<BoxShape>(20, 20);
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < columns; ++col) {
+                world->CreateBody2D(boxShape, left + col * spacing, HEIGHT - 31 - row * spacing, 1);
+            }
+        }
+
+        ApplyGlobalMaterial(*world);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // LargeParticleTestScene
+    ///////////////////////////////////////////////////////////////////////////////
+    void LargeParticleWorkload::Setup(const aero_uint32 seed)
+    {
+        rng.seed(seed);
+        stepIndex = 0;
+        world = std::make_unique<AeroWorld2D>(0);
+        world->SetBroadPhaseAlgorithm(BroadPhaseAlg::SHG);
+        world->ShgSetBounds({ 0, 0 }, { WIDTH, HEIGHT });
+        world->ShgSetCellWidth(10);
+        world->ShgSetCellHeight(10);
+
+        std::uniform_real_distribution<real> xDist(0, WIDTH);
+        std::uniform_real_distribution<real> yDist(0, HEIGHT);
+        std::uniform_real_distribution<real> velDist(-1500, 1500);
+        const auto particleShape = std::make_shared<CircleShape>(2);
+        for (int i = 0; i < 3000; ++i) {
+            const real x = xDist(rng);
+            const real y = yDist(rng);
+            const real vx = velDist(rng);
+            const real vy = velDist(rng);
+            const auto body = world->CreateBody2D(particleShape, x, y, 1);
+            body->SetLinearVelocity(AeroVec2(vx, vy));
+        }
+
+        ApplyGlobalMaterial(*world);
+    }
+
+    void LargeParticleWorkload::Step(const real dt)
+    {
+        Workload::Step(dt);
+
+        // Bounce the circles off the window borders.
+        for (const auto& body : world->GetBodies()) {
+            constexpr real radius = 2;
+            const AeroVec2 position = body->GetPosition();
+            AeroVec2 velocity = body->GetLinearVelocity();
+            if (position.x - radius < 0 || position.x + radius > WIDTH) {
+                velocity.x = -velocity.x;
+            }
+            if (position.y - radius < 0 || position.y + radius > HEIGHT) {
+                velocity.y = -velocity.y;
+            }
+            body->SetLinearVelocity(velocity);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // SolarSystemScene
+    ///////////////////////////////////////////////////////////////////////////////
+    void SolarSystemWorkload::Setup(const aero_uint32 seed)
+    {
+        rng.seed(seed);
+        stepIndex = 0;
+        world = std::make_unique<AeroWorld2D>(0);
+        sun = std::make_unique<Particle2D>(WIDTH / 2, HEIGHT / 2, MASS_OF_SUN);
+        sun->radius = 30;
+
+        std::uniform_real_distribution<real> distAngle(0, 2 * M_PI);
+        std::uniform_real_distribution<real> distRadius(100, 700);
+        for (int i = 0; i < 10000; ++i) {
+            const real radius = distRadius(rng);
+            const real angle = distAngle(rng);
+            const real x = radius * RealCos(angle);
+            const real y = radius * RealSin(angle);
+
+            // Circular orbit: the velocity is perpendicular to the radial vector.
+            const real speed = RealSqrt(GRAV_CONSTANT * sun->mass / radius);
+            auto planet = std::make_shared<Particle2D>(sun->position.x + x, sun->position.y + y, MASS_OF_EARTH);
+            planet->velocity = AeroVec2(-y, x).UnitVector() * speed;
+            planet->radius = 10;
+            world->AddParticle2D(std::move(planet));
+        }
+    }
+
+    void SolarSystemWorkload::Step(const real dt)
+    {
+        // The scene also applies the opposite force to the sun, but never integrates it, so the sun stays put.
+        const auto planets = world->GetParticle2Ds();
+        for (Particle2D* planet : planets) {
+            planet->ApplyForce(Particle2DForceGenerators::GenerateGravitationalAttractionForce(*planet, *sun, 5, 1000, GRAV_CONSTANT));
+        }
+
+        Workload::Step(dt);
+
+        // Keep the particles inside the window.
+        for (Particle2D* particle : planets) {
+            if (particle->position.x - particle->radius <= 0) {
+                particle->position.x = particle->radius;
+                particle->velocity.x *= make_real<real>(-0.95);
+            }
+            else if (particle->position.x + particle->radius >= WIDTH) {
+                particle->position.x = WIDTH - particle->radius;
+                particle->velocity.x *= make_real<real>(-0.95);
+            }
+            if (particle->position.y - particle->radius <= 0) {
+                particle->position.y = particle->radius;
+                particle->velocity.y *= make_real<real>(-0.95);
+            }
+            else if (particle->position.y + particle->radius >= HEIGHT) {
+                particle->position.y = HEIGHT - particle->radius;
+                particle->velocity.y *= make_real<real>(-0.95);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // RagdollJointScene
+    ///////////////////////////////////////////////////////////////////////////////
+    void RagdollWorkload::Setup(const aero_uint32 seed)
+    {
+        rng.seed(seed);
+        stepIndex = 0;
+        world = std::make_unique<AeroWorld2D>(-9.8);
+
+        bob = world->CreateBody2D(std::make_shared<CircleShape>(5), WIDTH / 2, HEIGHT / 2, 0);
+        const auto head = world->CreateBody2D(std::make_shared<CircleShape>(25), bob->GetPosition().x, bob->GetPosition().y + 70, 5);
+        const auto torso = world->CreateBody2D(std::make_shared<BoxShape>(50, 100), head->GetPosition().x, head->GetPosition().y + 80, 3);
+        const auto leftArm = world->CreateBody2D(std::make_shared<BoxShape>(15, 70), torso->GetPosition().x - 32, torso->GetPosition().y - 10, 1);
+        const auto rightArm = world->CreateBody2D(std::make_shared<BoxShape>(15, 70), torso->GetPosition().x + 32, torso->GetPosition().y - 10, 1);
+        const auto leftLeg = world->CreateBody2D(std::make_shared<BoxShape>(20, 90), torso->GetPosition().x - 20, torso->GetPosition().y + 97, 1);
+        const auto rightLeg = world->CreateBody2D(std::make_shared<BoxShape>(20, 90), torso->GetPosition().x + 20, torso->GetPosition().y + 97, 1);
+
+        world->AddJointConstraint(bob, head, bob->GetPosition());
+        world->AddJointConstraint(head, torso, head->GetPosition() + AeroVec2(0, 25));
+        world->AddJointConstraint(torso, leftArm, torso->GetPosition() + AeroVec2(-28, -45));
+        world->AddJointConstraint(torso, rightArm, torso->GetPosition() + AeroVec2(+28, -45));
+        world->AddJointConstraint(torso, leftLeg, torso->GetPosition() + AeroVec2(-20, 50));
+        world->AddJointConstraint(torso, rightLeg, torso->GetPosition() + AeroVec2(20, 50));
+
+        world->CreateBody2D(std::make_shared<BoxShape>(WIDTH - 50, 50), WIDTH / 2, HEIGHT - 50, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT - 50), 0, HEIGHT / 2, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT - 50), WIDTH, HEIGHT / 2, 0);
+
+        target = bob->GetPosition();
+        ApplyGlobalMaterial(*world);
+    }
+
+    void RagdollWorkload::Step(const real dt)
+    {
+        std::uniform_real_distribution<real> xDist(100, WIDTH - 100);
+        std::uniform_real_distribution<real> yDist(100, HEIGHT / 2);
+
+        // The mouse moves somewhere else every second and a half, and bob follows it 5 pixels per frame.
+        if (stepIndex % 90 == 0) {
+            target = AeroVec2(xDist(rng), yDist(rng));
+        }
+        if (bob->GetPosition().DistanceTo(target) > 5) {
+            bob->SetPosition(bob->GetPosition() + (target - bob->GetPosition()).UnitVector() * 5);
+        }
+
+        // A click every two seconds drops a circle or a pentagon, alternating like left and right clicks.
+        if (stepIndex % 120 == 60 && stepIndex / 120 < 24) {
+            const real x = xDist(rng);
+            const real y = yDist(rng);
+            if ((stepIndex / 120) % 2 == 0) {
+                world->CreateBody2D(std::make_shared<CircleShape>(50), x, y, 2);
+            }
+            else {
+                world->CreateBody2D(PolygonShape::CreateRegularPolygon(5, 50), x, y, 1);
+            }
+            ApplyGlobalMaterial(*world);
+        }
+
+        Workload::Step(dt);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // FiveDollarFlappyBirdScene
+    ///////////////////////////////////////////////////////////////////////////////
+    void FlappyBirdWorkload::Setup(const aero_uint32 seed)
+    {
+        rng.seed(seed);
+        stepIndex = 0;
+        world = std::make_unique<AeroWorld2D>(-9.8);
+        world->ShgSetBounds({ 0, 0 }, { WIDTH, HEIGHT });
+        world->ShgSetCellWidth(100);
+        world->ShgSetCellHeight(100);
+        world->SetBroadPhaseAlgorithm(BroadPhaseAlg::SHG);
+
+        bird = world->CreateBody2D(std::make_shared<CircleShape>(45), 100, HEIGHT / 2 + 220, 3);
+
+        const auto floor = world->CreateBody2D(std::make_shared<BoxShape>(WIDTH - 50, 50), WIDTH / 2, HEIGHT / 2 + 290, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT - 200), 0, HEIGHT / 2 - 35, 0);
+        world->CreateBody2D(std::make_shared<BoxShape>(50, HEIGHT - 200), WIDTH, HEIGHT / 2 - 35, 0);
+
+        // Stack of boxes.
+        for (int i = 1; i <= 4; i++) {
+            world->CreateBody2D(std::make_shared<BoxShape>(50, 50), 600, floor->GetPosition().y - i * 55, 10 / static_cast<real>(i));
+        }
+
+        // Structure of planks with a triangle on top.
+        const auto plank1 = world->CreateBody2D(std::make_shared<BoxShape>(50, 150), WIDTH / 2 + 20, floor->GetPosition().y - 100, 5);
+        const auto plank2 = world->CreateBody2D(std::make_shared<BoxShape>(50, 150), WIDTH / 2 + 180, floor->GetPosition().y - 100, 5);
+        const auto plank3 = world->CreateBody2D(std::make_shared<BoxShape>(250, 25), WIDTH / 2 + 100, floor->GetPosition().y - 200, 2);
+        const std::vector triangleVertices = { AeroVec2(30, 30), AeroVec2(-30, 30), AeroVec2(0, -30) };
+        world->CreateBody2D(std::make_shared<PolygonShape>(triangleVertices), plank3->GetPosition().x, plank3->GetPosition().y - 50, make_real<real>(0.5));
+
+        // Pyramid of boxes.
+        constexpr int numRows = 5;
+        for (int col = 0; col < numRows; col++) {
+            for (int row = 0; row < col; row++) {
+                const real x = plank3->GetPosition().x + 200 + col * 50 - row * 25;
+                const real y = floor->GetPosition().y - 50 - row * 52;
+                world->CreateBody2D(std::make_shared<BoxShape>(50, 50), x, y, 5 / (row + make_real<real>(1.0)));
+            }
+        }
+
+        // Bridge of circles connected by joints between two static steps.
+        constexpr int numSteps = 10;
+        auto lastStep = world->CreateBody2D(std::make_shared<BoxShape>(80, 20), 200, 200, 0);
+        for (int i = 1; i <= numSteps; i++) {
+            const real x = lastStep->GetPosition().x + 30 + i;
+            const real y = lastStep->GetPosition().y + 20;
+            const real mass = (i == numSteps) ? 0 : 3;
+            auto step = world->CreateBody2D(std::make_shared<CircleShape>(15), x, y, mass);
+            world->AddJointConstraint(lastStep, step, step->GetPosition());
+            lastStep = step;
+        }
+        world->CreateBody2D(std::make_shared<BoxShape>(80, 20), lastStep->GetPosition().x + 60, lastStep->GetPosition().y - 20, 0);
+
+        // Pigs.
+        world->CreateBody2D(std::make_shared<CircleShape>(30), plank1->GetPosition().x + 80, floor->GetPosition().y - 50, 3);
+        world->CreateBody2D(std::make_shared<CircleShape>(30), plank2->GetPosition().x + 400, floor->GetPosition().y - 50, 3);
+        world->CreateBody2D(std::make_shared<CircleShape>(30), plank2->GetPosition().x + 460, floor->GetPosition().y - 50, 3);
+        world->CreateBody2D(std::make_shared<CircleShape>(30), 220, 130, 1);
+
+        ApplyGlobalMaterial(*world);
+    }
+
+    void FlappyBirdWorkload::Step(const real dt)
+    {
+        // A key press every three quarters of a second, like the up, left and right arrows of the scene.
+        if (stepIndex % 45 == 0) {
+            switch (std::uniform_int_distribution<int>(0, 2)(rng)) {
+            case 0: bird->ApplyImpulseLinear(AeroVec2(0, -600)); break;
+            case 1: bird->ApplyImpulseLinear(AeroVec2(-400, 0)); break;
+            default: bird->ApplyImpulseLinear(AeroVec2(400, 0)); break;
+            }
+        }
+
+        // A click every two and a half seconds drops a circle or a box, alternating like left and right clicks.
+        if (stepIndex % 150 == 75 && stepIndex / 150 < 16) {
+            const real x = std::uniform_real_distribution<real>(100, WIDTH - 100)(rng);
+            const real y = std::uniform_real_distribution<real>(100, HEIGHT / 2)(rng);
+            if ((stepIndex / 150) % 2 == 0) {
+                world->CreateBody2D(std::make_shared<CircleShape>(50), x, y, 2);
+            }
+            else {
+                world->CreateBody2D(std::make_shared<BoxShape>(50, 50), x, y, 1);
+            }
+            ApplyGlobalMaterial(*world);
+        }
+
+        Workload::Step(dt);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Projectiles
+    ///////////////////////////////////////////////////////////////////////////////
+    void ProjectileWorkload::Setup(const aero_uint32 seed)
+    {
+        rng.seed(seed);
+        stepIndex = 0;
+        projectiles.clear();
+        world = std::make_unique<AeroWorld2D>(-9.8);
+        world->ShgSetBounds({ 0, 0 }, { WIDTH, HEIGHT });
+        world->ShgSetCellWidth(50);
+        world->ShgSetCellHeight(50);
+        world->SetBroadPhaseAlgorithm(BroadPhaseAlg::SHG);
+
+        world->CreateBody2D(std::make_shared<BoxShape>(WIDTH, 100), WIDTH / 2, HEIGHT, 0);
+        for (int i = 0; i < 8; ++i) {
+            world->CreateBody2D(std::make_shared<BoxShape>(40, 200), WIDTH / 2 + i * 100, HEIGHT - 300, 0);
+        }
+
+        ApplyGlobalMaterial(*world);
+    }
+
+    void ProjectileWorkload::Step(const real dt)
+    {
+        constexpr int projectilesPerStep = 20;
+        constexpr aero_uint64 lifetimeSteps = 90;
+
+        // Remove the projectiles that expired or left the window. The handles of projectiles removed
+        // since no longer resolve, so a stale handle can never remove a body spawned in the same slot.
+        std::erase_if(projectiles, [this](const Projectile& projectile) {
+            AeroBody2D* body = world->GetBody(projectile.handle);
+            if (body == nullptr) return true;
+
+            const bool outside = body->GetPosition().x < 0 || body->GetPosition().x > WIDTH ||
+                body->GetPosition().y < 0 || body->GetPosition().y > HEIGHT;
+            if (!outside && stepIndex - projectile.spawnStep < lifetimeSteps) return false;
+
+            world->RemoveBody2D(projectile.handle);
+            return true;
+        });
+
+        std::uniform_real_distribution<real> yDist(HEIGHT / 4, HEIGHT - 100);
+        std::uniform_real_distribution<real> speedDist(600, 1400);
+        std::uniform_real_distribution<real> angleDist(-make_real<real>(0.3), make_real<real>(0.1));
+        for (int i = 0; i < projectilesPerStep; ++i) {
+            const real y = yDist(rng);
+            const real speed = speedDist(rng);
+            const real angle = angleDist(rng);
+            AeroBody2D* body = world->CreateBody2D(std::make_shared<CircleShape>(4), 10, y, make_real<real>(0.2));
+            body->SetLinearVelocity(AeroVec2(speed * std::cos(angle), speed * std::sin(angle)));
+            body->SetFriction(GLOBAL_FRICTION);
+            body->SetRestitution(GLOBAL_RESTITUTION);
+            projectiles.push_back({ body->handle, stepIndex });
+        }
+
+        Workload::Step(dt);
+    }
+
+    std::vector<std::unique_ptr<Workload>> CreateWorkloads()
+    {
+        std::vector<std::unique_ptr<Workload>> workloads;
+        workloads.push_back(std::make_unique<PyramidWorkload>());
+        workloads.push_back(std::make_unique<LargeParticleWorkload>());
+        workloads.push_back(std::make_unique<SolarSystemWorkload>());
+        workloads.push_back(std::make_unique<RagdollWorkload>());
+        workloads.push_back(std::make_unique<FlappyBirdWorkload>());
+        workloads.push_back(std::make_unique<ProjectileWorkload>());
+        workloads.push_back(std::make_unique<BoxWallWorkload>());
+        return workloads;
+    }
+}
@@ -1,6 +1,8 @@
 #ifndef AABB2D_H
 #define AABB2D_H
 
+#include <algorithm>
+#include <span>
 #include "AeroVec2.h"
 #include "Precision.h"
 
@@ -95,6 +97,56 @@ namespace Aerolite {
                 (point.y >= min.y && point.y <= max.y);
         }
 
+        /**
+         * @brief Checks if this AABB fully contains another AABB.
+         * @param other The AABB to check.
+         * @return True if the other AABB lies entirely inside this one, false otherwise.
+         */
+        [[nodiscard]] bool Contains(const AeroAABB2D& other) const
+        {
+            return min.x <= other.min.x && min.y <= other.min.y &&
+                other.max.x <= max.x && other.max.y <= max.y;
+        }
+
+        /**
+         * @brief Computes the perimeter of the AABB. Used as the insertion cost metric of the BVH.
+         * @return The perimeter of the AABB.
+         */
+        [[nodiscard]] real Perimeter() const
+        {
+            return 2 * ((max.x - min.x) + (max.y - min.y));
+        }
+
+        /**
+         * @brief Computes the smallest AABB enclosing two AABBs.
+         * @param a The first AABB.
+         * @param b The second AABB.
+         * @return The union of a and b.
+         */
+        [[nodiscard]] static AeroAABB2D Combine(const AeroAABB2D& a, const AeroAABB2D& b)
+        {
+            return {
+                AeroVec2(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y)),
+                AeroVec2(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y))
+            };
+        }
+
+        /**
+         * @brief Computes the smallest AABB enclosing a set of points, two coordinates at a time when SIMD is available.
+         * @param points The points to enclose.
+         * @return The bounds of the points, an empty AABB if there are none.
+         */
+        [[nodiscard]] static AeroAABB2D FromPoints(std::span<const AeroVec2> points);
+
+        /**
+         * @brief Computes the smallest AABB enclosing a set of points given one array per coordinate, two points
+         * at a time when SIMD is available.
+         * @param x The x coordinates of the points.
+         * @param y The y coordinates of the points, as many as x.
+         * @return The bounds of the points, an empty AABB if there are none.
+         */
+        [[nodiscard]] static AeroAABB2D FromPoints(std::span<const real> x, std::span<const real> y);
+
         /**
          * @brief Enlarges the AABB to include a given point.
          * @param point The point to enclose within the AABB.
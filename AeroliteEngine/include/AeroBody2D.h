@@ -2,6 +2,8 @@
 #define BODY2D_H
 
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "AeroVec2.h"
 #include "Shape.h"
@@ -10,6 +12,40 @@
 
 namespace Aerolite {
 
+    /**
+     * @struct AeroBodyHandle2D
+     * @brief Generational handle of a body owned by a world. A handle outlives the body it refers to:
+     * once the body is removed the world no longer resolves it, even if its slot was reused since.
+     */
+    struct AeroBodyHandle2D {
+        static constexpr aero_uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+        aero_uint32 index = INVALID_INDEX; ///< Slot of the body in the world's body pool.
+        aero_uint32 generation = 0; ///< Generation of the slot when the body was created.
+
+        [[nodiscard]] bool IsNull() const { return index == INVALID_INDEX; }
+        friend bool operator==(const AeroBodyHandle2D&, const AeroBodyHandle2D&) = default;
+    };
+
+    /**
+     * @struct AeroBodyStates2D
+     * @brief The fields of the bodies of a pool that every step reads and writes, one array per field.
+     * Row i belongs to the body at index i of AeroBodyPool2D::GetBodies, so the solver and the integrator
+     * walk packed arrays instead of whole body objects. The rows are managed by the pool.
+     */
+    struct AeroBodyStates2D {
+        static constexpr aero_uint8 STATIC = 1; ///< Flag of bodies with a mass of zero.
+        static constexpr aero_uint8 SLEEPING = 2; ///< Flag of sleeping bodies.
+
+        std::vector<AeroVec2> positions; ///< Position in world space coordinates.
+        std::vector<real> rotations; ///< Rotation angle in radians around the Z-axis.
+        std::vector<AeroVec2> linear_velocities; ///< Linear velocity in world space.
+        std::vector<real> angular_velocities; ///< Angular velocity in rad/s.
+        std::vector<real> inv_masses; ///< Inverse mass, zero for static bodies.
+        std::vector<real> inv_inertias; ///< Inverse moment of inertia, zero for static bodies.
+        std::vector<aero_uint8> flags; ///< STATIC and SLEEPING bits.
+    };
+
     /**
      * \brief Represents a 2-Dimensional physical body. This is the basic simulation
      * object for the 2D portion of the physics engine.
@@ -19,40 +55,95 @@ namespace Aerolite {
     private:
         AeroVec2 sum_forces; ///< Accumulated sum of forces applied to the body.
         real sum_torque; ///< Accumulated sum of torques applied to the body.
+        std::vector<real> world_lanes; ///< x, y, normal x and normal y of a polygon shape at the body's pose one after the other, empty for other shapes. See GetPolygonLanes.
+        AeroBodyStates2D* states; ///< Arrays of the pool that owns the body, holding its position, rotation, velocities, inverse mass and flags.
+        aero_uint32 state_index; ///< Row of the body in states. Managed by the pool.
+
+        friend class AeroBodyPool2D;
     public:
-        aero_uint16 id; ///< Unique identifier for the body.
-        AeroVec2 position; ///< Position of the body in world space coordinates.
-        AeroVec2 linear_velocity; ///< Linear linear_velocity of the body.
+        aero_uint32 id; ///< Identifier of the body, unique among the live bodies of its world. Managed by the world.
         AeroVec2 linear_acceleration; ///< Linear linear_acceleration of the body.
-        real rotation; ///< Current rotation angle (in radians) of the body around the Z-axis.
-        real angular_velocity; ///< Angular linear_velocity of the body (rad/s).
+        AeroVec2 previous_position; ///< Position before the last update run by the world's Step, used for interpolation.
+        real previous_rotation; ///< Rotation before the last update run by the world's Step, used for interpolation.
         real angular_acceleration; ///< Angular linear_acceleration of the body (rad/s^2).
         real linear_damping; ///< Coefficient for linear damping, reducing linear linear_velocity over time.
         real angular_damping; ///< Coefficient for angular damping, reducing angular linear_velocity over time.
         real mass; ///< Mass of the body. A mass of 0 indicates a static body.
-        real inv_mass; ///< Inverse mass of the body for efficient computation. Zero for static bodies.
         real inertia; ///< Moment of inertia of the body, defining resistance to rotational linear_acceleration.
-        real inv_inertia; ///< Inverse of the moment of inertia for efficient computation.
         real restitution; ///< Coefficient of restitution (bounciness) of the body.
         real friction; ///< Coefficient of friction affecting tangential collision response.
-        std::shared_ptr<Shape> shape; ///< Shape of the body, defining its geometric representation.
-        bool is_sleeping; ///< Flag indicating if the body is currently in a sleeping state to optimize simulation.
-        unsigned int sleep_timer; ///< Timer for tracking how long the body has been inactive.
+        std::shared_ptr<const Shape> shape; ///< Shape of the body, defining its geometric representation. May be shared with other bodies.
+        real sleep_timer; ///< Time (in seconds) the body has been resting below the world's sleep thresholds.
+        aero_int32 island_index; ///< Sleeping island of the body while it sleeps, -1 otherwise. Managed by the world.
+        aero_int32 bvh_proxy; ///< Proxy of this body in the world's BVH broad-phase tree, -1 if it has none.
+        aero_int32 sap_proxy; ///< Proxy of this body in the world's sweep and prune broad-phase, -1 if it has none.
+        AeroBodyHandle2D handle; ///< Handle of this body in the world that owns it, its index is the id. Managed by the world.
         /**
          * @brief Construct a new AeroBody2D object with specified shape, position, and mass.
          *
-         * @param shape Pointer to the shape representing the body's geometry.
+         * @param states The arrays that hold the position, rotation, velocities, inverse mass and flags of the body.
+         * @param stateIndex The row of the body in states, it has to exist already.
+         * @param shape Pointer to the shape representing the body's geometry. The body never modifies it, so it can be shared.
          * @param x Initial x-coordinate of the body's position.
          * @param y Initial y-coordinate of the body's position.
          * @param mass Mass of the body, where a value of 0 indicates a static (immovable) body.
          */
-        AeroBody2D(const std::shared_ptr<Shape>& shape, const real x, const real y, const real mass);
+        AeroBody2D(AeroBodyStates2D& states, aero_uint32 stateIndex, const std::shared_ptr<const Shape>& shape, const real x, const real y, const real mass);
 
         /**
          * @brief Destroy the AeroBody2D object, performing necessary cleanup.
          */
         ~AeroBody2D() = default;
 
+        /** @brief Gets the position of the body in world space coordinates. */
+        AeroVec2 GetPosition() const { return states->positions[state_index]; }
+
+        /**
+         * @brief Sets the position of the body. Call UpdateWorldVertices once the pose is set.
+         * @param position The new position in world space coordinates.
+         */
+        void SetPosition(const AeroVec2& position) { states->positions[state_index] = position; }
+
+        /** @brief Gets the rotation angle of the body in radians around the Z-axis. */
+        real GetRotation() const { return states->rotations[state_index]; }
+
+        /**
+         * @brief Sets the rotation angle of the body. Call UpdateWorldVertices once the pose is set.
+         * @param rotation The new rotation angle in radians.
+         */
+        void SetRotation(const real rotation) { states->rotations[state_index] = rotation; }
+
+        /** @brief Gets the linear velocity of the body in world space. */
+        AeroVec2 GetLinearVelocity() const { return states->linear_velocities[state_index]; }
+
+        /** @brief Sets the linear velocity of the body in world space. */
+        void SetLinearVelocity(const AeroVec2& velocity) { states->linear_velocities[state_index] = velocity; }
+
+        /** @brief Gets the angular velocity of the body in rad/s. */
+        real GetAngularVelocity() const { return states->angular_velocities[state_index]; }
+
+        /** @brief Sets the angular velocity of the body in rad/s. */
+        void SetAngularVelocity(const real velocity) { states->angular_velocities[state_index] = velocity; }
+
+        /** @brief Gets the inverse mass of the body, zero for static bodies. */
+        real GetInvMass() const { return states->inv_masses[state_index]; }
+
+        /** @brief Gets the inverse moment of inertia of the body, zero for static bodies. */
+        real GetInvInertia() const { return states->inv_inertias[state_index]; }
+
+        /** @brief Checks if the body is sleeping, see Sleep and Awake. */
+        bool IsSleeping() const { return (states->flags[state_index] & AeroBodyStates2D::SLEEPING) != 0; }
+
+        /**
+         * @brief Gets the arrays of the pool that owns the body, see GetStateIndex.
+         */
+        AeroBodyStates2D& GetStates() const { return *states; }
+
+        /**
+         * @brief Gets the row of the body in the arrays of its pool. It changes when another body is removed.
+         */
+        aero_uint32 GetStateIndex() const { return state_index; }
+
         /**
          * @brief Calculates and returns the Axis-Aligned Bounding Box (AABB) of the body.
          *
@@ -61,14 +152,48 @@ namespace Aerolite {
         AeroAABB2D GetAABB() const;
 
         /**
-         * @brief Integrates the body's forces to update its linear and angular accelerations.
+         * @brief Gets the vertices and edge normals of the body's polygon shape in world space, one array per
+         * coordinate, as of the last call to UpdateWorldVertices.
+         *
+         * @return The lanes of the polygon in the order of the shape's local vertices, with a count of zero if
+         * the shape is not a polygon.
+         */
+        PolygonLanes GetPolygonLanes() const;
+
+        /**
+         * @brief Moves the world vertices to the current position and rotation. Integrating the velocities
+         * does it already, call it after setting the position or rotation directly.
+         */
+        void UpdateWorldVertices();
+
+        /**
+         * @brief Gets the position between the previous and the current update of the world's Step.
+         *
+         * @param alpha Interpolation factor, 0 gives the previous position and 1 the current one.
+         * @return The interpolated position, for rendering.
+         */
+        AeroVec2 GetInterpolatedPosition(real alpha) const;
+
+        /**
+         * @brief Gets the rotation between the previous and the current update of the world's Step.
+         *
+         * @param alpha Interpolation factor, 0 gives the previous rotation and 1 the current one.
+         * @return The interpolated rotation, for rendering.
+         */
+        real GetInterpolatedRotation(real alpha) const;
+
+        /**
+         * @brief Integrates the body's forces to update its linear and angular accelerations. Sleeping bodies are skipped.
+         * The forces are kept so that every sub-step of an update integrates them, call ClearForces and
+         * ClearTorque once the update is done.
          *
          * @param dt Time step for the integration.
+         * @param stepFraction Fraction of the update covered by dt, the per-update damping is scaled by it.
          */
-        void IntegrateForces(real dt);
+        void IntegrateForces(real dt, real stepFraction = 1.0);
 
         /**
-         * @brief Integrates the body's velocities to update its position and rotation.
+         * @brief Integrates the body's velocities to update its position and rotation. Sleeping bodies are skipped.
          *
          * @param dt Time step for the integration.
          */
@@ -79,31 +204,31 @@ namespace Aerolite {
          *
          * @return true if the body is static, false otherwise.
          */
-        bool IsStatic() const;
+        bool IsStatic() const { return (states->flags[state_index] & AeroBodyStates2D::STATIC) != 0; }
 
         /**
-         * @brief Adds a force to the body's force accumulator.
+         * @brief Adds a force to the body's force accumulator. Wakes the body if it is sleeping.
          *
          * @param force The force vector to add.
          */
         void AddForce(const AeroVec2& force);
 
         /**
-         * @brief Adds a torque to the body's torque accumulator.
+         * @brief Adds a torque to the body's torque accumulator. Wakes the body if it is sleeping.
          *
          * @param torque The torque value to add.
          */
         void AddTorque(const real torque);
 
         /**
-         * @brief Applies a linear impulse to the body, affecting its linear velocity.
+         * @brief Applies a linear impulse to the body, affecting its linear velocity. Wakes the body if it is sleeping.
          *
          * @param j The impulse vector to apply.
          */
         void ApplyImpulseLinear(const AeroVec2& j);
 
         /**
-         * @brief Applies an angular impulse to the body, affecting its angular velocity.
+         * @brief Applies an angular impulse to the body, affecting its angular velocity. Wakes the body if it is sleeping.
          *
          * @param j The angular impulse value to apply.
          */
@@ -111,6 +236,7 @@ namespace Aerolite {
 
         /**
          * @brief Applies an impulse at a specific point on the body, affecting both linear and angular velocities.
+         * Wakes the body if it is sleeping.
          *
          * @param j The impulse vector to apply.
          * @param r The point (relative to the body's center of mass) where the impulse is applied.
@@ -135,7 +261,7 @@ namespace Aerolite {
         void Sleep();
 
         /**
-         * @brief Awakens the body.
+         * @brief Awakens the body. The world wakes the rest of the body's sleeping island on its next update.
          */
         void Awake();
 
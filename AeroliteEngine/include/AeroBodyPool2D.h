@@ -0,0 +1,120 @@
+#ifndef AEROLITE_BODY_POOL_2D_H
+#define AEROLITE_BODY_POOL_2D_H
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+#include "AeroBody2D.h"
+#include "Config.h"
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @class AeroBodyPool2D
+     * @brief Owns the bodies of a world and hands out generational handles to them.
+     *
+     * Bodies live in fixed-size blocks of slots that never move, so pointers to a body stay valid for as long
+     * as it is alive and creating bodies never copies the existing ones. A densely packed list of the live
+     * bodies is kept next to the slots for iteration. Removing a body moves the last body of that list into
+     * its place, so removal is constant time and the order of the remaining bodies changes. Freed slots are
+     * reused by later bodies with a new generation, which makes handles to the removed body stale.
+     *
+     * The fields every step works on (position, rotation, velocities, inverse mass and inertia, flags) are not
+     * stored in the body objects but in per-field arrays in the order of the packed list, see GetStates. The
+     * body objects read and write them through their row, which follows the body when it is moved.
+     *
+     * The slot index doubles as the id of the body, so ids are per world, dense and never run out; an id is
+     * only unique among the live bodies, the generation tells apart bodies that used the same slot.
+     */
+    class AeroBodyPool2D {
+    public:
+        AeroBodyPool2D() = default;
+
+        AeroBodyPool2D(const AeroBodyPool2D&) = delete;
+        AeroBodyPool2D(AeroBodyPool2D&&) noexcept = delete;
+        AeroBodyPool2D& operator=(const AeroBodyPool2D&) = delete;
+        AeroBodyPool2D& operator=(AeroBodyPool2D&&) = delete;
+
+        /** @brief Default destructor */
+        ~AeroBodyPool2D() = default;
+
+        /**
+         * @brief Destroys every body. Every handle handed out so far becomes stale.
+         */
+        void Clear();
+
+        /**
+         * @brief Creates a body in a free slot and appends it to the list of live bodies.
+         * @param shape The shape of the body.
+         * @param x Initial x-coordinate of the body's position.
+         * @param y Initial y-coordinate of the body's position.
+         * @param mass Mass of the body, zero for a static body.
+         * @return The new body. Its handle field refers to it.
+         */
+        AeroBody2D* Create(const std::shared_ptr<const Shape>& shape, real x, real y, real mass);
+
+        /**
+         * @brief Removes a body in constant time by moving the last live body and its states into its place.
+         * The body object is only destroyed when its slot is reused or the pool is cleared, but its position,
+         * velocities and the other states are gone at once.
+         * @param handle The handle of the body to remove.
+         * @return True if the handle referred to a live body, false if it was stale.
+         */
+        bool Destroy(AeroBodyHandle2D handle);
+
+        /**
+         * @brief Resolves a handle.
+         * @param handle The handle to resolve.
+         * @return The body, or nullptr if the handle is null or stale.
+         */
+        AeroBody2D* Get(AeroBodyHandle2D handle) const;
+
+        /**
+         * @brief Checks if a handle refers to a live body.
+         */
+        bool IsValid(AeroBodyHandle2D handle) const;
+
+        /**
+         * @brief Gets the live bodies. The span is invalidated when bodies are created or removed.
+         */
+        std::span<AeroBody2D* const> GetBodies() const;
+
+        /**
+         * @brief Gets the number of live bodies.
+         */
+        std::size_t GetSize() const;
+
+        /**
+         * @brief Gets the per-field arrays of the live bodies, row i belongs to GetBodies()[i]. The arrays
+         * are reallocated when bodies are created.
+         */
+        AeroBodyStates2D& GetStates();
+        const AeroBodyStates2D& GetStates() const;
+
+    private:
+        static constexpr aero_uint32 BLOCK_SIZE = 64; ///< Slots allocated at once.
+        static constexpr aero_uint32 NOT_LIVE = 0xFFFFFFFF; ///< Dense index of a free slot.
+
+        struct Slot {
+            std::optional<AeroBody2D> body;
+            aero_uint32 generation = 0;
+            aero_uint32 dense = NOT_LIVE; ///< Index of the body in m_dense, NOT_LIVE while the slot is free.
+        };
+
+        Slot& GetSlot(aero_uint32 index) const;
+        void AppendState();
+        void MoveState(aero_uint32 from, aero_uint32 to);
+        void PopState();
+
+        std::vector<std::unique_ptr<Slot[]>> m_blocks; ///< Slot storage, blocks never move once allocated.
+        aero_uint32 m_slotCount = 0; ///< Slots in use or freed, the rest of the last block was never used.
+        std::vector<aero_uint32> m_freeSlots; ///< Slots of removed bodies, reused last in first out.
+        std::vector<AeroBody2D*> m_dense; ///< Live bodies, packed.
+        std::vector<aero_uint32> m_denseSlots; ///< Slot of every body in m_dense.
+        AeroBodyStates2D m_states; ///< Per-field states of every body in m_dense.
+    };
+}
+
+#endif // AEROLITE_BODY_POOL_2D_H
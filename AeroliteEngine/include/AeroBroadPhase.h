@@ -11,11 +11,11 @@ namespace Aerolite {
      * @brief Represents a pair of bodies that might be colliding.
      */
     struct BroadPhasePair {
-        std::shared_ptr<AeroBody2D> a;
-        std::shared_ptr<AeroBody2D> b;
-        uint32_t id_pair;
+        AeroBody2D* a;
+        AeroBody2D* b;
+        aero_uint64 id_pair; ///< Ids of both bodies packed by ComputeIdPair, a has the smaller id.
 
-        BroadPhasePair(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, const uint32_t idPair)
+        BroadPhasePair(AeroBody2D* a, AeroBody2D* b, const aero_uint64 idPair)
             : a(a), b(b), id_pair(idPair) {}
     };
 
@@ -26,7 +26,8 @@ namespace Aerolite {
     enum class BroadPhaseAlg {
         BruteForce, ///< Naive brute-force approach.
         SHG,        ///< Spatial hash grid.
-        BVH         ///< Bounding Volume Hierarchy tree.
+        BVH,        ///< Bounding Volume Hierarchy tree.
+        SAP         ///< Sweep and prune.
     };
 
     class AeroBroadPhase {
@@ -54,6 +55,7 @@ namespace Aerolite {
         static void BruteForce(AeroWorld2D& world);
         static void Shg(AeroWorld2D& world);
         static void Bvh(AeroWorld2D& world);
+        static void Sap(AeroWorld2D& world);
     };
 
 }
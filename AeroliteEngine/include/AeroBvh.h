@@ -0,0 +1,224 @@
+#ifndef AEROLITE_BVH_H
+#define AEROLITE_BVH_H
+
+#include <vector>
+#include "AeroAABB2D.h"
+#include "Config.h"
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @class AeroBvh
+     * @brief Incremental dynamic AABB tree used by the BVH broad-phase.
+     *
+     * Every body owns a proxy (a leaf of the tree) that persists across frames. The leaf stores a "fat"
+     * AABB: the body's AABB enlarged by a fixed margin and extended along the body's predicted motion.
+     * A proxy is only re-inserted into the tree once its body leaves its fat AABB, and the tree is kept
+     * balanced with AVL style rotations. Candidate pairs are kept in a persistent list that is only
+     * updated for proxies that were inserted or re-inserted this frame, so the per frame cost scales with
+     * the number of bodies that left their fat AABB instead of the total body count.
+     */
+    class AeroBvh {
+    public:
+        static constexpr aero_int32 NullNode = -1; ///< Sentinel used for empty node links and missing proxies.
+
+        /**
+         * @brief Default constructor. Creates an empty tree with a default fat margin and prediction time.
+         */
+        AeroBvh();
+
+        AeroBvh(const AeroBvh&) = delete;
+        AeroBvh(AeroBvh&&) noexcept = delete;
+        AeroBvh& operator=(const AeroBvh&) = delete;
+        AeroBvh& operator=(AeroBvh&&) = delete;
+
+        /** @brief Default destructor */
+        ~AeroBvh() = default;
+
+        /**
+         * @brief Removes every proxy and pair from the tree.
+         */
+        void Clear();
+
+        real GetFatMargin() const;
+        real GetPredictionTime() const;
+
+        /**
+         * @brief Sets the fixed amount every proxy AABB is enlarged by in all directions.
+         * @param margin The margin in world units.
+         */
+        void SetFatMargin(real margin);
+
+        /**
+         * @brief Sets how far ahead (in seconds) fat AABBs are extended along a body's linear velocity.
+         * @param seconds The look-ahead time used for the velocity prediction.
+         */
+        void SetPredictionTime(real seconds);
+
+        /**
+         * @brief Creates a new proxy in the tree.
+         * @param aabb The tight AABB of the object.
+         * @param userData User supplied value associated with the proxy (the body index for the world).
+         * @return The id of the new proxy.
+         */
+        aero_int32 CreateProxy(const AeroAABB2D& aabb, aero_int32 userData);
+
+        /**
+         * @brief Removes a proxy from the tree together with every pair that references it.
+         * @param proxyId The id of the proxy to destroy.
+         */
+        void DestroyProxy(aero_int32 proxyId);
+
+        /**
+         * @brief Updates the AABB of a proxy. The proxy is only re-inserted if the new AABB
+         * is no longer contained by the fat AABB stored in the tree.
+         * @param proxyId The id of the proxy to move.
+         * @param aabb The new tight AABB of the object.
+         * @param velocity The linear velocity of the object, used to extend the fat AABB along its predicted motion.
+         * @return True if the proxy was re-inserted, false if it is still inside its fat AABB.
+         */
+        bool MoveProxy(aero_int32 proxyId, const AeroAABB2D& aabb, const AeroVec2& velocity);
+
+        /**
+         * @brief Checks if a proxy id refers to a live leaf of this tree.
+         * @param proxyId The id to check.
+         * @return True if the proxy exists, false otherwise.
+         */
+        bool IsProxyValid(aero_int32 proxyId) const;
+
+        const AeroAABB2D& GetFatAABB(aero_int32 proxyId) const;
+        const AeroAABB2D& GetTightAABB(aero_int32 proxyId) const;
+        aero_int32 GetUserData(aero_int32 proxyId) const;
+
+        /**
+         * @brief Updates the user data of a proxy.
+         * @param proxyId The id of the proxy.
+         * @param userData The new user data.
+         */
+        void SetUserData(aero_int32 proxyId, aero_int32 userData);
+
+        /**
+         * @brief Updates the pairs of every proxy that was created or re-inserted since the last update:
+         * pairs whose fat AABBs stopped overlapping are removed and the new overlaps are added.
+         */
+        void EndUpdate();
+
+        /**
+         * @brief Visits every persistent pair, i.e. every pair of proxies whose fat AABBs overlap.
+         * @param callback Callable invoked as callback(proxyIdA, proxyIdB).
+         */
+        template<typename Callback>
+        void ForEachPair(Callback&& callback) const;
+
+        /**
+         * @brief Visits every proxy whose fat AABB overlaps the given AABB.
+         * @param aabb The query AABB.
+         * @param callback Callable invoked as callback(proxyId). Return false to stop the query.
+         */
+        template<typename Callback>
+        void Query(const AeroAABB2D& aabb, Callback&& callback) const;
+
+        /**
+         * @brief Gets the height of the tree. An empty tree has a height of zero.
+         */
+        aero_int32 GetHeight() const;
+
+        /**
+         * @brief Gets the number of live proxies in the tree.
+         */
+        aero_int32 GetProxyCount() const;
+
+        /**
+         * @brief Gets the number of pairs currently held in the persistent pair list.
+         */
+        std::size_t GetPairCount() const;
+
+    private:
+        struct Node {
+            AeroAABB2D aabb; ///< Fat AABB for leaves, enclosing AABB for internal nodes.
+            AeroAABB2D tight; ///< Tight AABB of the object (leaves only).
+            aero_int32 parent = NullNode; ///< Parent node, or the next free node when on the free list.
+            aero_int32 child1 = NullNode;
+            aero_int32 child2 = NullNode;
+            aero_int32 height = -1; ///< Leaf = 0, free node = -1.
+            aero_int32 userData = -1;
+            bool moved = false; ///< Whether the proxy is queued in the move buffer.
+
+            [[nodiscard]] bool IsLeaf() const { return child1 == NullNode; }
+        };
+
+        struct Pair {
+            aero_int32 proxyA;
+            aero_int32 proxyB;
+        };
+
+        /**
+         * @brief Entry of a proxy's pair links: the other proxy of a pair and the index of the pair in m_pairs.
+         */
+        struct PairLink {
+            aero_int32 partner;
+            aero_int32 pair;
+        };
+
+        aero_int32 AllocateNode();
+        void FreeNode(aero_int32 nodeId);
+        void InsertLeaf(aero_int32 leaf);
+        void RemoveLeaf(aero_int32 leaf);
+        aero_int32 Balance(aero_int32 iA);
+        void FatAABB(const AeroAABB2D& aabb, const AeroVec2& velocity, AeroAABB2D& fatAabb) const;
+        void AddPair(aero_int32 proxyA, aero_int32 proxyB);
+        void RemovePair(aero_int32 pairIndex);
+        void UnlinkPair(aero_int32 proxyId, aero_int32 partner);
+
+        std::vector<Node> m_nodes;
+        std::vector<std::vector<PairLink>> m_links; ///< Pairs of every proxy, indexed like m_nodes.
+        aero_int32 m_root; ///< Root node of the tree.
+        aero_int32 m_freeList; ///< Head of the free node list.
+        aero_int32 m_proxyCount;
+        real m_fatMargin; ///< Fixed enlargement applied to every proxy AABB.
+        real m_predictionTime; ///< Seconds of velocity look-ahead added to fat AABBs.
+
+        std::vector<aero_int32> m_moveBuffer; ///< Proxies that were created or re-inserted this update.
+        std::vector<Pair> m_pairs; ///< Persistent list of proxy pairs whose fat AABBs overlap.
+        mutable std::vector<aero_int32> m_stack; ///< Scratch stack reused by tree queries.
+    };
+
+    template<typename Callback>
+    void AeroBvh::ForEachPair(Callback&& callback) const
+    {
+        for (const Pair& pair : m_pairs)
+        {
+            callback(pair.proxyA, pair.proxyB);
+        }
+    }
+
+    template<typename Callback>
+    void AeroBvh::Query(const AeroAABB2D& aabb, Callback&& callback) const
+    {
+        if (m_root == NullNode) return;
+
+        m_stack.clear();
+        m_stack.push_back(m_root);
+        while (!m_stack.empty())
+        {
+            const aero_int32 nodeId = m_stack.back();
+            m_stack.pop_back();
+
+            const Node& node = m_nodes[nodeId];
+            if (!node.aabb.Intersects(aabb)) continue;
+
+            if (node.IsLeaf())
+            {
+                if (!callback(nodeId)) return;
+            }
+            else
+            {
+                m_stack.push_back(node.child1);
+                m_stack.push_back(node.child2);
+            }
+        }
+    }
+}
+
+#endif // AEROLITE_BVH_H
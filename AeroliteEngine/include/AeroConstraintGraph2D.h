@@ -0,0 +1,101 @@
+#ifndef AERO_CONSTRAINT_GRAPH_2D_H
+#define AERO_CONSTRAINT_GRAPH_2D_H
+
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+#include "AeroIsland2D.h"
+#include "Constraint2D.h"
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @class AeroConstraintGraph2D
+     * @brief Splits the constraints of large islands into colors that can be solved in parallel.
+     *
+     * Islands are solved independently of each other, but a single large pile is one island and would be
+     * solved by one thread. The constraints of islands with at least a threshold of constraints are
+     * therefore colored greedily: a constraint gets the first color in which neither of its dynamic bodies
+     * is used yet. No two constraints of a color touch the same dynamic body, so a color can be split
+     * across threads in any way and gives the same result. Static (and sleeping) bodies are only read by
+     * the solver and do not count as conflicts, otherwise every contact with the ground would need its own
+     * color. Constraints that find no free color go to an overflow set that is solved on one thread.
+     *
+     * Constraints are colored in island order and then in the order of the island's constraint lists, so
+     * the colors only depend on the input.
+     *
+     * The penetration constraints of a color are solved four at a time with SIMD instructions, see
+     * AeroContactBatches2D, the joints by the same scalar code as the islands. The order in which the
+     * constraints are solved changes, so coloring is off unless AeroWorldSettings2D::coloring_threshold is
+     * set. A single worker never colors: packing the batches costs more than the SIMD solve saves over the
+     * scalar solve of a whole island.
+     */
+    class AeroConstraintGraph2D {
+    public:
+        static constexpr aero_int32 MAX_COLORS = 16; ///< Colors before constraints go to the overflow set.
+
+        AeroConstraintGraph2D() = default;
+        ~AeroConstraintGraph2D() = default;
+
+        /**
+         * @brief Colors the constraints of the large islands built by the island manager this step.
+         * @param islands The island manager, after BuildIslands.
+         * @param contacts The penetration constraints passed to BuildIslands. Second points of a block are
+         * left out, the first point of the block solves them.
+         * @param joints The joints passed to BuildIslands.
+         * @param threshold Islands with at least this many constraints are colored, the others are not.
+         * Zero or less colors no island.
+         */
+        void Build(const AeroIslandManager2D& islands,
+                   const std::pmr::vector<PenetrationConstraint>& contacts,
+                   const std::vector<std::unique_ptr<Constraint2D>>& joints,
+                   aero_int32 threshold);
+
+        /**
+         * @brief Gets the islands that were not colored and are solved as a whole, as island indices.
+         */
+        std::span<const aero_int32> GetIslands() const;
+
+        /**
+         * @brief Gets the number of colors in use, the overflow set not counted.
+         */
+        aero_int32 GetColorCount() const;
+
+        /** @brief Gets the indices of the penetration constraints of a color. */
+        std::span<const aero_int32> GetContacts(aero_int32 color) const;
+
+        /** @brief Gets the indices of the joints of a color. */
+        std::span<const aero_int32> GetJoints(aero_int32 color) const;
+
+        /** @brief Gets the indices of the penetration constraints that did not fit in any color. */
+        std::span<const aero_int32> GetOverflowContacts() const;
+
+        /** @brief Gets the indices of the joints that did not fit in any color. */
+        std::span<const aero_int32> GetOverflowJoints() const;
+
+    private:
+        struct Color {
+            std::vector<aero_uint64> bodies; ///< Bit set of the awake bodies used by the color, by island_index.
+            std::vector<aero_int32> contacts;
+            std::vector<aero_int32> joints;
+        };
+
+        /**
+         * @brief Finds the first color where neither body is used and marks them used.
+         * @return The color, or MAX_COLORS if the constraint goes to the overflow set.
+         */
+        aero_int32 AssignColor(const AeroBody2D& a, const AeroBody2D& b);
+
+        std::array<Color, MAX_COLORS> m_colors;
+        aero_int32 m_colorCount = 0;
+        std::size_t m_words = 0; ///< Words in the body set of a color this step.
+        std::vector<aero_int32> m_islands; ///< Islands that are solved as a whole.
+        std::vector<aero_int32> m_overflowContacts;
+        std::vector<aero_int32> m_overflowJoints;
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef AERO_CONTACT_BATCHES_2D_H
+#define AERO_CONTACT_BATCHES_2D_H
+
+#include <memory_resource>
+#include <span>
+#include <vector>
+#include "AeroBody2D.h"
+#include "AeroConstraintGraph2D.h"
+#include "Constraint2D.h"
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @class AeroContactBatches2D
+     * @brief Solves the penetration constraints of the colors of an AeroConstraintGraph2D four at a time
+     * with SIMD instructions.
+     *
+     * The constraints of a color are packed after PreSolve into batches of LANES constraints, with one array
+     * per field so that a register load reads the same field of consecutive constraints. A color shares no
+     * dynamic body, so the lanes of a batch can be solved at once: the velocities of the bodies are gathered
+     * from AeroBodyStates2D into registers, solved, and scattered back. Static bodies may be used by several
+     * lanes, they are only read. AVX solves a batch in one pass, SSE2 in two, other builds lane by lane.
+     *
+     * A lane holds a whole manifold, its second point is the block partner of the constraint if it has one.
+     * Friction is solved first and the normal rows after it, as a 2x2 block where the constraint uses one and
+     * sequentially otherwise. The accumulated impulses live in the batches while the color is solved and are
+     * written back to the constraints with Unpack.
+     */
+    class AeroContactBatches2D {
+    public:
+        static constexpr aero_int32 LANES = 4; ///< Constraints per batch, the width of an AVX register of doubles.
+
+        AeroContactBatches2D() = default;
+        ~AeroContactBatches2D() = default;
+
+        /**
+         * @brief Makes room for the colors of the graph. Contact i of a color goes to lane i % LANES of batch
+         * GetFirstBatch(color) + i / LANES.
+         * @param graph The graph, after Build.
+         */
+        void Build(const AeroConstraintGraph2D& graph);
+
+        /** @brief Gets the batch of the first constraints of a color. */
+        aero_int32 GetFirstBatch(aero_int32 color) const;
+
+        /**
+         * @brief Packs presolved constraints of a color into their batches.
+         * @param firstBatch The batch of the first constraint, which goes to its lane zero.
+         * @param contacts The indices of the constraints, in the order of the color.
+         * @param penetrations The penetration constraints the indices refer to.
+         */
+        void Pack(aero_int32 firstBatch, std::span<const aero_int32> contacts,
+                  std::pmr::vector<PenetrationConstraint>& penetrations);
+
+        /**
+         * @brief Runs one iteration over packed batches.
+         * @param states The states of the bodies of the constraints.
+         * @param firstBatch The first batch to solve.
+         * @param contacts The constraints packed from firstBatch on, only their count is used.
+         * @param useBias False to solve without the position correction, see PenetrationConstraint::Relax.
+         */
+        void Solve(AeroBodyStates2D& states, aero_int32 firstBatch, std::span<const aero_int32> contacts, bool useBias);
+
+        /**
+         * @brief Writes the accumulated impulses of packed batches back to their constraints.
+         * @param firstBatch The first batch to unpack.
+         * @param contacts The constraints packed from firstBatch on, only their count is used.
+         */
+        void Unpack(aero_int32 firstBatch, std::span<const aero_int32> contacts) const;
+
+        /**
+         * @brief Lanes of up to LANES manifolds. Fields of the two points are indexed by point, then lane.
+         * Lanes without a constraint and second points of single-point manifolds are zero, so they apply no
+         * impulse.
+         */
+        struct Batch {
+            alignas(32) real normal_x[2][LANES]; ///< World space normal of the points.
+            real normal_y[2][LANES];
+            real ra_x[2][LANES]; ///< Vector from the center of mass of "a" to the points.
+            real ra_y[2][LANES];
+            real rb_x[2][LANES]; ///< Vector from the center of mass of "b" to the points.
+            real rb_y[2][LANES];
+            real normal_mass[2][LANES];
+            real tangent_mass[2][LANES];
+            real bias[2][LANES];
+            real restitution_bias[2][LANES];
+            real normal_impulse[2][LANES]; ///< Accumulated impulses, written back by Unpack.
+            real tangent_impulse[2][LANES];
+            real friction[LANES];
+            real inv_mass_a[LANES]; ///< Zero for static bodies, like in the constraint.
+            real inv_inertia_a[LANES];
+            real inv_mass_b[LANES];
+            real inv_inertia_b[LANES];
+            real k11[LANES]; ///< Effective mass matrix of the two normal rows.
+            real k12[LANES];
+            real k22[LANES];
+            real block_mass11[LANES]; ///< Inverse of the effective mass matrix.
+            real block_mass12[LANES];
+            real block_mass22[LANES];
+            real use_block[LANES]; ///< One where the normal rows are solved as a block, zero otherwise.
+            aero_uint32 row_a[LANES]; ///< Rows of the bodies in AeroBodyStates2D.
+            aero_uint32 row_b[LANES];
+            PenetrationConstraint* constraints[LANES]; ///< First point of the manifold of every lane, null for empty lanes.
+            aero_uint32 write_a = 0; ///< Bit i is set if lane i writes the velocities of "a", which static bodies never are.
+            aero_uint32 write_b = 0;
+        };
+
+    private:
+        /** @brief Copies a constraint and its block partner into a lane, or clears the lane for a null constraint. */
+        static void PackLane(Batch& batch, std::size_t lane, PenetrationConstraint* constraint);
+
+        /** @brief Copies the per-step data of one point into a lane, or zeroes the point for a null constraint. */
+        static void PackPoint(Batch& batch, std::size_t point, std::size_t lane, const PenetrationConstraint* constraint);
+
+        std::vector<aero_int32> m_firstBatches; ///< First batch of every color of the graph.
+        std::vector<Batch> m_batches; ///< Only grows, so steps after the largest one do not allocate.
+    };
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef AERO_FRAME_ARENA_H
+#define AERO_FRAME_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+#include "Config.h"
+
+namespace Aerolite {
+
+    /**
+     * @class AeroFrameArena
+     * @brief Linear allocator for the data that only lives for one step of the world, usable by any
+     * std::pmr container.
+     *
+     * An allocation moves an offset forward in a single buffer and deallocation does nothing; Reset
+     * releases everything at once. Allocations that do not fit in the buffer are taken from the heap
+     * and released by Reset too, which then grows the buffer to the high-water mark, so once a scene
+     * stops growing a step no longer touches the heap. The offset is moved atomically, jobs of the
+     * job pool may allocate from the arena at the same time.
+     */
+    class AeroFrameArena final : public std::pmr::memory_resource {
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024; ///< Bytes reserved by a new arena.
+
+        /**
+         * @brief Creates an arena with a buffer of the given size.
+         * @param capacity Size of the buffer in bytes.
+         */
+        explicit AeroFrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+
+        AeroFrameArena(const AeroFrameArena&) = delete;
+        AeroFrameArena& operator=(const AeroFrameArena&) = delete;
+        ~AeroFrameArena() override;
+
+        /**
+         * @brief Releases every allocation made since the last reset. Nothing allocated from the arena may be
+         * used afterwards, and no thread may allocate from it during the call.
+         */
+        void Reset();
+
+        /** @brief Gets the size of the buffer in bytes. */
+        std::size_t GetCapacity() const;
+
+        /** @brief Gets the bytes allocated since the last reset, alignment padding included. */
+        std::size_t GetUsed() const;
+
+        /** @brief Gets the largest number of bytes allocated between two resets since the arena was created. */
+        std::size_t GetHighWaterMark() const;
+
+    private:
+        struct Overflow {
+            void* memory;
+            std::size_t bytes;
+            std::size_t alignment;
+        };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        void ReleaseOverflow();
+
+        std::unique_ptr<std::byte[]> m_buffer;
+        std::size_t m_capacity = 0;
+        std::atomic<std::size_t> m_offset = 0; ///< Bytes requested since the last reset, may pass the capacity.
+        std::size_t m_highWaterMark = 0;
+
+        std::mutex m_overflowMutex;
+        std::vector<Overflow> m_overflow; ///< Heap blocks of the allocations that did not fit in the buffer.
+    };
+}
+
+#endif
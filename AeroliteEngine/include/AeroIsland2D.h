@@ -0,0 +1,183 @@
+#ifndef AERO_ISLAND_2D_H
+#define AERO_ISLAND_2D_H
+
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+#include "AeroBody2D.h"
+#include "Constraint2D.h"
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @struct AeroIsland2D
+     * @brief A set of awake bodies connected by contacts or joints, together with the constraints acting on them.
+     * Islands share no dynamic body, so every island can be solved independently of the others.
+     */
+    struct AeroIsland2D {
+        aero_int32 first_body = 0; ///< Offset of the island's bodies in the manager's body list.
+        aero_int32 body_count = 0;
+        aero_int32 first_contact = 0; ///< Offset of the island's penetration constraint indices.
+        aero_int32 contact_count = 0;
+        aero_int32 first_joint = 0; ///< Offset of the island's joint constraint indices.
+        aero_int32 joint_count = 0;
+    };
+
+    /**
+     * @class AeroIslandManager2D
+     * @brief Groups awake bodies into islands and puts whole islands to sleep once they come to rest.
+     *
+     * An island is a set of dynamic bodies connected by touching contacts or joints. Static bodies never
+     * join an island, so two piles resting on the same floor are independent. Every step the islands of the
+     * awake bodies are rebuilt with a union-find pass before solving, so the solver can work on them
+     * independently; after integration an island falls asleep when all of its bodies stayed below the
+     * velocity thresholds for longer than the time threshold. Sleeping islands are remembered so
+     * that a single disturbance (a new contact, a joint to an awake body or an applied force) wakes the
+     * whole island at once.
+     */
+    class AeroIslandManager2D {
+    public:
+        AeroIslandManager2D() = default;
+        ~AeroIslandManager2D() = default;
+
+        /**
+         * @brief Forgets every sleeping island without waking its bodies.
+         */
+        void Clear();
+
+        bool IsSleepingEnabled() const;
+        real GetLinearSleepTolerance() const;
+        real GetAngularSleepTolerance() const;
+        real GetTimeToSleep() const;
+
+        /**
+         * @brief Enables or disables sleeping. Disabling it wakes every sleeping island.
+         * @param enabled True to let islands fall asleep.
+         */
+        void SetSleepingEnabled(bool enabled);
+
+        /**
+         * @brief Sets the linear speed (pixels per second) below which a body counts as resting.
+         */
+        void SetLinearSleepTolerance(real tolerance);
+
+        /**
+         * @brief Sets the angular speed (radians per second) below which a body counts as resting.
+         */
+        void SetAngularSleepTolerance(real tolerance);
+
+        /**
+         * @brief Sets how long (in seconds) every body of an island must rest before the island falls asleep.
+         */
+        void SetTimeToSleep(real seconds);
+
+        /**
+         * @brief Wakes the sleeping island the body belongs to.
+         * @param body The body whose island is woken. Awake bodies are ignored.
+         * @return True if an island was woken, false otherwise.
+         */
+        bool WakeIsland(AeroBody2D& body);
+
+        /**
+         * @brief Wakes every sleeping island.
+         */
+        void WakeAll();
+
+        /**
+         * @brief Must be called before a body is removed from the world. Wakes whatever may have rested on it
+         * and drops every reference the manager holds to the body.
+         * @param body The body that is about to be removed.
+         */
+        void RemoveBody(AeroBody2D& body);
+
+        /**
+         * @brief Wakes every sleeping island that has a body that was woken from outside the manager,
+         * for instance by an applied force or a call to AeroBody2D::Awake.
+         * @return True if an island was woken, false otherwise.
+         */
+        bool WakeDisturbedIslands();
+
+        /**
+         * @brief Builds the islands of the awake bodies. Contacts of the previous step are kept as island
+         * edges for one more step, so that a contact flickering for a single frame does not split a resting
+         * pile into islands that sleep separately.
+         * @param bodies Every body of the world.
+         * @param contacts The penetration constraints solved this step.
+         * @param joints The joint constraints of the world.
+         */
+        void BuildIslands(std::span<AeroBody2D* const> bodies,
+                          const std::pmr::vector<PenetrationConstraint>& contacts,
+                          const std::vector<std::unique_ptr<Constraint2D>>& joints);
+
+        /**
+         * @brief Updates the sleep timers of the bodies of the islands built this step and puts the islands
+         * that came to rest to sleep. Must be called after the velocities were integrated.
+         * @param dt The time step of the frame.
+         */
+        void UpdateSleep(real dt);
+
+        /**
+         * @brief Gets the number of awake dynamic bodies in the islands built in the last step.
+         */
+        std::size_t GetAwakeBodyCount() const;
+
+        /**
+         * @brief Gets the number of islands of awake bodies built in the last step.
+         */
+        std::size_t GetIslandCount() const;
+
+        /**
+         * @brief Gets an island built in the last step. Islands are ordered from the most to the least
+         * constraints, ties keep the order in which the islands were found.
+         * @param index The index of the island, smaller than GetIslandCount().
+         */
+        const AeroIsland2D& GetIsland(std::size_t index) const;
+
+        std::span<AeroBody2D* const> GetBodies(const AeroIsland2D& island) const;
+
+        /** @brief Gets the indices of the island's penetration constraints in the list passed to BuildIslands. */
+        std::span<const aero_int32> GetContacts(const AeroIsland2D& island) const;
+
+        /** @brief Gets the indices of the island's joints in the list passed to BuildIslands. */
+        std::span<const aero_int32> GetJoints(const AeroIsland2D& island) const;
+
+        /**
+         * @brief Gets the number of islands that are currently asleep.
+         */
+        std::size_t GetSleepingIslandCount() const;
+
+    private:
+        aero_int32 Find(aero_int32 node);
+        void Union(const AeroBody2D& a, const AeroBody2D& b);
+        void WakeIslandAt(aero_int32 islandIndex);
+
+        bool m_sleepingEnabled = true;
+        real m_linearSleepTolerance = 2.5; ///< 5 cm/s at 50 pixels per meter.
+        real m_angularSleepTolerance = 0.035; ///< About 2 degrees per second.
+        real m_timeToSleep = 0.5;
+
+        std::vector<std::vector<AeroBody2D*>> m_sleepingIslands; ///< Bodies of each sleeping island, empty slots are reused.
+        std::vector<aero_int32> m_freeIslands; ///< Indices of empty slots in m_sleepingIslands.
+        std::size_t m_sleepingIslandCount = 0;
+
+        std::vector<AeroBody2D*> m_awakeBodies; ///< Union-find nodes of the current step, indexed by AeroBody2D::island_index.
+        std::vector<aero_int32> m_parent; ///< Union-find parent links.
+        std::vector<aero_int32> m_islandOfRoot; ///< Island assigned to each union-find root.
+        std::vector<aero_int32> m_bodyIsland; ///< Island of each union-find node.
+        std::vector<aero_int32> m_contactIsland; ///< Island of each penetration constraint, -1 if it has none.
+        std::vector<aero_int32> m_jointIsland; ///< Island of each joint, -1 if it has none.
+
+        std::vector<AeroIsland2D> m_islands; ///< Islands of the current step, in discovery order.
+        std::vector<aero_int32> m_solveOrder; ///< Island indices sorted by size.
+        std::vector<AeroBody2D*> m_islandBodies;
+        std::vector<aero_int32> m_islandContacts;
+        std::vector<aero_int32> m_islandJoints;
+        std::vector<std::pair<AeroBody2D*, AeroBody2D*>> m_edges; ///< Contact edges of the current step.
+        std::vector<std::pair<AeroBody2D*, AeroBody2D*>> m_previousEdges; ///< Contact edges of the previous step.
+    };
+}
+
+#endif
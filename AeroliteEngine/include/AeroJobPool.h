@@ -0,0 +1,93 @@
+#ifndef AERO_JOB_POOL_H
+#define AERO_JOB_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Config.h"
+
+namespace Aerolite {
+
+    /**
+     * @class AeroJobPool
+     * @brief Small work-stealing thread pool used by the world to run independent jobs in parallel.
+     *
+     * Every worker, including the thread that calls ParallelFor, owns a queue of job indices. A batch
+     * is dealt out round-robin over the queues; workers take jobs from the front of their own queue
+     * and, once it is empty, steal from the back of the other queues. With a worker count of one no
+     * thread is started and ParallelFor simply runs the jobs in order on the calling thread.
+     */
+    class AeroJobPool {
+    public:
+        /**
+         * @brief Creates a pool with the given number of workers.
+         * @param workerCount Number of threads that run jobs, counting the calling thread.
+         */
+        explicit AeroJobPool(aero_int32 workerCount = 1);
+
+        AeroJobPool(const AeroJobPool&) = delete;
+        AeroJobPool(AeroJobPool&&) noexcept = delete;
+        AeroJobPool& operator=(const AeroJobPool&) = delete;
+        AeroJobPool& operator=(AeroJobPool&&) = delete;
+
+        /** @brief Stops and joins the worker threads. */
+        ~AeroJobPool();
+
+        aero_int32 GetWorkerCount() const;
+
+        /**
+         * @brief Changes the number of workers. Must not be called while a batch is running.
+         * @param workerCount Number of threads that run jobs, counting the calling thread. Values below one are clamped to one.
+         */
+        void SetWorkerCount(aero_int32 workerCount);
+
+        /**
+         * @brief Runs job(0) ... job(count - 1) on the workers and blocks until every job finished.
+         * Jobs with a smaller index are started first. The jobs must be independent of each other.
+         * @param count The number of jobs.
+         * @param job Callable invoked with the index of the job to run.
+         */
+        void ParallelFor(aero_int32 count, const std::function<void(aero_int32)>& job);
+
+        /**
+         * @brief Runs a callable the same way without copying it: the std::function only wraps a reference,
+         * so lambdas that capture more than fits in a std::function do not allocate.
+         */
+        template<typename Job>
+        void ParallelFor(const aero_int32 count, const Job& job) {
+            ParallelFor(count, std::function<void(aero_int32)>(std::cref(job)));
+        }
+
+    private:
+        /** @brief Jobs dealt to a worker. A vector with a moving front, so dealing a batch does not allocate. */
+        struct WorkQueue {
+            std::mutex mutex;
+            std::vector<aero_int32> jobs;
+            std::size_t front = 0; ///< Next job the owner takes, thieves take from the back.
+
+            [[nodiscard]] bool IsEmpty() const { return front == jobs.size(); }
+        };
+
+        void StartWorkers(aero_int32 workerCount);
+        void StopWorkers();
+        void WorkerLoop(aero_int32 worker);
+        bool RunJob(aero_int32 worker);
+
+        std::vector<std::thread> m_threads;
+        std::vector<std::unique_ptr<WorkQueue>> m_queues; ///< One queue per worker, queue 0 belongs to the calling thread.
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake; ///< Signals the workers that a new batch was queued or that they should stop.
+        std::condition_variable m_done; ///< Signals the calling thread that the last job of the batch finished.
+        const std::function<void(aero_int32)>* m_job = nullptr;
+        std::atomic<aero_int32> m_remaining = 0;
+        aero_uint64 m_batch = 0;
+        bool m_stop = false;
+    };
+}
+
+#endif
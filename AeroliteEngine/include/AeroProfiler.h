@@ -0,0 +1,165 @@
+#ifndef AERO_PROFILER_H
+#define AERO_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <vector>
+#include "Config.h"
+
+namespace Aerolite {
+
+    /**
+     * @brief The phases of AeroWorld2D::Update that are timed by the profiler, in execution order.
+     */
+    enum class ProfilePhase : aero_uint8 {
+        Forces,              ///< Gravity and global force accumulation.
+        IntegrateForces,     ///< Integration of forces into velocities.
+        BroadPhase,          ///< Broad-phase pair generation, including waking islands touched by awake bodies.
+        NarrowPhase,         ///< Contact generation and manifold matching.
+        Islands,             ///< Island building and sleep updates.
+        PreSolve,            ///< Constraint PreSolve, including warm starting.
+        Solve,               ///< Solver iterations, PostSolve and storing the impulses for warm starting.
+        IntegrateVelocities, ///< Integration of velocities into positions and vertex updates.
+        Particles,           ///< Particle integration.
+        Count
+    };
+
+    constexpr std::size_t PROFILE_PHASE_COUNT = static_cast<std::size_t>(ProfilePhase::Count);
+
+    /**
+     * @struct AeroStepProfile
+     * @brief Timings and counters of a single world step.
+     */
+    struct AeroStepProfile {
+        aero_uint64 step = 0; ///< Index of the step since the profiler was created or cleared.
+        double total_ms = 0; ///< Wall time of the whole step in milliseconds.
+        std::array<double, PROFILE_PHASE_COUNT> phase_ms{}; ///< Wall time of every phase in milliseconds.
+        aero_uint32 pair_count = 0; ///< Broad-phase pairs.
+        aero_uint32 contact_count = 0; ///< Contact points generated by the narrow-phase.
+        aero_uint32 constraint_count = 0; ///< Penetration constraints and joints solved.
+        aero_uint32 awake_body_count = 0; ///< Dynamic bodies that were not sleeping.
+        aero_uint32 island_count = 0; ///< Islands handed to the solver.
+
+        [[nodiscard]] double GetPhase(ProfilePhase phase) const { return phase_ms[static_cast<std::size_t>(phase)]; }
+    };
+
+    /**
+     * @class AeroProfiler
+     * @brief Records per-phase timings and counters of every world step into a fixed size ring buffer.
+     *
+     * The world only feeds the profiler when AERO_ENABLE_PROFILER is defined in Config.h. Without it the
+     * profiling macros expand to nothing and the history stays empty.
+     */
+    class AeroProfiler {
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+        /**
+         * @brief Creates a profiler that keeps the given number of steps.
+         * @param capacity The number of steps kept in the history, at least one.
+         */
+        explicit AeroProfiler(std::size_t capacity = DEFAULT_CAPACITY);
+
+        /**
+         * @brief Drops the recorded history and restarts the step numbering.
+         */
+        void Clear();
+
+        std::size_t GetCapacity() const;
+
+        /**
+         * @brief Changes the number of steps kept in the history. Clears the history.
+         */
+        void SetCapacity(std::size_t capacity);
+
+        /**
+         * @brief Starts recording a new step.
+         */
+        void BeginStep();
+
+        /**
+         * @brief Stops recording the current step and pushes it into the history, overwriting the oldest step when full.
+         */
+        void EndStep();
+
+        /**
+         * @brief Starts timing a phase of the current step.
+         */
+        void BeginPhase(ProfilePhase phase);
+
+        /**
+         * @brief Stops timing a phase and adds the elapsed time to the phase of the current step.
+         */
+        void EndPhase(ProfilePhase phase);
+
+        /**
+         * @brief Gets the step that is currently being recorded, to fill in its counters.
+         */
+        AeroStepProfile& GetCurrentStep();
+
+        /**
+         * @brief Gets the number of steps in the history.
+         */
+        std::size_t GetHistorySize() const;
+
+        /**
+         * @brief Gets a recorded step.
+         * @param index Index into the history, 0 is the oldest recorded step.
+         */
+        const AeroStepProfile& GetHistory(std::size_t index) const;
+
+        /**
+         * @brief Gets the most recently finished step, or an empty profile if nothing was recorded yet.
+         */
+        const AeroStepProfile& GetLastStep() const;
+
+        /**
+         * @brief Averages the timings and counters of every step in the history.
+         */
+        AeroStepProfile GetAverage() const;
+
+        /**
+         * @brief Writes the history as CSV, one header row followed by one row per step from oldest to newest.
+         */
+        void WriteCsv(std::ostream& out) const;
+
+        /**
+         * @brief Writes the history as a JSON array of step objects from oldest to newest.
+         */
+        void WriteJson(std::ostream& out) const;
+
+        /**
+         * @brief Gets the name of a phase as used in the CSV and JSON output.
+         */
+        static const char* GetPhaseName(ProfilePhase phase);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<AeroStepProfile> m_history;
+        std::size_t m_head = 0; ///< Slot the next finished step is written to.
+        std::size_t m_size = 0;
+        aero_uint64 m_stepCount = 0;
+
+        AeroStepProfile m_current;
+        Clock::time_point m_stepStart;
+        std::array<Clock::time_point, PROFILE_PHASE_COUNT> m_phaseStart{};
+    };
+}
+
+#ifdef AERO_ENABLE_PROFILER
+#define AERO_PROFILE_STEP_BEGIN(profiler) (profiler).BeginStep()
+#define AERO_PROFILE_STEP_END(profiler) (profiler).EndStep()
+#define AERO_PROFILE_BEGIN(profiler, phase) (profiler).BeginPhase(phase)
+#define AERO_PROFILE_END(profiler, phase) (profiler).EndPhase(phase)
+#define AERO_PROFILE_COUNTER(profiler, counter, value) ((profiler).GetCurrentStep().counter = static_cast<Aerolite::aero_uint32>(value))
+#else
+#define AERO_PROFILE_STEP_BEGIN(profiler) ((void)0)
+#define AERO_PROFILE_STEP_END(profiler) ((void)0)
+#define AERO_PROFILE_BEGIN(profiler, phase) ((void)0)
+#define AERO_PROFILE_END(profiler, phase) ((void)0)
+#define AERO_PROFILE_COUNTER(profiler, counter, value) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef AEROLITE_SAP_H
+#define AEROLITE_SAP_H
+
+#include <memory_resource>
+#include <unordered_set>
+#include <vector>
+#include "AeroAABB2D.h"
+#include "Config.h"
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @class AeroSap
+     * @brief Incremental sweep and prune used by the SAP broad-phase.
+     *
+     * The begin and end points of every proxy's AABB are kept sorted on the x and y axes across frames. Each
+     * update re-sorts them with an insertion sort, which is close to linear when bodies only move a little
+     * between frames. Every swap of a begin point with an end point means two intervals started or stopped
+     * overlapping on that axis, and the persistent pair set is updated from those swaps alone, so it always
+     * holds exactly the proxies whose AABBs overlap. Unlike the spatial hash grid it needs no bounds or cell size.
+     */
+    class AeroSap {
+    public:
+        AeroSap() = default;
+
+        AeroSap(const AeroSap&) = delete;
+        AeroSap(AeroSap&&) noexcept = delete;
+        AeroSap& operator=(const AeroSap&) = delete;
+        AeroSap& operator=(AeroSap&&) = delete;
+
+        /** @brief Default destructor */
+        ~AeroSap() = default;
+
+        /**
+         * @brief Removes every proxy and pair.
+         */
+        void Clear();
+
+        /**
+         * @brief Creates a new proxy. It takes part in the pair set from the next EndUpdate on.
+         * @param aabb The AABB of the object.
+         * @param userData User supplied value associated with the proxy (the body index for the world).
+         * @return The id of the new proxy.
+         */
+        aero_int32 CreateProxy(const AeroAABB2D& aabb, aero_int32 userData);
+
+        /**
+         * @brief Removes a proxy. Its end points and pairs are dropped in the next EndUpdate.
+         * @param proxyId The id of the proxy to destroy.
+         */
+        void DestroyProxy(aero_int32 proxyId);
+
+        /**
+         * @brief Updates the AABB of a proxy. The end points are re-sorted in the next EndUpdate.
+         * @param proxyId The id of the proxy to move.
+         * @param aabb The new AABB of the object.
+         */
+        void MoveProxy(aero_int32 proxyId, const AeroAABB2D& aabb);
+
+        /**
+         * @brief Checks if a proxy id refers to a live proxy.
+         * @param proxyId The id to check.
+         * @return True if the proxy exists, false otherwise.
+         */
+        bool IsProxyValid(aero_int32 proxyId) const;
+
+        const AeroAABB2D& GetAABB(aero_int32 proxyId) const;
+        aero_int32 GetUserData(aero_int32 proxyId) const;
+
+        /**
+         * @brief Updates the user data of a proxy.
+         * @param proxyId The id of the proxy.
+         * @param userData The new user data.
+         */
+        void SetUserData(aero_int32 proxyId, aero_int32 userData);
+
+        /**
+         * @brief Drops the end points of destroyed proxies, re-sorts the end points and updates the pair set.
+         */
+        void EndUpdate();
+
+        /**
+         * @brief Visits every pair of proxies whose AABBs overlap.
+         * @param callback Callable invoked as callback(proxyIdA, proxyIdB).
+         */
+        template<typename Callback>
+        void ForEachPair(Callback&& callback) const;
+
+        /**
+         * @brief Gets the number of live proxies.
+         */
+        aero_int32 GetProxyCount() const;
+
+        /**
+         * @brief Gets the number of overlapping pairs.
+         */
+        std::size_t GetPairCount() const;
+
+    private:
+        struct Proxy {
+            AeroAABB2D aabb;
+            aero_int32 userData = -1;
+            aero_int32 pairCount = 0; ///< Number of pairs in the set that reference the proxy.
+            bool alive = false;
+        };
+
+        /**
+         * @brief A begin or end point of a proxy's interval on one axis.
+         */
+        struct EndPoint {
+            real value;
+            aero_uint32 data; ///< Proxy id shifted left by one, the lowest bit is set for end points.
+
+            [[nodiscard]] aero_int32 GetProxy() const { return static_cast<aero_int32>(data >> 1); }
+            [[nodiscard]] bool IsMax() const { return (data & 1) != 0; }
+        };
+
+        static bool Less(const EndPoint& a, const EndPoint& b);
+        void RefreshValues(std::vector<EndPoint>& axis, int axisIndex) const;
+        void InsertionSort(std::vector<EndPoint>& axis);
+        void Rebuild();
+        void AddPair(aero_int32 proxyA, aero_int32 proxyB);
+        void RemovePair(aero_int32 proxyA, aero_int32 proxyB);
+        static aero_uint64 ComputePairKey(aero_int32 a, aero_int32 b);
+
+        std::vector<Proxy> m_proxies;
+        std::vector<aero_int32> m_freeProxies; ///< Ids whose end points are gone and can be reused.
+        std::vector<aero_int32> m_destroyedProxies; ///< Ids destroyed since the last EndUpdate.
+        aero_int32 m_proxyCount = 0;
+        aero_int32 m_createdCount = 0; ///< Proxies created since the last EndUpdate.
+
+        std::vector<EndPoint> m_axes[2]; ///< End points sorted along x and y.
+        std::pmr::unsynchronized_pool_resource m_pairPool; ///< Recycles the nodes of the pairs that end for the ones that start.
+        std::pmr::unordered_set<aero_uint64> m_pairs{ &m_pairPool }; ///< Persistent set of overlapping proxy pairs.
+        std::vector<aero_int32> m_active; ///< Scratch list of open intervals used by Rebuild.
+    };
+
+    template<typename Callback>
+    void AeroSap::ForEachPair(Callback&& callback) const
+    {
+        for (const aero_uint64 key : m_pairs)
+        {
+            callback(static_cast<aero_int32>(key >> 32), static_cast<aero_int32>(key & 0xFFFFFFFF));
+        }
+    }
+}
+
+#endif // AEROLITE_SAP_H
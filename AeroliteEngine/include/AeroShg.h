@@ -1,7 +1,8 @@
 #ifndef AEROLITE_SPATIAL_HASH_GRID_HPP
 #define AEROLITE_SPATIAL_HASH_GRID_HPP
 
-#include <unordered_map>
+#include <span>
+#include <tuple>
 #include <vector>
 #include "AeroBody2D.h" // Ensure this is the correct path
 #include "Config.h"     // Ensure this is the correct path
@@ -13,6 +14,8 @@ namespace Aerolite {
      * @brief Implements a spatial hash grid for efficient collision detection in a 2D space.
      *
      * The spatial hash grid divides the space into cells, allowing for quick querying of bodies within a certain area.
+     * The grid is stored flat: Place counting-sorts the indices of the bodies into one contiguous array, with one
+     * offset per cell, so rebuilding it every step reuses the same memory and queries are plain spans.
      */
     class AeroShg {
     public:
@@ -37,33 +40,31 @@ namespace Aerolite {
         AeroShg& operator=(AeroShg&&) = delete;
 
         /** @brief Default destructor */
-        ~AeroShg();
+        ~AeroShg() = default;
 
         real GetCellWidth() const;
         real GetCellHeight() const;
+        aero_int32 GetColumnCount() const;
+        aero_int32 GetRowCount() const;
         void SetBounds(const AeroVec2& minPoint, const AeroVec2& maxPoint);
         void SetBounds(real x0, real y0, real x1, real y1);
         void SetCellWidth(real cellWidth);
         void SetCellHeight(real cellHeight);
 
         /**
-         * @brief Places bodies into the spatial hash grid.
-         * @param bodies Vector of pointers to AeroBody2D objects to be placed in the grid.
+         * @brief Rebuilds the grid from scratch with the given bodies, replacing whatever was placed before.
+         * Bodies outside of the bounds are placed in the border cells.
+         * @param aabbs The AABBs of the bodies to place. The grid stores their indices in this span.
          */
-        void Place(const std::vector<std::shared_ptr<AeroBody2D>>& bodies);
-
-	    /**
-	     * \brief Clears the contents of the cell content cache to prepare for next update.
-	     */
-	    void ClearCellContentCache() const;
+        void Place(std::span<const AeroAABB2D> aabbs);
 
         /**
          * @brief Retrieves neighbors close to a specific grid cell.
          * @param x0 The x-coordinate of the cell.
          * @param y0 The y-coordinate of the cell.
-         * @return Vector of pointers to AeroBody2D objects that are neighbors to the specified cell.
+         * @return Indices of the bodies that are neighbors to the specified cell.
          */
-        std::vector<std::shared_ptr<AeroBody2D>> GetNeighbors(aero_int16 x0, aero_int16 y0) const;
+        std::span<const aero_int32> GetNeighbors(aero_int32 x0, aero_int32 y0) const;
 
         /**
         * @brief Computes the grid cell coordinates range covered by a given AABB.
@@ -76,28 +77,30 @@ namespace Aerolite {
          * @brief Gets the content of a specific cell.
          * @param x The x coordinate of the cell.
          * @param y The y coordinate of the cell.
-         * @return Vector of pointers to AeroBody2D objects contained in the specified cell.
+         * @return Indices of the bodies overlapping the cell, in increasing order.
          */
-        std::vector<std::shared_ptr<AeroBody2D>> GetCellContent(const aero_int16 x, const aero_int16 y) const;
+        std::span<const aero_int32> GetCellContent(aero_int32 x, aero_int32 y) const;
 
-    private:
-        struct Cell {
-            std::vector<std::shared_ptr<AeroBody2D>> bodies; ///< Bodies contained within a cell
-        };
 
+    private:
 	    /**
 	     * @brief Resizes the amount of columns and rows in the grid.
 	     * This is usually called after the cell width/height or bounds change.
 	     */
 	    void ResizeGrid();
 
+        /**
+         * @brief Converts a coordinate into a cell coordinate along one axis, clamped to the grid.
+         */
+        static int ToCell(real value, real origin, real invCellSize, aero_uint32 cellCount);
+
         AeroAABB2D m_bounds; ///< Total bounds of the spatial hash grid
         aero_uint32 m_cols, m_rows; ///< Number of columns and rows in the grid
         real m_cellWidth, m_cellHeight; ///< Width and height of each cell
         real m_invCellWidth, m_invCellHeight; ///<Inverse of the cell width/height for computational efficiency.
-        std::unordered_map<aero_uint32, Cell*> m_cells; ///< Mapping from cell keys to cell data
 
-        mutable std::unordered_map<int, std::vector<std::shared_ptr<AeroBody2D>>> m_cellContentCache; ///<Cached version of the cell contents to prevent multiple hash map lookups during update.
+        std::vector<aero_int32> m_cellStart; ///< Offset of every cell's bodies in m_cellBodies, plus one end offset.
+        std::vector<aero_int32> m_cellBodies; ///< Body indices of every cell, stored back to back.
 
         /**
          * @brief Computes a unique key for a cell based on its x and y coordinates.
@@ -105,14 +108,7 @@ namespace Aerolite {
          * @param y The y-coordinate of the cell.
          * @return The computed cell key.
          */
-        aero_uint32 ComputeCellKey(aero_int16 x, aero_int16 y) const;
-
-        /**
-         * @brief Inserts a body into a cell identified by the given key.
-         * @param key The unique key of the cell.
-         * @param body Shared pointer to the AeroBody2D object to insert.
-         */
-        void InsertBodyIntoCell(const aero_uint32 key, const std::shared_ptr<AeroBody2D>& body);
+        aero_uint32 ComputeCellKey(aero_int32 x, aero_int32 y) const;
     };
 }
 
@@ -0,0 +1,78 @@
+#ifndef AERO_SIMD_H
+#define AERO_SIMD_H
+
+#include "AeroVec2.h"
+#include "Config.h"
+
+/*
+ * AERO_SIMD_SSE2 is defined when the SSE2 kernels are compiled in. They need AERO_ENABLE_SIMD, double
+ * precision reals, so an AeroVec2 fills exactly one 128-bit register, and an SSE2 target, which every
+ * x86-64 CPU is. Code using the kernels keeps a scalar version for the other builds.
+ */
+#if defined(AERO_ENABLE_SIMD) && defined(REAL_TYPE_DOUBLE) && (defined(__SSE2__) || defined(_M_X64))
+#define AERO_SIMD_SSE2
+#include <immintrin.h>
+
+/*
+ * AVX kernels are compiled into every SSE2 build and only called when Simd::HasAvx says so. GCC and Clang
+ * need the target attribute to emit AVX code in a function, MSVC emits whatever intrinsics it is given.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define AERO_SIMD_TARGET_AVX
+#else
+#define AERO_SIMD_TARGET_AVX __attribute__((target("avx")))
+#endif
+#endif
+
+/*
+ * Kernels written once as a template over the register type are force inlined into the function of each
+ * width, so they are compiled for that function's target instead of the default one.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define AERO_SIMD_INLINE __forceinline
+#else
+#define AERO_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace Aerolite::Simd {
+
+#ifdef AERO_SIMD_SSE2
+    static_assert(sizeof(AeroVec2) == sizeof(__m128d), "An AeroVec2 must be two packed doubles.");
+
+    /** @brief Loads the x and y of a vector into the low and high lane of a register. */
+    inline __m128d Load(const AeroVec2& v)
+    {
+        return _mm_loadu_pd(&v.x);
+    }
+
+    /** @brief Builds a vector from the low and high lane of a register. */
+    inline AeroVec2 Store(const __m128d v)
+    {
+        AeroVec2 result;
+        _mm_storeu_pd(&result.x, v);
+        return result;
+    }
+
+    /** @brief Checks, once, whether the CPU and the OS support AVX, so kernels can pick their width at run time. */
+    inline bool HasAvx()
+    {
+        static const bool hasAvx = [] {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 1);
+            // The OS must also save the YMM registers, XGETBV reports it once OSXSAVE is set.
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+            return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx") != 0;
+#endif
+        }();
+        return hasAvx;
+    }
+#endif
+}
+
+#endif
@@ -12,7 +12,7 @@ namespace Aerolite {
 
         AeroVec2() = default;
         AeroVec2(const AeroVec2& v) = default;
-        AeroVec2(AeroVec2&& v) noexcept : x(v.x), y(v.y){}
+        AeroVec2(AeroVec2&& v) noexcept = default;
         AeroVec2(real x, real y) noexcept;
         ~AeroVec2() = default;
 
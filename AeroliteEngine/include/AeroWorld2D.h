@@ -1,12 +1,32 @@
 #ifndef AERO_WORLD_2D_H
 #define AERO_WORLD_2D_H
 
-#include <chrono>
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <thread>
 #include <vector>
 #include "AeroBody2D.h"
+#include "AeroBodyPool2D.h"
 #include "AeroBroadPhase.h"
+#include "AeroBvh.h"
+#include "AeroConstraintGraph2D.h"
+#include "AeroContactBatches2D.h"
+#include "AeroFrameArena.h"
+#include "AeroIsland2D.h"
+#include "AeroJobPool.h"
+#include "AeroProfiler.h"
+#include "AeroSap.h"
 #include "AeroShg.h"
+#include "AeroWorldSettings2D.h"
+#include "AeroWorldSnapshot2D.h"
+#include "Collision2D.h"
 #include "Contact2D.h"
+#include "ContactManifold2D.h"
 #include "Particle2D.h"
 #include "Constraint2D.h"
 
@@ -15,20 +35,93 @@ namespace Aerolite {
     private:
         std::vector<std::shared_ptr<Particle2D>> m_particles;
         std::vector<std::unique_ptr<Constraint2D>> m_constraints;
-        std::vector<std::shared_ptr<AeroBody2D>> m_bodies;
+        AeroBodyPool2D m_bodies;
         std::vector<AeroVec2> m_globalForces;
         real m_g = 9.8f;
 
+        std::vector<AeroAABB2D> m_bodyAabbs; ///< AABB of every body for the broad-phase, in the order of GetBodies.
         std::vector<BroadPhasePair> m_broadphasePairs;
-        std::vector<Contact2D> m_contactsList;
+        std::vector<AeroContactRecord2D> m_contacts; ///< Contacts of the last update, in the order of the penetration constraints.
+        std::vector<Contact2D> m_wakeContacts; ///< Scratch contacts of WakeTouchedIslands.
+        ContactManifoldCache2D m_manifolds;
         AeroBroadPhase m_broadPhasePipeline;
         AeroShg m_shg;
+        AeroBvh m_bvh;
+        AeroSap m_sap;
+        AeroIslandManager2D m_islands;
+        AeroConstraintGraph2D m_graph;
+        AeroContactBatches2D m_contactBatches; ///< Penetration constraints of the colors of m_graph, packed for SIMD.
+        AeroJobPool m_jobPool;
+        AeroProfiler m_profiler;
+        AeroWorldSettings2D m_settings;
+        AeroFrameArena m_frameArena; ///< Memory of the data that only lives for one update, reset at its start.
+        real m_accumulator = 0; ///< Frame time not yet simulated by Step, less than one fixed time step.
 
-        // Benchmarking 
-        std::chrono::high_resolution_clock::time_point m_lastLogTime;
-        std::chrono::duration<double> m_accumulatedTime = std::chrono::seconds(0);
-        std::chrono::steady_clock::time_point lastLogTime = std::chrono::steady_clock::now();
-        int m_frameCount = 0;
+        std::thread m_stepThread; ///< Runs the steps of StepAsync, started by the first call.
+        std::mutex m_stepMutex;
+        std::condition_variable m_stepWake; ///< Signals the step thread that a step was queued or that it should stop.
+        std::packaged_task<aero_int32()> m_stepTask; ///< Step queued for the step thread, invalid once taken.
+        bool m_stopStepThread = false;
+        std::shared_future<aero_int32> m_pendingStep; ///< Step of the last StepAsync call, invalid once completed.
+        std::array<AeroWorldSnapshot2D, 2> m_snapshots; ///< Front snapshot read by the game, back one written by the running step.
+        aero_int32 m_frontSnapshot = 0;
+        aero_uint64 m_asyncStepCount = 0;
+
+        /** @brief Contacts the narrow-phase found in one chunk of the broad-phase pairs, all with the same shape types. */
+        struct NarrowPhaseChunk {
+            aero_int32 kernel_index = 0; ///< Kernel of the shape types of every pair of the chunk, see CollisionDetection2D::GetKernelIndex.
+            CollisionDetection2D::Kernel kernel = nullptr;
+            std::size_t begin = 0; ///< First pair of the chunk in m_narrowPhasePairs.
+            std::size_t end = 0;
+            std::vector<Contact2D> contacts;
+        };
+        /** @brief Where the contacts of a broad-phase pair are, in the buffer of the chunk that collided it. */
+        struct PairContacts {
+            aero_int32 chunk = -1; ///< Chunk of the pair, -1 if the pair does not collide.
+            std::size_t first = 0; ///< Index of the first contact of the pair in the contacts of the chunk.
+            std::size_t count = 0;
+        };
+        static constexpr std::size_t NARROW_PHASE_CHUNK_SIZE = 64; ///< Broad-phase pairs per narrow-phase job.
+        std::vector<NarrowPhaseChunk> m_narrowPhaseChunks; ///< Kept between steps so the chunks do not allocate again.
+        std::vector<aero_int32> m_narrowPhasePairs; ///< Indices of the awake broad-phase pairs grouped by kernel, in pair order within a kernel.
+        std::vector<PairContacts> m_pairContacts; ///< Contacts of every broad-phase pair, in the order of m_broadphasePairs.
+        static constexpr std::size_t AABB_CHUNK_SIZE = 256; ///< Bodies per job of UpdateBodyAabbs.
+
+        /** @brief Computes the AABB of every body once for the broad-phase of the update. */
+        void UpdateBodyAabbs();
+
+        bool WakeTouchedIslands();
+        /**
+         * @brief Runs the narrow-phase over the broad-phase pairs and creates the penetration constraints.
+         * The pairs are bucketed by the shape types of their bodies and every bucket is cut into chunks, so a
+         * chunk runs a single collision kernel. The workers collide the chunks into their own buffers, which are
+         * then merged in pair order, so the contacts and constraints are the same for every worker count.
+         */
+        void NarrowPhase(std::pmr::vector<PenetrationConstraint>& penetrations);
+        void StepThreadLoop();
+        /** @brief Waits for the step of the last StepAsync call, if any, and makes its snapshot the front one. */
+        void CompletePendingStep();
+        void WriteSnapshot(AeroWorldSnapshot2D& snapshot, aero_int32 updateCount) const;
+        /**
+         * @brief Runs a stage over the constraints of every awake island: per island for the islands that
+         * were not colored, color by color for the others.
+         * @param iterations The number of passes over every constraint.
+         * @param stage The pass to run, called with the indices of some joints and some penetration
+         * constraints as std::span<const aero_int32>.
+         * @param batchStage The pass to run over the penetration constraints of a color, called with the
+         * index of their first batch in m_contactBatches and their indices as std::span<const aero_int32>.
+         */
+        template<typename Stage, typename BatchStage>
+        void RunSolverStage(aero_int32 iterations, const Stage& stage, const BatchStage& batchStage);
+
+        void PreSolveConstraints(std::span<const aero_int32> joints, std::span<const aero_int32> contacts,
+                                 std::pmr::vector<PenetrationConstraint>& penetrations, real dt);
+        void SolveConstraints(std::span<const aero_int32> joints, std::span<const aero_int32> contacts,
+                              std::pmr::vector<PenetrationConstraint>& penetrations);
+        void RelaxConstraints(std::span<const aero_int32> joints, std::span<const aero_int32> contacts,
+                              std::pmr::vector<PenetrationConstraint>& penetrations);
+        void PostSolveConstraints(std::span<const aero_int32> joints, std::span<const aero_int32> contacts,
+                                  std::pmr::vector<PenetrationConstraint>& penetrations);
     public:
         AeroWorld2D() = default;
         explicit AeroWorld2D(real gravity);
@@ -36,29 +129,102 @@ namespace Aerolite {
         AeroWorld2D(AeroWorld2D&&) = delete;
         void operator=(AeroWorld2D&) = delete;
 		void operator=(AeroWorld2D&&) = delete;
-        ~AeroWorld2D() = default;
+        /** @brief Waits for a step started by StepAsync and stops the step thread. */
+        ~AeroWorld2D();
 
         void ClearWorld();
 
-        std::shared_ptr<AeroBody2D> CreateBody2D(const std::shared_ptr<Shape>& shape, const real x, const real y, const real mass);
-    	const std::vector<std::shared_ptr<AeroBody2D>>& GetBodies() const;
-        std::vector<std::shared_ptr<AeroBody2D>>& GetBodies();
+        /**
+         * @brief Creates a body owned by the world. The pointer stays valid until the body is removed,
+         * keep its handle to refer to the body from code that may outlive it. Shapes are immutable, bodies
+         * with the same geometry can share one shape.
+         */
+        AeroBody2D* CreateBody2D(const std::shared_ptr<const Shape>& shape, const real x, const real y, const real mass);
+
+        /**
+         * @brief Gets the live bodies. Removing a body moves the last body into its place, so indices
+         * are only stable while no body is removed.
+         */
+        std::span<AeroBody2D* const> GetBodies() const;
+
+        /**
+         * @brief Gets the AABBs of the bodies computed at the start of the broad-phase of the last update, in the
+         * order of GetBodies. Every broad-phase algorithm reads them instead of computing the boxes itself.
+         */
+        std::span<const AeroAABB2D> GetBodyAABBs() const;
+
+        /**
+         * @brief Resolves a body handle.
+         * @return The body, or nullptr if it was removed.
+         */
+        AeroBody2D* GetBody(AeroBodyHandle2D handle) const;
+
+        /**
+         * @brief Removes a body in constant time, together with the joints attached to it.
+         * Contacts returned by GetContacts keep pointing to the body until the next update.
+         */
+        void RemoveBody2D(AeroBodyHandle2D handle);
         void RemoveBody2D(int index);
         void RemoveBody2D(AeroBody2D* bodyToRemove);
 
-        void AddJointConstraint(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, const AeroVec2& anchorPoint);
+        void AddJointConstraint(AeroBody2D* a, AeroBody2D* b, const AeroVec2& anchorPoint);
         std::vector<std::unique_ptr<Constraint2D>>& GetConstraints(void);
 
         void SetBroadPhaseAlgorithm(BroadPhaseAlg alg);
         void AddBroadPhasePair(const BroadPhasePair& pair);
         void ClearBroadPhasePairs();
 
+        AeroShg& GetShg();
         const AeroShg& GetShg() const;
         void ShgSetBounds(const AeroVec2& minPoint, const AeroVec2& maxPoint);
         void ShgSetBounds(real x0, real y0, real x1, real y1);
         void ShgSetCellWidth(real cellWidth);
         void ShgSetCellHeight(real cellHeight);
 
+        AeroBvh& GetBvh();
+        const AeroBvh& GetBvh() const;
+        void BvhSetFatMargin(real margin);
+        void BvhSetPredictionTime(real seconds);
+
+        AeroSap& GetSap();
+        const AeroSap& GetSap() const;
+
+        const AeroIslandManager2D& GetIslands() const;
+        void SetSleepingEnabled(bool enabled);
+        void SleepSetLinearTolerance(real tolerance);
+        void SleepSetAngularTolerance(real tolerance);
+        void SleepSetTimeToSleep(real seconds);
+
+        const AeroWorldSettings2D& GetSettings() const;
+
+        /**
+         * @brief Replaces the solver settings. Can be called between any two updates, the next update uses
+         * the new settings. Iteration counts below zero are raised to zero, sub-steps and max_steps_per_frame
+         * to one, and a fixed_time_step that is not positive is reset to its default.
+         */
+        void SetSettings(const AeroWorldSettings2D& settings);
+
+        aero_int32 GetWorkerCount() const;
+
+        /**
+         * @brief Sets how many threads solve the islands of the world, counting the thread calling Update.
+         * Results only depend on the contacts and joints of each island, so they are the same for every worker count.
+         * @param workerCount The number of workers, one (the default) solves everything on the calling thread.
+         */
+        void SetWorkerCount(aero_int32 workerCount);
+
+        /**
+         * @brief Gets the per-step profiler. It only records steps when AERO_ENABLE_PROFILER is defined in Config.h.
+         */
+        AeroProfiler& GetProfiler();
+        const AeroProfiler& GetProfiler() const;
+
+        /**
+         * @brief Gets the arena holding the data of a single update, such as the penetration constraints.
+         * Its high-water mark is the memory an update of the world needs.
+         */
+        const AeroFrameArena& GetFrameArena() const;
+
         void CreateParticle2D(const real x, const real y, const real mass);
         void AddParticle2D(std::shared_ptr<Particle2D> particle);
         void AddParticle2Ds(std::vector<std::unique_ptr<Particle2D>> particles);
@@ -68,7 +234,57 @@ namespace Aerolite {
 
         void Update(real dt);
 
-        [[nodiscard]] std::vector<Contact2D> GetContacts(void) const;
+        /**
+         * @brief Advances the world by the time a frame took, in updates of the settings' fixed_time_step.
+         * The time is added to an accumulator and whole fixed steps are taken from it, the remainder carries
+         * over to the next call. At most max_steps_per_frame updates run per call; if the world falls further
+         * behind the extra time is dropped, so a slow frame cannot make the next one slower still.
+         * The position and rotation of every body are saved before each update, see GetInterpolationAlpha.
+         * Forces added to bodies before the call act on the first update it runs.
+         * @param frameTime Real time elapsed since the last call, in seconds.
+         * @return The number of updates run, zero when the frame was shorter than what is left of a fixed step.
+         */
+        aero_int32 Step(real frameTime);
+
+        /**
+         * @brief Gets how far the time left in Step's accumulator is into the next fixed step, between 0 and 1.
+         * Rendering bodies at GetInterpolatedPosition and GetInterpolatedRotation with this factor lags the
+         * simulation by up to one fixed step but moves smoothly whatever the ratio of frame rate to physics rate.
+         */
+        real GetInterpolationAlpha() const;
+
+        /**
+         * @brief Runs Step(frameTime) on the world's step thread and returns at once, so the game can render and
+         * run its logic while the world steps. Waits for the step of the previous call first, and publishes the
+         * snapshot that step wrote as the one GetSnapshot returns.
+         *
+         * Until the returned future is ready the world belongs to the step thread: the only member functions the
+         * caller may use are GetSnapshot, WaitForStep and StepAsync, and bodies must not be read or written.
+         * ClearWorld and the destructor wait for the step themselves.
+         * @param frameTime Real time elapsed since the last call, in seconds.
+         * @return Future of the number of fixed updates run. It rethrows an exception thrown by the step.
+         */
+        std::shared_future<aero_int32> StepAsync(real frameTime);
+
+        /**
+         * @brief Waits for the step started by the last StepAsync call and publishes its snapshot. After it
+         * returns the world can be used from the calling thread again. Does nothing if no step is running.
+         */
+        void WaitForStep();
+
+        /**
+         * @brief Gets the snapshot of the last completed asynchronous step that was published by StepAsync or
+         * WaitForStep. It is never written while the world steps and stays valid until the next call to either.
+         * Before the first asynchronous step completes the snapshot is empty.
+         */
+        const AeroWorldSnapshot2D& GetSnapshot() const;
+
+        /**
+         * @brief Gets the contact points of the last update, with the impulses the solver applied to them.
+         * The view points into the world's own storage: it copies nothing and stays valid until the next
+         * update or ClearWorld. Contacts of sleeping bodies are not listed.
+         */
+        [[nodiscard]] std::span<const AeroContactRecord2D> GetContacts(void) const;
     };
 }
 
@@ -0,0 +1,34 @@
+#ifndef AERO_WORLD_SETTINGS_2D_H
+#define AERO_WORLD_SETTINGS_2D_H
+
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @struct AeroWorldSettings2D
+     * @brief Solver settings of a world, trading accuracy against CPU time.
+     *
+     * Collision detection runs once per update. The update is then split into sub_steps equal sub-steps,
+     * each of which integrates the forces, presolves and solves the constraints, integrates the positions
+     * and finally relaxes the constraints. Constraint points stay attached to the bodies, so the penetration
+     * of a contact is measured again on every sub-step. The Baumgarte factors are per update and are spread
+     * over the sub-steps, so the velocity that pushes constraints back together does not grow with the
+     * number of sub-steps. The defaults reproduce a single step with three velocity iterations.
+     *
+     * fixed_time_step and max_steps_per_frame are only used by AeroWorld2D::Step, Update takes its own time step.
+     */
+    struct AeroWorldSettings2D {
+        aero_int32 velocity_iterations = 3; ///< Solver iterations per sub-step, with Baumgarte position correction.
+        aero_int32 relax_iterations = 0; ///< Iterations after the position update without position correction, removes the velocity it added.
+        aero_int32 sub_steps = 1; ///< Sub-steps per update, at least one.
+        real contact_beta = 0.2f; ///< Fraction of the penetration of a contact corrected per update.
+        real joint_beta = 0.1f; ///< Fraction of the separation of a joint corrected per update.
+        bool block_solver = true; ///< Solves the normal impulses of two-point manifolds together.
+        aero_int32 coloring_threshold = 0; ///< Islands with at least this many constraints are graph colored and solved by every worker, 0 for none. Ignored with a single worker, see AeroConstraintGraph2D.
+        real fixed_time_step = make_real<real>(1.0) / 60; ///< Time step in seconds of the updates run by Step.
+        aero_int32 max_steps_per_frame = 4; ///< Updates Step runs at most per call, the time left over beyond that is dropped.
+    };
+}
+
+#endif
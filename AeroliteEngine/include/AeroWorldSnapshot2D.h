@@ -0,0 +1,55 @@
+#ifndef AERO_WORLD_SNAPSHOT_2D_H
+#define AERO_WORLD_SNAPSHOT_2D_H
+
+#include <memory>
+#include <vector>
+#include "AeroBody2D.h"
+#include "AeroVec2.h"
+#include "Contact2D.h"
+#include "Precision.h"
+#include "Shape.h"
+
+namespace Aerolite {
+
+    /**
+     * @struct AeroBodySnapshot2D
+     * @brief Copy of the state of a body at the end of a step, as published by AeroWorld2D::StepAsync.
+     */
+    struct AeroBodySnapshot2D {
+        AeroBodyHandle2D handle; ///< Handle of the body in the world, to match the snapshot with the body.
+        std::shared_ptr<const Shape> shape; ///< Shape of the body. Only its local geometry may be read while the world steps.
+        AeroVec2 position; ///< Position at the end of the step.
+        real rotation = 0; ///< Rotation at the end of the step.
+        AeroVec2 previous_position; ///< Position before the last fixed update of the step.
+        real previous_rotation = 0; ///< Rotation before the last fixed update of the step.
+        AeroVec2 linear_velocity;
+        real angular_velocity = 0;
+        bool is_sleeping = false;
+
+        /** @brief Gets the position between the last two fixed updates, see AeroBody2D::GetInterpolatedPosition. */
+        [[nodiscard]] AeroVec2 GetInterpolatedPosition(const real alpha) const {
+            return previous_position + (position - previous_position) * alpha;
+        }
+
+        /** @brief Gets the rotation between the last two fixed updates, see AeroBody2D::GetInterpolatedRotation. */
+        [[nodiscard]] real GetInterpolatedRotation(const real alpha) const {
+            return previous_rotation + (rotation - previous_rotation) * alpha;
+        }
+    };
+
+    /**
+     * @struct AeroWorldSnapshot2D
+     * @brief Read-only copy of the bodies and contacts of a world after a step. AeroWorld2D::StepAsync keeps
+     * two of them: the step running on the step thread fills one while the game reads the other, so the
+     * game never needs a lock.
+     */
+    struct AeroWorldSnapshot2D {
+        aero_uint64 step = 0; ///< Number of asynchronous steps completed when the snapshot was taken, 0 for none yet.
+        aero_int32 update_count = 0; ///< Fixed updates run by the step.
+        real interpolation_alpha = 0; ///< Interpolation factor after the step, see AeroWorld2D::GetInterpolationAlpha.
+        std::vector<AeroBodySnapshot2D> bodies; ///< Every body of the world, in the order of AeroWorld2D::GetBodies.
+        std::vector<AeroContactRecord2D> contacts; ///< Contacts of the last update of the step, see AeroWorld2D::GetContacts.
+    };
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef COLLISION_DETECTION_H
 #define COLLISION_DETECTION_H
 
+#include <array>
+#include <span>
 #include "AeroAABB2D.h"
 #include "AeroBody2D.h"
 #include "Contact2D.h"
@@ -18,7 +20,30 @@ namespace Aerolite {
         /// @param b The second AeroBody2D for detection.
         /// @param contacts A vector of contact2D object to store collision information if one is detected.
         /// @return Returns true if collision is detected, false if not.
-        static bool IsColliding(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, std::vector<Contact2D>& contacts);
+        static bool IsColliding(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts);
+
+        /// @brief Collision routine of one combination of shape types, with the same parameters as IsColliding.
+        using Kernel = bool (*)(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts);
+
+        static constexpr aero_int32 KERNEL_COUNT = SHAPE_TYPE_COUNT * SHAPE_TYPE_COUNT; ///< Entries of the dispatch table.
+
+        /// @brief Gets the index in the dispatch table of the kernel colliding a shape of type a with a shape of type b.
+        static constexpr aero_int32 GetKernelIndex(const ShapeType a, const ShapeType b) { return a * SHAPE_TYPE_COUNT + b; }
+
+        /// @brief Gets a kernel from the dispatch table. Callers colliding many pairs can group them by kernel
+        /// index and look the kernel up once per group.
+        /// @param kernelIndex The index of the kernel, see GetKernelIndex.
+        static Kernel GetKernel(aero_int32 kernelIndex);
+
+        /// @brief Collides pairs of circles several at a time, with the widest SIMD instructions the CPU supports.
+        /// Gives the same contacts as colliding the pairs one by one with IsColliding.
+        /// @param a The first body of every pair, with a circle shape.
+        /// @param b The second body of every pair, with a circle shape.
+        /// @param contacts Receives one contact per overlapping pair, in pair order.
+        /// @param hits Receives the index of the pair of every contact appended, must be at least as large as a.
+        /// @return The number of overlapping pairs.
+        static std::size_t CollideCircleBatch(std::span<AeroBody2D* const> a, std::span<AeroBody2D* const> b,
+                                              std::vector<Contact2D>& contacts, std::span<aero_int32> hits);
 
         /// <summary>
         /// Determines if two axis-aligned bounding boxes for two bodies are intersecting.
@@ -30,12 +55,16 @@ namespace Aerolite {
         static bool IntersectAABBs(const AeroAABB2D& a, const AeroAABB2D& b);
 
     private:
+        /// @brief Kernel of the shape types A and B, the routine is picked at compile time.
+        template<ShapeType A, ShapeType B>
+        static bool Collide(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts);
+
         /// @brief Detects if two circle AeroBody2D's are colliding.
         /// @param a The first circle body for detection.
         /// @param b The second circle body for detection.
         /// @param contacts A vector of contact2D object to store collision information if one is detected.
         /// @return Returns true if the two circles are colliding, false if not.
-        static bool IsCollidingCircleCircle(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, std::vector<Contact2D>& contacts);
+        static bool IsCollidingCircleCircle(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts);
 
         /// <summary>
         /// Detects if two polygons are colliding.
@@ -44,7 +73,7 @@ namespace Aerolite {
         /// <param name="b">The second polygon body for detection.</param>\
         /// <param name="contacts"> contacts A vector of contact2D object to store collision information if one is detected.
         /// <returns>Returns true if the two polygons are colliding, false if not.</returns>
-        static bool IsCollidingPolygonPolygon(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, std::vector<Contact2D>& contacts);
+        static bool IsCollidingPolygonPolygon(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts);
 
         /// <summary>
         /// Detects if a circle and polygon are colliding.
@@ -53,26 +82,24 @@ namespace Aerolite {
         /// <param name="circle">The circle body for detection.</param>
         /// <param name="contacts">A reference parameter to store collision and contact information.</param>
         /// <returns>Returns true if the polygon and circle are colliding, false if not.</returns>
-        static bool IsCollidingCirclePolygon(const std::shared_ptr<AeroBody2D>& polygon, const std::shared_ptr<AeroBody2D>
-                                             & circle, std::vector<Contact2D>& contacts);
+        static bool IsCollidingCirclePolygon(AeroBody2D* polygon, AeroBody2D* circle, std::vector<Contact2D>& contacts);
 
         /// <summary>
         /// Helper function for setting the contact details of the circle polygon collision detection algorithm for regions A and B.
         /// </summary>
-        static void SetContactDetails(Contact2D& contact, const std::shared_ptr<AeroBody2D>& polygon, const std::shared_ptr<AeroBody2D>
-                                      & circle, const AeroVec2& v1, real radius);
+        static void SetContactDetails(Contact2D& contact, AeroBody2D* polygon, AeroBody2D* circle, const AeroVec2& v1, real radius);
 
         /// <summary>
         /// Helper function for setting the contact details of the circle polygon collision detection algorithm for region C.
         /// </summary>
-        static void SetContactDetailsForRegionC(Contact2D& contact, const std::shared_ptr<AeroBody2D>& polygon, const std::shared_ptr<AeroBody2D>& circle, const AeroVec2& minCurrVertex,
+        static void SetContactDetailsForRegionC(Contact2D& contact, AeroBody2D* polygon, AeroBody2D* circle, const AeroVec2& minCurrVertex,
                                                 const AeroVec2& minNextVertex, real radius, real distanceToCircleEdge);
 
         /// <summary>
         /// Helper function for setting the contact details of the circle polygon collision detection algorithm for when the 
         /// circle center is inside the polygon.
         /// </summary>
-        static void SetContactDetailsForInsideCollision(Contact2D& contact, const std::shared_ptr<AeroBody2D>& polygon, const std::shared_ptr<AeroBody2D>& circle, const AeroVec2& minCurrVertex,
+        static void SetContactDetailsForInsideCollision(Contact2D& contact, AeroBody2D* polygon, AeroBody2D* circle, const AeroVec2& minCurrVertex,
                                                         const AeroVec2& minNextVertex, real radius, real distanceToCircleEdge);
 
         /// <summary>
@@ -82,7 +109,7 @@ namespace Aerolite {
         /// <param name="b">The second polygon for collision detection.</param>
         /// <param name="contact">A reference parameter to store collision and contact information.</param>
         /// <returns></returns>
-        static bool IsCollidingSATBruteForce(std::shared_ptr<AeroBody2D> a, std::shared_ptr<AeroBody2D> b, Contact2D& contact);
+        static bool IsCollidingSATBruteForce(AeroBody2D* a, AeroBody2D* b, Contact2D& contact);
 
         /// <summary>
         /// Uses an optimized version of the SAT algorithm to determine if two polygons are colliding.
@@ -91,17 +118,17 @@ namespace Aerolite {
         /// <param name="b">The second polygon for collision detection.</param>
          /// <param name="contacts">A reference parameter to store collision and contact information.</param>
         /// <returns></returns>
-        static bool IsCollidingSATOptimized(std::shared_ptr<AeroBody2D> a, std::shared_ptr<AeroBody2D> b, std::vector<Contact2D>& contacts);
+        static bool IsCollidingSATOptimized(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts);
 
         /// <summary>
         /// Projects the given vertices onto the given axis and find the minimum and maximum projections
         /// of the vertices onto the axis. Stores the min/max in the pass by reference values.
         /// </summary>
-        /// <param name="vertices">The vertices to project</param>
+        /// <param name="polygon">The polygon whose vertices are projected.</param>
         /// <param name="axis">The axis to project the vertices on.</param>
         /// <param name="min">The value to store the minimum projection value in.</param>
         /// <param name="max">The value to store the maximum projection value in.</param>
-        static void FindMinMaxProjections(const std::vector<AeroVec2>& vertices, const AeroVec2& axis, real& min, real& max);
+        static void FindMinMaxProjections(const PolygonLanes& polygon, const AeroVec2& axis, real& min, real& max);
 
         /// <summary>
         /// Finds the distance between a point p and the closest point on a line defined
@@ -118,10 +145,10 @@ namespace Aerolite {
         /// <summary>
         /// Finds all contact points if any exist between two polygons.
         /// </summary>
-        /// <param name="shapeA">The first polygon.</param>
-        /// <param name="shapeB">The second polygon.</param>
+        /// <param name="polygonA">The world space lanes of the first polygon.</param>
+        /// <param name="polygonB">The world space lanes of the second polygon.</param>
         /// <param name="contact">The contact structure to store collision information in.</param>
-        static void FindContactPointsPolygons(const PolygonShape& shapeA, const PolygonShape& shapeB, Contact2D& contact);
+        static void FindContactPointsPolygons(const PolygonLanes& polygonA, const PolygonLanes& polygonB, Contact2D& contact);
     };
 }
 
@@ -1,6 +1,8 @@
 #ifndef AERO_CONFIG_H
 #define AERO_CONFIG_H
 
+#include <cstdint>
+
 namespace Aerolite
 {
 
@@ -21,6 +23,16 @@ namespace Aerolite
 #define BROAD_PHASE_BRUTE_FORCE
 #define BROAD_PHASE_SHG
 
+/**
+ * \brief Comment out to compile the per-step profiler out of AeroWorld2D::Update.
+ */
+#define AERO_ENABLE_PROFILER
+
+/**
+ * \brief Comment out to use the scalar code instead of the SIMD kernels, see AeroSimd.h.
+ */
+#define AERO_ENABLE_SIMD
+
 /*
  * Aerolite Engine Typedefs
  */
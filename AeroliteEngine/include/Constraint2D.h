@@ -8,13 +8,13 @@
 namespace Aerolite {
 	class Constraint2D {
 	public:
-		std::shared_ptr<AeroBody2D> a;
-		std::shared_ptr<AeroBody2D> b;
+		AeroBody2D* a;
+		AeroBody2D* b;
 
 		AeroVec2 aPoint; // Constraint specific point in A's local space.
 		AeroVec2 bPoint; // Constraint specific point in B's local space.
 
-		Constraint2D(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b);
+		Constraint2D(AeroBody2D* a, AeroBody2D* b);
 		virtual ~Constraint2D() = default;
 
 		/// <summary>
@@ -23,20 +23,37 @@ namespace Aerolite {
 		/// <returns>matrix of inverse mass and inverse moment of inertia for bodies "a" and "b".</returns>
 		MatrixMxN<6, 6> GetInvM() const;
 
+		/// <summary>
+		/// Gets the diagonal of the inverse mass/moment matrix, the only part of it that is not zero.
+		/// </summary>
+		/// <returns>vector of inverse mass and inverse moment of inertia for bodies "a" and "b".</returns>
+		VecN<6> GetInvMDiagonal() const;
+
 		/// <summary>
 		/// Creates linear and angular linear_velocity vector for constraint solving.
 		/// </summary>
 		/// <returns>1x6 vector of linear and angular velocities of bodies "a" and "b".</returns>
-		MatrixMxN<6,1> GetVelocities() const;
+		VecN<6> GetVelocities() const;
 
 
-		virtual void PreSolve(const real dt) = 0;
+		/// <summary>
+		/// Prepares the constraint for solving and applies the impulses of the last (sub-)step (warm starting).
+		/// </summary>
+		/// <param name="dt">The time step the constraint is solved for.</param>
+		/// <param name="beta">Fraction of the position error corrected over the time step (Baumgarte stabilization).</param>
+		virtual void PreSolve(real dt, real beta) = 0;
 
 		/// <summary>
 		/// Solves the constraint.
 		/// </summary>
 		virtual void Solve(void) = 0;
 
+		/// <summary>
+		/// Solves the constraint without the position correction, to remove the velocity it added
+		/// once the positions were integrated.
+		/// </summary>
+		virtual void Relax(void) = 0;
+
 		virtual void PostSolve(void) = 0;
 	};
 
@@ -45,34 +62,108 @@ namespace Aerolite {
 		MatrixMxN<1,6> jacobian;
 		real cachedLambda;
 		real bias;
+
+		void SolveWithBias(real rowBias);
 	public:
 
 		JointConstraint() = default;
-		JointConstraint(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, const AeroVec2& anchorPoint);
+		JointConstraint(AeroBody2D* a, AeroBody2D* b, const AeroVec2& anchorPoint);
 
-		virtual void PreSolve(real dt) override;
+		virtual void PreSolve(real dt, real beta) override;
 		virtual void Solve() override;
+		virtual void Relax() override;
 		virtual void PostSolve() override;
 	};
 
+	/// <summary>
+	/// Non-penetration and friction constraint of a single contact point.
+	/// Both rows are solved as independent scalar constraints. Everything that does not change while
+	/// iterating (world normal and tangent, lever arms, effective masses and bias) is computed once in
+	/// PreSolve, so an iteration only reads the velocities of the two bodies.
+	/// The two points of a polygon manifold can be linked into a block with LinkBlock. The first point
+	/// then presolves and solves both, and the normal impulses of the pair are solved together as a 2x2
+	/// LCP, which stops resting boxes from rocking between their two corners. When the two rows are
+	/// close to parallel the system is ill-conditioned and the pair falls back to sequential solving.
+	/// </summary>
 	class PenetrationConstraint : public Constraint2D {
 	private:
-		MatrixMxN<2,6> jacobian;
-		VecN<2> cachedLambda;
+		real normalImpulse; // Accumulated impulse along the normal.
+		real tangentImpulse; // Accumulated friction impulse along the tangent.
 		real bias;
+		real restitutionBias; // The bias without the position correction, used by Relax.
 		AeroVec2 normal; // Collision normal in A's local space.
 		real friction; // Friction coefficient between the two bodies.
+
+		// Per-step data computed in PreSolve.
+		AeroVec2 n; // Collision normal in world space.
+		AeroVec2 t; // Contact tangent in world space.
+		AeroVec2 ra; // Vector from the center of mass of "a" to the contact point.
+		AeroVec2 rb; // Vector from the center of mass of "b" to the contact point.
+		real normalMass; // Inverse of the effective mass J * M^-1 * J^T along the normal.
+		real tangentMass; // Inverse of the effective mass along the tangent.
+		real invMassA, invInertiaA; // Zero when "a" is static, the solve loop leaves static bodies alone.
+		real invMassB, invInertiaB;
+		AeroBodyStates2D* states; // Velocities of both bodies, so iterations do not touch the body objects.
+		aero_uint32 stateA, stateB; // Rows of "a" and "b" in states.
+
+		// Block of a two-point manifold, only used by the first point of the pair.
+		PenetrationConstraint* blockPartner; // Second point of the manifold, solved by this constraint.
+		bool isBlockPartner; // Set on the second point, its work is done by the first one.
+		bool useBlock; // False when the 2x2 system is ill-conditioned this step.
+		real k11, k12, k22; // Effective mass matrix K of the two normal rows.
+		real blockMass11, blockMass12, blockMass22; // Inverse of K.
+
+		void PreSolvePoint(real dt, real beta);
+		void SolveRows(bool useBias);
+		void SolveNormal(bool useBias);
+		void SolveTangent();
+		void SolveBlockNormal(bool useBias);
+
+		/// <summary>
+		/// Gets the velocity of "b" relative to "a" at the contact point.
+		/// </summary>
+		void RelativeVelocity(real& x, real& y) const;
+
+		/// <summary>
+		/// Applies an impulse to "b" at the contact point and the opposite impulse to "a".
+		/// </summary>
+		void ApplyImpulse(real x, real y) const;
+
+		friend class AeroContactBatches2D; // Packs the per-step data to solve colored constraints with SIMD.
 	public:
 		PenetrationConstraint() = default;
 		PenetrationConstraint(
-			std::shared_ptr<AeroBody2D> a,
-			std::shared_ptr<AeroBody2D> b,
+			AeroBody2D* a,
+			AeroBody2D* b,
 			const AeroVec2& aCollisionPoint,
 			const AeroVec2& bCollisionPoint, 
 			const AeroVec2& collisionNormal);
-		virtual void PreSolve(real dt) override;
+		virtual void PreSolve(real dt, real beta) override;
 		virtual void Solve() override;
+		virtual void Relax() override;
 		virtual void PostSolve() override;
+
+		/// <summary>
+		/// Seeds the accumulated impulses with the values of the previous step (warm starting).
+		/// </summary>
+		/// <param name="normalImpulse">The accumulated impulse along the contact normal.</param>
+		/// <param name="tangentImpulse">The accumulated friction impulse along the contact tangent.</param>
+		void SetCachedImpulses(real normalImpulse, real tangentImpulse);
+
+		/// <summary>
+		/// Links the two points of a manifold into a block solved by this constraint. Both constraints must
+		/// stay at the same address until the step is solved.
+		/// </summary>
+		/// <param name="partner">The second point of the manifold, between the same two bodies.</param>
+		void LinkBlock(PenetrationConstraint& partner);
+
+		/// <summary>
+		/// Checks if this is the second point of a block, which is presolved and solved by the first point.
+		/// </summary>
+		bool IsBlockPartner() const;
+
+		real GetNormalImpulse() const;
+		real GetTangentImpulse() const;
 	};
 }
 
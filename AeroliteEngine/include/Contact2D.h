@@ -1,6 +1,7 @@
 #ifndef CONTACT2D_H
 #define CONTACT2D_H
 
+#include <type_traits>
 #include "AeroVec2.h"
 #include "AeroBody2D.h"
 #include "Precision.h"
@@ -14,8 +15,8 @@ namespace Aerolite {
     public:
         // Pointers to the bodies involved in the contact.
         // The bodies are presumably managed elsewhere in your physics engine.
-        std::shared_ptr<AeroBody2D> a = nullptr;
-        std::shared_ptr<AeroBody2D> b = nullptr;
+        AeroBody2D* a = nullptr;
+        AeroBody2D* b = nullptr;
 
         // The start point of the contact in world coordinates.
         AeroVec2 start;
@@ -31,6 +32,10 @@ namespace Aerolite {
         // A positive value typically indicates the amount by which the bodies are overlapping.
         real depth = 0;
 
+        // Identifies the pair of geometric features (edges, vertices) that generated this contact.
+        // Used to match contacts across steps for warm starting.
+        aero_uint32 feature_id = 0;
+
         // Default constructor.
         Contact2D() = default;
 
@@ -47,6 +52,7 @@ namespace Aerolite {
             end = other.end;
             normal = other.normal;
             depth = other.depth;
+            feature_id = other.feature_id;
         }
 
         // Copy assignment operator.
@@ -58,6 +64,7 @@ namespace Aerolite {
                 end = other.end;
                 normal = other.normal;
                 depth = other.depth;
+                feature_id = other.feature_id;
             }
             return *this;
         }
@@ -65,7 +72,7 @@ namespace Aerolite {
         // Move constructor.
         Contact2D(Contact2D&& other) noexcept
             : a(std::move(other.a)), b(std::move(other.b)), start(std::move(other.start)), end(std::move(other.end)),
-            normal(std::move(other.normal)), depth(other.depth) {
+            normal(std::move(other.normal)), depth(other.depth), feature_id(other.feature_id) {
             other.a = nullptr;
             other.b = nullptr;
         }
@@ -79,6 +86,7 @@ namespace Aerolite {
                 end = std::move(other.end);
                 normal = std::move(other.normal);
                 depth = other.depth;
+                feature_id = other.feature_id;
 
                 other.a = nullptr;
                 other.b = nullptr;
@@ -90,6 +98,23 @@ namespace Aerolite {
         void ResolvePenetration(void) const;
         void ResolveImpulse();
     };
+
+    /**
+     * @struct AeroContactRecord2D
+     * @brief A contact point of the last world update as seen by gameplay code. A plain record that refers
+     * to the bodies by handle, so reading the contacts of a world copies nothing and touches no body.
+     */
+    struct AeroContactRecord2D {
+        AeroBodyHandle2D a; ///< Handle of the first body.
+        AeroBodyHandle2D b; ///< Handle of the second body.
+        AeroVec2 start; ///< Start point of the contact in world coordinates.
+        AeroVec2 end; ///< End point of the contact in world coordinates.
+        AeroVec2 normal; ///< Collision normal.
+        real depth = 0; ///< Penetration depth.
+        real normal_impulse = 0; ///< Impulse the solver applied along the normal during the update.
+        real tangent_impulse = 0; ///< Friction impulse the solver applied along the tangent during the update.
+    };
+    static_assert(std::is_trivially_copyable_v<AeroContactRecord2D>, "Contact records are copied as plain memory");
 } // namespace Aerolite
 
 #endif
@@ -0,0 +1,110 @@
+#ifndef CONTACT_MANIFOLD_2D_H
+#define CONTACT_MANIFOLD_2D_H
+
+#include <array>
+#include <memory_resource>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "AeroBroadPhase.h"
+#include "AeroVec2.h"
+#include "Constraint2D.h"
+#include "Contact2D.h"
+#include "Precision.h"
+
+namespace Aerolite {
+
+    /**
+     * @struct ContactPoint2D
+     * @brief A single cached contact point of a manifold. Stores the accumulated impulses
+     * of the point so they can be used to warm start the solver on the next step.
+     */
+    struct ContactPoint2D {
+        aero_uint32 feature_id = 0; ///< Identifies the pair of geometric features that generated the point.
+        AeroVec2 local_point; ///< Contact point on body "a" in a's local space, used when features do not match.
+        real normal_impulse = 0; ///< Accumulated impulse along the contact normal.
+        real tangent_impulse = 0; ///< Accumulated friction impulse along the contact tangent.
+    };
+
+    /**
+     * @struct ContactManifold2D
+     * @brief The persistent set of contact points between a pair of bodies.
+     */
+    struct ContactManifold2D {
+        static constexpr std::size_t MAX_POINTS = 2; ///< Clipping leaves at most two points between two shapes.
+
+        std::array<ContactPoint2D, MAX_POINTS> points; ///< Points generated by the narrow-phase this step.
+        std::size_t point_count = 0; ///< Number of points in use.
+        std::size_t first_constraint = 0; ///< Index of the first penetration constraint of this manifold in the current step.
+        aero_uint32 stamp = 0; ///< Step in which the manifold was last touched by the narrow-phase.
+        aero_uint32 generation_a = 0; ///< Handle generation of the body with the smaller id.
+        aero_uint32 generation_b = 0; ///< Handle generation of the body with the larger id.
+    };
+
+    /**
+     * @class ContactManifoldCache2D
+     * @brief Keeps contact manifolds alive across steps, keyed by the broad-phase id pair of the two bodies.
+     *
+     * Each step the narrow-phase results are matched against the previous points of the same pair,
+     * first by feature id and then by proximity, and the accumulated normal and tangent impulses of
+     * matched points are carried over into the new penetration constraints (warm starting).
+     * Manifolds of pairs that stopped touching are discarded at the end of the step. Ids are reused once a
+     * body is removed, so a manifold is only carried over when the handle generations of both bodies match.
+     */
+    class ContactManifoldCache2D {
+    public:
+        ContactManifoldCache2D() = default;
+        ~ContactManifoldCache2D() = default;
+
+        /**
+         * @brief Removes every manifold from the cache.
+         */
+        void Clear();
+
+        /**
+         * @brief Starts a new step.
+         */
+        void BeginStep();
+
+        /**
+         * @brief Updates the manifold of a pair with the contacts generated by the narrow-phase and
+         * appends a warm started penetration constraint for every contact.
+         * @param pair The broad-phase pair of the two bodies.
+         * @param contacts The contacts generated for this pair this step.
+         * @param penetrations The constraint list solved this step.
+         */
+        void AddManifold(const BroadPhasePair& pair, std::span<const Contact2D> contacts, std::pmr::vector<PenetrationConstraint>& penetrations);
+
+        /**
+         * @brief Links the two constraints of every two-point manifold touched this step into a block.
+         * Called once every manifold was added, so the constraints no longer move.
+         * @param penetrations The constraint list solved this step.
+         */
+        void LinkBlocks(std::pmr::vector<PenetrationConstraint>& penetrations) const;
+
+        /**
+         * @brief Copies the impulses accumulated by the solver back into the touched manifolds.
+         * @param penetrations The constraint list that was solved this step.
+         */
+        void StoreImpulses(const std::pmr::vector<PenetrationConstraint>& penetrations);
+
+        /**
+         * @brief Discards the manifolds of pairs that were not touched this step.
+         */
+        void EndStep();
+
+        /**
+         * @brief Gets the number of manifolds currently held by the cache.
+         */
+        std::size_t Size() const;
+
+    private:
+        /// Recycles the nodes of the manifolds that stop touching for the ones that start touching.
+        std::pmr::unsynchronized_pool_resource m_manifoldPool;
+        std::pmr::unordered_map<aero_uint64, ContactManifold2D> m_manifolds{ &m_manifoldPool };
+        std::vector<ContactManifold2D*> m_touched; ///< Manifolds updated this step, in narrow-phase order.
+        aero_uint32 m_stamp = 0;
+    };
+}
+
+#endif
@@ -2,37 +2,38 @@
 #define MATRIX_MXN_H
 
 #include "VecN.h"
-#include <vector>
-#include <stdexcept>
+#include <array>
+#include <cassert>
 
 namespace Aerolite {
 
+    // Template class for an M by N matrix stored as M rows of VecN<N>.
+    // The rows live inline in a std::array, so matrices never allocate and can be used in constant expressions.
     template<std::size_t M, std::size_t N>
     class MatrixMxN {
     private:
-        std::vector<VecN<N>> rows; // Rows of the matrix
+        std::array<VecN<N>, M> rows; // Rows of the matrix
 
     public:
-        // Default constructor
-        MatrixMxN() : rows(M) {}
+        // Default constructor, every element is zero.
+        constexpr MatrixMxN() : rows{} {}
 
         // Constructor with initial values
-        MatrixMxN(const std::array<VecN<N>, M>& initialValues) : rows(initialValues.begin(), initialValues.end()) {}
-
-        // Copy constructor
-        MatrixMxN(const MatrixMxN& other) : rows(other.rows) {}
+        constexpr MatrixMxN(const std::array<VecN<N>, M>& initialValues) : rows(initialValues) {}
 
+        constexpr MatrixMxN(const MatrixMxN& other) = default;
+        constexpr MatrixMxN& operator=(const MatrixMxN& other) = default;
         ~MatrixMxN() = default;
 
         // Zero the matrix
-        void Zero() {
+        constexpr void Zero() {
             for (auto& row : rows) {
                 row.Zero();
             }
         }
 
         // Transpose the matrix
-        MatrixMxN<N, M> Transpose() const {
+        constexpr MatrixMxN<N, M> Transpose() const {
             MatrixMxN<N, M> transposedMatrix;
             for (std::size_t i = 0; i < N; ++i) {
                 for (std::size_t j = 0; j < M; ++j) {
@@ -42,17 +43,9 @@ namespace Aerolite {
             return transposedMatrix;
         }
 
-        // Assignment operator
-        MatrixMxN& operator=(const MatrixMxN& other) {
-            if (this != &other) {
-                rows = other.rows;
-            }
-            return *this;
-        }
-
         // Matrix-vector multiplication
         template<std::size_t P>
-        VecN<M> operator*(const VecN<P>& v) const {
+        constexpr VecN<M> operator*(const VecN<P>& v) const {
             static_assert(N == P, "Matrix and vector dimensions are not compatible for multiplication.");
             VecN<M> result;
             for (std::size_t i = 0; i < M; ++i) {
@@ -63,7 +56,7 @@ namespace Aerolite {
 
         // Matrix-matrix multiplication with size checks
         template<std::size_t P, std::size_t Q>
-        MatrixMxN<M, Q> operator*(const MatrixMxN<P, Q>& other) const {
+        constexpr MatrixMxN<M, Q> operator*(const MatrixMxN<P, Q>& other) const {
             static_assert(N == P, "Matrix dimensions are not compatible for multiplication.");
 
             MatrixMxN<M, Q> result;
@@ -78,7 +71,7 @@ namespace Aerolite {
         }
 
         // Scalar multiplication
-        MatrixMxN operator*(real scalar) const {
+        constexpr MatrixMxN operator*(real scalar) const {
             MatrixMxN<M, N> result;
             for (std::size_t i = 0; i < M; ++i) {
                 for (std::size_t j = 0; j < N; ++j) {
@@ -89,28 +82,59 @@ namespace Aerolite {
         }
 
         // In-place scalar multiplication
-        MatrixMxN& operator*=(real scalar) {
+        constexpr MatrixMxN& operator*=(real scalar) {
             for (auto& row : rows) {
                 row *= scalar;
             }
             return *this;
         }
 
-        // Access element (non-const and const)
-        VecN<N>& operator[](std::size_t index) {
-            if (index >= M) {
-                throw std::out_of_range("Row index out of range");
-            }
+        // Access element (non-const and const). The row index is only range checked in debug builds.
+        constexpr VecN<N>& operator[](std::size_t index) {
+            assert(index < M && "Row index out of range");
             return rows[index];
         }
 
-        const VecN<N>& operator[](std::size_t index) const {
-            if (index >= M) {
-                throw std::out_of_range("Row index out of range");
-            }
+        constexpr const VecN<N>& operator[](std::size_t index) const {
+            assert(index < M && "Row index out of range");
             return rows[index];
         }
 
+        /// <summary>
+        /// Computes the transpose of this matrix times a vector without building the transpose.
+        /// Used to turn the constraint impulses into body impulses (J^T * lambda for the 1x6 and 2x6 jacobians).
+        /// </summary>
+        /// <param name="v">The vector to multiply, one value per row.</param>
+        /// <returns>The vector M^T * v.</returns>
+        constexpr VecN<N> TransposeMultiply(const VecN<M>& v) const {
+            VecN<N> result;
+            for (std::size_t j = 0; j < N; ++j) {
+                for (std::size_t i = 0; i < M; ++i) {
+                    result[j] += rows[i][j] * v[i];
+                }
+            }
+            return result;
+        }
+
+        /// <summary>
+        /// Computes this matrix times a diagonal matrix times the transpose of this matrix (J * D * J^T).
+        /// The constraint solver's inverse mass matrix is a diagonal 6x6, so the effective mass of a
+        /// 1x6 or 2x6 jacobian only needs the diagonal instead of two full matrix products.
+        /// </summary>
+        /// <param name="diagonal">The diagonal of the N by N matrix D.</param>
+        /// <returns>The M by M matrix J * D * J^T.</returns>
+        constexpr MatrixMxN<M, M> MultiplyDiagonalTranspose(const VecN<N>& diagonal) const {
+            MatrixMxN<M, M> result;
+            for (std::size_t i = 0; i < M; ++i) {
+                for (std::size_t j = 0; j < M; ++j) {
+                    for (std::size_t k = 0; k < N; ++k) {
+                        result[i][j] += rows[i][k] * diagonal[k] * rows[j][k];
+                    }
+                }
+            }
+            return result;
+        }
+
         /// <summary>
         /// Static method for solving a system of linear equations using Gauss-Seidel method.
         /// Matrix A must be square, and vector b must have the same number of rows as A.
@@ -118,14 +142,12 @@ namespace Aerolite {
         /// <param name="A">The A matrix in Ax=b.</param>
         /// <param name="b">The b vector in Ax=b.</param>
         /// <returns></returns>
-        static VecN<M> SolveGaussSeidel(const MatrixMxN<M, M>& A, const VecN<M>& b) {
-            const int N = M;
-            VecN<N> X;
-            X.Zero();
-
-            // Iterate N times
-            for (int iterations = 0; iterations < N; iterations++) {
-                for (int i = 0; i < N; i++) {
+        static constexpr VecN<M> SolveGaussSeidel(const MatrixMxN<M, M>& A, const VecN<M>& b) {
+            VecN<M> X;
+
+            // Iterate M times
+            for (std::size_t iterations = 0; iterations < M; iterations++) {
+                for (std::size_t i = 0; i < M; i++) {
                     real dx = (b[i] / A.rows[i][i]) - (A.rows[i].Dot(X) / A.rows[i][i]);
                     if (dx == dx) {
                         X[i] += dx;
@@ -138,4 +160,4 @@ namespace Aerolite {
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -51,7 +51,7 @@ namespace Aerolite {
     inline real RealSqrt(const real a)
     {
         if (std::is_same_v < real, float>)
-            return std::sqrtf(a);
+            return std::sqrt(a);
         else if (std::is_same_v<real, double>)
             return std::sqrt(a);
     }
@@ -65,7 +65,7 @@ namespace Aerolite {
     inline real RealSin(const real a)
     {
         if (std::is_same_v < real, float>)
-            return std::sinf(a);
+            return std::sin(a);
         else if (std::is_same_v<real, double>)
             return std::sin(a);
     }
@@ -79,7 +79,7 @@ namespace Aerolite {
     inline real RealCos(const real a)
     {
         if (std::is_same_v < real, float>)
-            return std::cosf(a);
+            return std::cos(a);
         else if (std::is_same_v<real, double>)
             return std::cos(a);
     }
@@ -93,7 +93,7 @@ namespace Aerolite {
     inline real RealPow(const real base, const real power)
     {
         if (std::is_same_v < real, float>)
-            return std::powf(base, power);
+            return std::pow(base, power);
         else if (std::is_same_v<real, double>)
             return std::pow(base, power);
     }
@@ -104,14 +104,13 @@ namespace Aerolite {
     }
 
     /**
-     * \brief Combines two 16-bit integers into a 32 bit integer.
+     * \brief Combines two 32-bit integers into a 64 bit integer.
      * \param x The first integer
      * \param y The second integer
-     * \return The two integers combined into a 32 bit integer
+     * \return The two integers combined into a 64 bit integer
      */
-	inline aero_uint32 ComputeIdPair(const aero_uint16 x, const aero_uint16 y) {
-        // https://stackoverflow.com/a/919631
-        return ((aero_int32)x << 16) | (aero_int32)y;
+	inline aero_uint64 ComputeIdPair(const aero_uint32 x, const aero_uint32 y) {
+        return (static_cast<aero_uint64>(x) << 32) | static_cast<aero_uint64>(y);
     }
 
 }
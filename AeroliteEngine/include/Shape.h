@@ -1,8 +1,11 @@
 #ifndef SHAPE_H
 #define SHAPE_H
 
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <span>
 #include "AeroVec2.h"
 #include "Precision.h"
 
@@ -17,13 +20,38 @@ namespace Aerolite {
         Polygon
     };
 
+    // Number of values of ShapeType.
+    constexpr aero_int32 SHAPE_TYPE_COUNT = 3;
+
+    // World space vertices and edge normals of a polygon, one array per coordinate so that a SIMD load reads
+    // the same coordinate of consecutive edges. Edge i goes from vertex i to vertex i + 1. Every array holds
+    // Stride(count) entries, the padding is zero. See AeroBody2D::GetPolygonLanes.
+    struct PolygonLanes {
+        static constexpr std::size_t PADDING = 4; // Arrays are padded to a multiple of this many entries.
+
+        const real* x = nullptr;
+        const real* y = nullptr;
+        const real* normal_x = nullptr;
+        const real* normal_y = nullptr;
+        std::size_t count = 0; // Number of vertices and edges.
+
+        static constexpr std::size_t Stride(const std::size_t count) { return (count + PADDING - 1) / PADDING * PADDING; }
+
+        AeroVec2 Vertex(const std::size_t i) const { return { x[i], y[i] }; }
+        AeroVec2 Normal(const std::size_t i) const { return { normal_x[i], normal_y[i] }; }
+        std::size_t Next(const std::size_t i) const { return i + 1 == count ? 0 : i + 1; }
+        // Vector from vertex i to the next vertex.
+        AeroVec2 Edge(const std::size_t i) const { return Vertex(Next(i)) - Vertex(i); }
+    };
+
     // Abstract base class for shapes. 
     // Defines the common interface for all concrete shape classes.
+    // A shape only holds local geometry and is never modified by the bodies using it, so any number
+    // of bodies can share one shape. Every body keeps the world space vertices of its own pose.
     struct Shape {
         virtual ~Shape() = default; // Virtual destructor for proper cleanup of derived classes.
         virtual ShapeType GetType() const = 0; // Pure virtual function to get the type of shape.
         virtual real GetMomentOfInertia() const = 0; // Pure virtual function to calculate the moment of inertia.
-        virtual void UpdateVertices(real angle, const AeroVec2& position) = 0; // Used to update the vertices of the shape.
     };
 
     // CircleShape class inheriting from Polygon.
@@ -34,26 +62,31 @@ namespace Aerolite {
             CircleShape(const real radius); // Constructor to initialize the circle with a radius.
             virtual ShapeType GetType() const override; // Override to return ShapeType::Circle.
             virtual real GetMomentOfInertia() const override; // Override to calculate moment of inertia for a circle.
-            virtual void UpdateVertices(real angle, const AeroVec2& position) override;
-
     };
 
         // PolygonShape class inheriting from Shape.
     struct PolygonShape : public Shape {
             std::vector<AeroVec2> localVertices;
-            std::vector<AeroVec2> worldVertices; 
+            std::vector<AeroVec2> localNormals; // Outward unit normal of every edge in local space, set by ComputeNormals.
 
             PolygonShape() = default; 
             PolygonShape(const std::vector<AeroVec2>& vertices);
             virtual ShapeType GetType() const override;
             virtual real GetMomentOfInertia() const override;        
-            virtual void UpdateVertices(const real angle, const AeroVec2& position) override;
-            AeroVec2 EdgeAt(int index) const;
-            AeroVec2 GeometricCenter(void) const;
-            int FindIncidentEdgeIndex(const AeroVec2& referenceEdge) const;
-            static int ClipLineSegmentToLine(const std::vector<AeroVec2>& contactsIn, std::vector<AeroVec2>& contactsOut, const AeroVec2& c0, const AeroVec2& c1);
+            // Writes the local vertices rotated by angle then moved by position, worldVertices holds one per local vertex.
+            void TransformVertices(real angle, const AeroVec2& position, std::span<AeroVec2> worldVertices) const;
+            // Computes the local normals from the local vertices, the constructors call it.
+            void ComputeNormals();
+            static AeroVec2 EdgeAt(std::span<const AeroVec2> vertices, int index);
+            // The functions below work on the world lanes of a body using the shape, see AeroBody2D::GetPolygonLanes.
+            static AeroVec2 GeometricCenter(const PolygonLanes& polygon);
+            // Finds the edge whose normal points the most against the reference edge normal.
+            static int FindIncidentEdgeIndex(const PolygonLanes& polygon, const AeroVec2& referenceEdgeNormal);
+            static int ClipLineSegmentToLine(const std::array<AeroVec2, 2>& contactsIn, std::array<AeroVec2, 2>& contactsOut, const AeroVec2& c0, const AeroVec2& c1);
             static std::shared_ptr<PolygonShape> CreateRegularPolygon(int sides, real sideLength);
-            real FindMinimumSeparation(const PolygonShape& other, int& indexReferenceEdge, AeroVec2& supportPoint) const;
+            // Finds the edge of polygon along whose normal the other vertices are the least behind it, several edges at a time.
+            // Stops at the first block of edges giving a positive separation, as the polygons cannot overlap then.
+            static real FindMinimumSeparation(const PolygonLanes& polygon, const PolygonLanes& other, int& indexReferenceEdge, AeroVec2& supportPoint);
     };
 
     // BoxShape class inheriting from Polygon.
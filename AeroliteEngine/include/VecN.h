@@ -2,12 +2,15 @@
 #define VECN_H
 
 #include <array>
+#include <cassert>
 #include <stdexcept>
 #include <cmath>
+#include "Precision.h"
 
 namespace Aerolite {
 
     // Template class for an N-dimensional vector.
+    // The components live inline in a std::array, so vectors never allocate and can be used in constant expressions.
     template<std::size_t N>
     class VecN {
     private:
@@ -15,34 +18,27 @@ namespace Aerolite {
 
     public:
         // Default constructor initializes all components to zero.
-        VecN() {
-            components.fill(0.0);  // Fill all elements with 0.0.
-        }
+        constexpr VecN() : components{} {}
 
         // Sets all components of the vector to zero.
-        void Zero(void) {
-            for (int i = 0; i < N; i++) {
-                components[i] = 0;
-            }
+        constexpr void Zero(void) {
+            components.fill(0);
         }
 
         // Const and non-const versions of the operator[] for element access.
-        real operator[](std::size_t index) const {
-            if (index >= N) {
-                throw std::out_of_range("Index out of range"); // Range check for safety.
-            }
+        // The index is only range checked in debug builds, this is used in the innermost solver loops.
+        constexpr real operator[](std::size_t index) const {
+            assert(index < N && "Index out of range");
             return components[index];
         }
 
-        real& operator[](std::size_t index) {
-            if (index >= N) {
-                throw std::out_of_range("Index out of range"); // Range check for safety.
-            }
+        constexpr real& operator[](std::size_t index) {
+            assert(index < N && "Index out of range");
             return components[index];
         }
 
         // Calculates and returns the dot product with another VecN.
-        real Dot(const VecN& other) const {
+        constexpr real Dot(const VecN& other) const {
             real sum = 0.0;
             for (std::size_t i = 0; i < N; ++i) {
                 sum += components[i] * other.components[i]; // Sum of products of corresponding components.
@@ -67,7 +63,7 @@ namespace Aerolite {
         }
 
         // Adds two vectors and returns the result.
-        VecN operator+(const VecN& other) const {
+        constexpr VecN operator+(const VecN& other) const {
             VecN result;
             for (std::size_t i = 0; i < N; ++i) {
                 result.components[i] = components[i] + other.components[i]; // Component-wise addition.
@@ -76,7 +72,7 @@ namespace Aerolite {
         }
 
         // Subtracts one vector from another and returns the result.
-        VecN operator-(const VecN& other) const {
+        constexpr VecN operator-(const VecN& other) const {
             VecN result;
             for (std::size_t i = 0; i < N; ++i) {
                 result.components[i] = components[i] - other.components[i]; // Component-wise subtraction.
@@ -85,7 +81,7 @@ namespace Aerolite {
         }
 
         // Multiplies the vector by a scalar and returns the result.
-        VecN operator*(real scalar) const {
+        constexpr VecN operator*(real scalar) const {
             VecN result;
             for (std::size_t i = 0; i < N; ++i) {
                 result.components[i] = components[i] * scalar; // Scalar multiplication.
@@ -94,7 +90,7 @@ namespace Aerolite {
         }
 
         // In-place addition of another vector.
-        VecN& operator+=(const VecN& other) {
+        constexpr VecN& operator+=(const VecN& other) {
             for (std::size_t i = 0; i < N; ++i) {
                 components[i] += other.components[i]; // Component-wise in-place addition.
             }
@@ -102,7 +98,7 @@ namespace Aerolite {
         }
 
         // In-place subtraction of another vector.
-        VecN& operator-=(const VecN& other) {
+        constexpr VecN& operator-=(const VecN& other) {
             for (std::size_t i = 0; i < N; ++i) {
                 components[i] -= other.components[i]; // Component-wise in-place subtraction.
             }
@@ -110,7 +106,7 @@ namespace Aerolite {
         }
 
         // In-place scalar multiplication.
-        VecN& operator*=(real scalar) {
+        constexpr VecN& operator*=(real scalar) {
             for (std::size_t i = 0; i < N; ++i) {
                 components[i] *= scalar; // Scalar multiplication for each component.
             }
@@ -0,0 +1,81 @@
+#include "AeroAABB2D.h"
+#include "AeroSimd.h"
+
+namespace Aerolite
+{
+	AeroAABB2D AeroAABB2D::FromPoints(const std::span<const AeroVec2> points)
+	{
+		if (points.empty())
+		{
+			return {};
+		}
+
+#ifdef AERO_SIMD_SSE2
+		// Both axes of a point are in one register, so a single min and max per point update the whole box.
+		__m128d min = Simd::Load(points[0]);
+		__m128d max = min;
+		for (std::size_t i = 1; i < points.size(); ++i)
+		{
+			const __m128d point = Simd::Load(points[i]);
+			min = _mm_min_pd(min, point);
+			max = _mm_max_pd(max, point);
+		}
+		return { Simd::Store(min), Simd::Store(max) };
+#else
+		AeroAABB2D aabb(points[0], points[0]);
+		for (std::size_t i = 1; i < points.size(); ++i)
+		{
+			aabb.Enclose(points[i]);
+		}
+		return aabb;
+#endif
+	}
+
+	AeroAABB2D AeroAABB2D::FromPoints(const std::span<const real> x, const std::span<const real> y)
+	{
+		if (x.empty())
+		{
+			return {};
+		}
+
+#ifdef AERO_SIMD_SSE2
+		// Each register holds one coordinate of two points, the lanes are only folded together at the end.
+		__m128d minX = _mm_set1_pd(x[0]);
+		__m128d maxX = minX;
+		__m128d minY = _mm_set1_pd(y[0]);
+		__m128d maxY = minY;
+		std::size_t i = 0;
+		for (; i + 2 <= x.size(); i += 2)
+		{
+			const __m128d px = _mm_loadu_pd(x.data() + i);
+			const __m128d py = _mm_loadu_pd(y.data() + i);
+			minX = _mm_min_pd(minX, px);
+			maxX = _mm_max_pd(maxX, px);
+			minY = _mm_min_pd(minY, py);
+			maxY = _mm_max_pd(maxY, py);
+		}
+		if (i < x.size())
+		{
+			const __m128d px = _mm_set1_pd(x[i]);
+			const __m128d py = _mm_set1_pd(y[i]);
+			minX = _mm_min_pd(minX, px);
+			maxX = _mm_max_pd(maxX, px);
+			minY = _mm_min_pd(minY, py);
+			maxY = _mm_max_pd(maxY, py);
+		}
+		// Low lanes of min and max, high lanes of min and max.
+		const __m128d lowMin = _mm_unpacklo_pd(minX, minY);
+		const __m128d highMin = _mm_unpackhi_pd(minX, minY);
+		const __m128d lowMax = _mm_unpacklo_pd(maxX, maxY);
+		const __m128d highMax = _mm_unpackhi_pd(maxX, maxY);
+		return { Simd::Store(_mm_min_pd(lowMin, highMin)), Simd::Store(_mm_max_pd(lowMax, highMax)) };
+#else
+		AeroAABB2D aabb(AeroVec2(x[0], y[0]), AeroVec2(x[0], y[0]));
+		for (std::size_t i = 1; i < x.size(); ++i)
+		{
+			aabb.Enclose(AeroVec2(x[i], y[i]));
+		}
+		return aabb;
+#endif
+	}
+}
@@ -1,20 +1,21 @@
 #include "AeroBody2D.h"
 #include "Precision.h"
 
-static Aerolite::aero_uint16 current_id = 0;
-
 namespace Aerolite {
 
     // Constructor for AeroBody2D.
-    // Takes a pointer to a Shape, position coordinates (x, y), and mass.
-    AeroBody2D::AeroBody2D(const std::shared_ptr<Shape>& shape, const real x, const real y, const real mass)
-	    : position({x, y}), mass(mass), shape(shape)
+    // Takes the state arrays and row of the body, a pointer to a Shape, position coordinates (x, y), and mass.
+    AeroBody2D::AeroBody2D(AeroBodyStates2D& states, const aero_uint32 stateIndex, const std::shared_ptr<const Shape>& shape, const real x, const real y, const real mass)
+	    : states(&states), state_index(stateIndex), mass(mass), shape(shape)
     {
-        this->id = current_id++;
-        this->linear_velocity = AeroVec2(0.0f, 0.0f);
+        this->id = AeroBodyHandle2D::INVALID_INDEX;
+        SetPosition(AeroVec2(x, y));
+        SetLinearVelocity(AeroVec2(0.0f, 0.0f));
         this->linear_acceleration = AeroVec2(0.0f, 0.0f);
-        this->rotation = 0.0f;
-        this->angular_velocity = 0.0f;
+        SetRotation(0.0f);
+        this->previous_position = GetPosition();
+        this->previous_rotation = 0.0f;
+        SetAngularVelocity(0.0f);
         this->angular_acceleration = 0.0f;
         this->linear_damping = 0.002;
         this->angular_damping = 0.002;
@@ -22,127 +23,167 @@ namespace Aerolite {
         this->sum_torque = 0.0f;
         this->restitution = 0.5;
         this->friction = make_real<real>(0.7);
-        this->is_sleeping = false;
+        states.flags[stateIndex] = AreEqual(mass, 0.0, EPSILON) ? AeroBodyStates2D::STATIC : 0;
         this->sleep_timer = 0;
+        this->island_index = -1;
+        this->bvh_proxy = -1;
+        this->sap_proxy = -1;
 
         if(mass != 0.0) {
-            this-> inv_mass = make_real<real>(1.0) / mass;
+            states.inv_masses[stateIndex] = make_real<real>(1.0) / mass;
         } else {
-            this->inv_mass = 0.0;
+            states.inv_masses[stateIndex] = 0.0;
         }
 
         this->inertia = shape->GetMomentOfInertia() * this->mass;
 
         if(inertia != 0.0) {
-            this-> inv_inertia = make_real<real>(1.0) / inertia;
+            states.inv_inertias[stateIndex] = make_real<real>(1.0) / inertia;
         } else {
-            inv_inertia = 0.0;
+            states.inv_inertias[stateIndex] = 0.0;
+        }
+
+        if (shape->GetType() == Box || shape->GetType() == Polygon) {
+            const std::size_t count = static_cast<const PolygonShape&>(*shape).localVertices.size();
+            world_lanes.assign(4 * PolygonLanes::Stride(count), 0);
         }
+        UpdateWorldVertices();
+    }
+
+    AeroVec2 AeroBody2D::GetInterpolatedPosition(const real alpha) const
+    {
+        return previous_position + (GetPosition() - previous_position) * alpha;
+    }
 
-        shape->UpdateVertices(rotation, position);
+    real AeroBody2D::GetInterpolatedRotation(const real alpha) const
+    {
+        return previous_rotation + (GetRotation() - previous_rotation) * alpha;
     }
 
     AeroAABB2D AeroBody2D::GetAABB() const
     {
-        AeroAABB2D aabb;
+        // The type tells the shape apart, there is no need for a dynamic cast.
         if (shape->GetType() == Circle)
         {
-	        const auto circleShape = std::dynamic_pointer_cast<CircleShape>(shape);
-	        const real radius = circleShape->radius;
-            aabb.min = position - AeroVec2(radius, radius);
-            aabb.max = position + AeroVec2(radius, radius);
-
+            const real radius = static_cast<const CircleShape&>(*shape).radius;
+            const AeroVec2 position = GetPosition();
+            return { position - AeroVec2(radius, radius), position + AeroVec2(radius, radius) };
         }
-        else if (shape->GetType() == Box || shape->GetType() == Polygon)
+        if (shape->GetType() == Box || shape->GetType() == Polygon)
         {
-	        const auto polygon = std::dynamic_pointer_cast<PolygonShape>(shape);
-            aabb.min = AeroVec2(std::numeric_limits<real>::max(), std::numeric_limits<real>::max());
-            aabb.max = AeroVec2(std::numeric_limits<real>::lowest(), std::numeric_limits<real>::lowest());
-
-            for (const auto& vertex : polygon->worldVertices)
-            {
-                aabb.min.x = std::min(aabb.min.x, vertex.x);
-                aabb.min.y = std::min(aabb.min.y, vertex.y);
-                aabb.max.x = std::max(aabb.max.x, vertex.x);
-                aabb.max.y = std::max(aabb.max.y, vertex.y);
-            }
+            const PolygonLanes lanes = GetPolygonLanes();
+            return AeroAABB2D::FromPoints({ lanes.x, lanes.count }, { lanes.y, lanes.count });
         }
+        return {};
+    }
+
+    PolygonLanes AeroBody2D::GetPolygonLanes() const
+    {
+        if (world_lanes.empty()) return {};
 
-        return aabb;
+        const std::size_t count = static_cast<const PolygonShape&>(*shape).localVertices.size();
+        const std::size_t stride = PolygonLanes::Stride(count);
+        const real* lanes = world_lanes.data();
+        return { lanes, lanes + stride, lanes + 2 * stride, lanes + 3 * stride, count };
     }
 
-    void AeroBody2D::IntegrateForces(const real dt)
+    void AeroBody2D::UpdateWorldVertices()
     {
-        if (IsStatic()) return;
+        if (world_lanes.empty()) return;
+
+        // Vertices are rotated then moved, normals only turn with the body. The padding past the last vertex stays zero.
+        const auto& polygon = static_cast<const PolygonShape&>(*shape);
+        const std::size_t count = polygon.localVertices.size();
+        const std::size_t stride = PolygonLanes::Stride(count);
+        real* x = world_lanes.data();
+        real* y = x + stride;
+        real* normalX = y + stride;
+        real* normalY = normalX + stride;
+        const AeroVec2 position = GetPosition();
+        const real rotation = GetRotation();
+        const real cos = std::cos(rotation);
+        const real sin = std::sin(rotation);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const AeroVec2& vertex = polygon.localVertices[i];
+            const AeroVec2& normal = polygon.localNormals[i];
+            x[i] = vertex.x * cos - vertex.y * sin + position.x;
+            y[i] = vertex.x * sin + vertex.y * cos + position.y;
+            normalX[i] = normal.x * cos - normal.y * sin;
+            normalY[i] = normal.x * sin + normal.y * cos;
+        }
+    }
+
+    void AeroBody2D::IntegrateForces(const real dt, const real stepFraction)
+    {
+        if (IsStatic() || IsSleeping()) return;
 
         // Find the linear_acceleration based on the forces that are being applied this frame.
-        linear_acceleration = sum_forces * inv_mass;
+        linear_acceleration = sum_forces * GetInvMass();
 
         // Integrate the linear_acceleration to find the new linear_velocity.
+        AeroVec2& linear_velocity = states->linear_velocities[state_index];
         linear_velocity += linear_acceleration * dt;
-        linear_velocity *= RealPow(0.98f, linear_damping);
+        linear_velocity *= RealPow(0.98f, linear_damping * stepFraction);
 
         // Integrate the torques to find the new angular linear_acceleration.
-        angular_acceleration = sum_torque * inv_inertia;
+        angular_acceleration = sum_torque * GetInvInertia();
 
         // Integrate the angular linear_acceleration to find the new angular linear_velocity.
+        real& angular_velocity = states->angular_velocities[state_index];
         angular_velocity += angular_acceleration * dt;
-        angular_velocity *= RealPow(0.98f, angular_damping);
-
-        // Clear all forces and torque acting on the body before the next physics simulation frame.
-        ClearForces();
-        ClearTorque();
+        angular_velocity *= RealPow(0.98f, angular_damping * stepFraction);
     }
 
     void AeroBody2D::IntegrateVelocities(const real dt)
     {
-        if (IsStatic()) return;
+        if (IsStatic() || IsSleeping()) return;
 
         // Integrate the linear_velocity to find the new position.
-        position += linear_velocity * dt + (linear_acceleration * dt * dt) / 2.0f;
+        states->positions[state_index] += GetLinearVelocity() * dt + (linear_acceleration * dt * dt) / 2.0f;
 
         // Integrate the angular linear_velocity to find the new rotation angle.
-        rotation += angular_velocity * dt;
+        states->rotations[state_index] += GetAngularVelocity() * dt;
 
-        // Update the vertices of the shape based on the position/rotation.
-        shape->UpdateVertices(rotation, position);
-    }
-
-    bool AeroBody2D::IsStatic(void) const
-    {
-        return AreEqual(mass, 0.0, EPSILON);
+        // Update the world vertices based on the position/rotation.
+        UpdateWorldVertices();
     }
 
     // Method to add a force vector to the body.
     void AeroBody2D::AddForce(const AeroVec2 &force)
     {
+        if (IsSleeping()) Awake();
         sum_forces += force;
     }
 
     // Method to add a torque to the body.
     void AeroBody2D::AddTorque(const real torque)
     {
+        if (IsSleeping()) Awake();
         sum_torque += torque;
     }
 
     void AeroBody2D::ApplyImpulseLinear(const AeroVec2& j)
     {
         if (IsStatic()) return;
-        linear_velocity += j * inv_mass;
+        if (IsSleeping()) Awake();
+        states->linear_velocities[state_index] += j * GetInvMass();
     }
 
     void AeroBody2D::ApplyImpulseAngular(const real j)
     {
         if (IsStatic()) return;
-        angular_velocity += j * inv_inertia;
+        if (IsSleeping()) Awake();
+        states->angular_velocities[state_index] += j * GetInvInertia();
     }
 
     void AeroBody2D::ApplyImpulseAtPoint(const AeroVec2& j, const AeroVec2& r)
     {
         if (IsStatic()) return;
+        if (IsSleeping()) Awake();
 
-        linear_velocity += j * inv_mass;
-        angular_velocity += r.Cross(j) * inv_inertia;
+        states->linear_velocities[state_index] += j * GetInvMass();
+        states->angular_velocities[state_index] += r.Cross(j) * GetInvInertia();
     }
 
     void AeroBody2D::SetFriction(const real f)
@@ -159,9 +200,9 @@ namespace Aerolite {
     {
         if(!IsStatic())
         {
-            is_sleeping = true;
-            linear_velocity = { 0, 0 };
-            angular_velocity = 0;
+            states->flags[state_index] |= AeroBodyStates2D::SLEEPING;
+            SetLinearVelocity({ 0, 0 });
+            SetAngularVelocity(0);
             ClearForces();
             ClearTorque();
         }
@@ -169,7 +210,7 @@ namespace Aerolite {
 
     void AeroBody2D::Awake()
     {
-        is_sleeping = false;
+        states->flags[state_index] &= ~AeroBodyStates2D::SLEEPING;
         sleep_timer = 0;
     }
 
@@ -187,12 +228,14 @@ namespace Aerolite {
 
     AeroVec2 AeroBody2D::LocalSpaceToWorldSpace(const AeroVec2& point) const
     {
-        const AeroVec2 rotated = point.Rotate(rotation);
-        return rotated + position;
+        const AeroVec2 rotated = point.Rotate(GetRotation());
+        return rotated + GetPosition();
     }
 
     AeroVec2 AeroBody2D::WorldSpaceToLocalSpace(const AeroVec2& point) const
     {
+        const AeroVec2 position = GetPosition();
+        const real rotation = GetRotation();
         const real translatedX = point.x - position.x;
         const real translatedY = point.y - position.y;
         const real rotatedX = cos(-rotation) * translatedX - sin(-rotation) * translatedY;
@@ -0,0 +1,158 @@
+#include "AeroBodyPool2D.h"
+
+namespace Aerolite
+{
+	void AeroBodyPool2D::Clear()
+	{
+		// Bump the generation of every slot instead of dropping them, so old handles stay stale.
+		for (aero_uint32 i = 0; i < m_slotCount; ++i)
+		{
+			Slot& slot = GetSlot(i);
+			if (slot.dense != NOT_LIVE)
+			{
+				++slot.generation;
+				slot.dense = NOT_LIVE;
+			}
+			slot.body.reset();
+		}
+
+		m_freeSlots.clear();
+		for (aero_uint32 i = m_slotCount; i > 0; --i)
+		{
+			m_freeSlots.push_back(i - 1);
+		}
+		m_dense.clear();
+		m_denseSlots.clear();
+		m_states.positions.clear();
+		m_states.rotations.clear();
+		m_states.linear_velocities.clear();
+		m_states.angular_velocities.clear();
+		m_states.inv_masses.clear();
+		m_states.inv_inertias.clear();
+		m_states.flags.clear();
+	}
+
+	AeroBody2D* AeroBodyPool2D::Create(const std::shared_ptr<const Shape>& shape, const real x, const real y, const real mass)
+	{
+		aero_uint32 index;
+		if (!m_freeSlots.empty())
+		{
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else
+		{
+			if (m_slotCount == m_blocks.size() * BLOCK_SIZE)
+			{
+				m_blocks.push_back(std::make_unique<Slot[]>(BLOCK_SIZE));
+			}
+			index = m_slotCount++;
+		}
+
+		Slot& slot = GetSlot(index);
+		slot.dense = static_cast<aero_uint32>(m_dense.size());
+		AppendState();
+		AeroBody2D& body = slot.body.emplace(m_states, slot.dense, shape, x, y, mass);
+		body.id = index;
+		body.handle = { index, slot.generation };
+		m_dense.push_back(&body);
+		m_denseSlots.push_back(index);
+		return &body;
+	}
+
+	bool AeroBodyPool2D::Destroy(const AeroBodyHandle2D handle)
+	{
+		if (!IsValid(handle)) return false;
+
+		// Swap and pop: the last live body takes the place of the removed one.
+		Slot& slot = GetSlot(handle.index);
+		const aero_uint32 dense = slot.dense;
+		const auto last = static_cast<aero_uint32>(m_dense.size()) - 1;
+		m_dense[dense] = m_dense[last];
+		m_denseSlots[dense] = m_denseSlots[last];
+		GetSlot(m_denseSlots[dense]).dense = dense;
+		MoveState(last, dense);
+		m_dense[dense]->state_index = dense;
+		m_dense.pop_back();
+		m_denseSlots.pop_back();
+		PopState();
+
+		// The body itself is kept until the slot is reused, so contacts of the last step can still be read.
+		slot.dense = NOT_LIVE;
+		++slot.generation;
+		m_freeSlots.push_back(handle.index);
+		return true;
+	}
+
+	AeroBody2D* AeroBodyPool2D::Get(const AeroBodyHandle2D handle) const
+	{
+		return IsValid(handle) ? &*GetSlot(handle.index).body : nullptr;
+	}
+
+	bool AeroBodyPool2D::IsValid(const AeroBodyHandle2D handle) const
+	{
+		if (handle.index >= m_slotCount) return false;
+
+		const Slot& slot = GetSlot(handle.index);
+		return slot.dense != NOT_LIVE && slot.generation == handle.generation;
+	}
+
+	std::span<AeroBody2D* const> AeroBodyPool2D::GetBodies() const
+	{
+		return m_dense;
+	}
+
+	std::size_t AeroBodyPool2D::GetSize() const
+	{
+		return m_dense.size();
+	}
+
+	AeroBodyStates2D& AeroBodyPool2D::GetStates()
+	{
+		return m_states;
+	}
+
+	const AeroBodyStates2D& AeroBodyPool2D::GetStates() const
+	{
+		return m_states;
+	}
+
+	AeroBodyPool2D::Slot& AeroBodyPool2D::GetSlot(const aero_uint32 index) const
+	{
+		return m_blocks[index / BLOCK_SIZE][index % BLOCK_SIZE];
+	}
+
+	void AeroBodyPool2D::AppendState()
+	{
+		// The body constructor fills the row in.
+		m_states.positions.emplace_back();
+		m_states.rotations.emplace_back();
+		m_states.linear_velocities.emplace_back();
+		m_states.angular_velocities.emplace_back();
+		m_states.inv_masses.emplace_back();
+		m_states.inv_inertias.emplace_back();
+		m_states.flags.emplace_back();
+	}
+
+	void AeroBodyPool2D::MoveState(const aero_uint32 from, const aero_uint32 to)
+	{
+		m_states.positions[to] = m_states.positions[from];
+		m_states.rotations[to] = m_states.rotations[from];
+		m_states.linear_velocities[to] = m_states.linear_velocities[from];
+		m_states.angular_velocities[to] = m_states.angular_velocities[from];
+		m_states.inv_masses[to] = m_states.inv_masses[from];
+		m_states.inv_inertias[to] = m_states.inv_inertias[from];
+		m_states.flags[to] = m_states.flags[from];
+	}
+
+	void AeroBodyPool2D::PopState()
+	{
+		m_states.positions.pop_back();
+		m_states.rotations.pop_back();
+		m_states.linear_velocities.pop_back();
+		m_states.angular_velocities.pop_back();
+		m_states.inv_masses.pop_back();
+		m_states.inv_inertias.pop_back();
+		m_states.flags.pop_back();
+	}
+}
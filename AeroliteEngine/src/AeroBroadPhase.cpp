@@ -32,6 +32,9 @@ namespace Aerolite
 		case BroadPhaseAlg::BVH:
 			m_algorithmFunction = [this](AeroWorld2D& world) { Bvh(world); };
 			break;
+		case BroadPhaseAlg::SAP:
+			m_algorithmFunction = [this](AeroWorld2D& world) { Sap(world); };
+			break;
 			// Add parallel versions if needed
 		default:
 			throw std::invalid_argument("Unsupported broad-phase algorithm.");
@@ -50,11 +53,11 @@ namespace Aerolite
 #endif
 
 		// Both bodies are asleep.
-		if (a.is_sleeping && b.is_sleeping) return true;
+		if (a.IsSleeping() && b.IsSleeping()) return true;
 
 		// One body is asleep, and the other is static.
-		if ((a.is_sleeping && b.IsStatic()) ||
-			b.is_sleeping && a.IsStatic()) return true;
+		if ((a.IsSleeping() && b.IsStatic()) ||
+			b.IsSleeping() && a.IsStatic()) return true;
 
 		return false;
 	}
@@ -63,17 +66,18 @@ namespace Aerolite
 	{
 		world.ClearBroadPhasePairs();
 
-		for(size_t i = 0; i < world.GetBodies().size(); i++)
+		const auto bodies = world.GetBodies();
+		const auto aabbs = world.GetBodyAABBs();
+		for(size_t i = 0; i < bodies.size(); i++)
 		{
-			const std::shared_ptr<AeroBody2D>& bodyA = world.GetBodies()[i];
-			auto aBox = bodyA->GetAABB();
-			for(size_t j = 0; j < world.GetBodies().size(); j++)
+			AeroBody2D* bodyA = bodies[i];
+			const AeroAABB2D& aBox = aabbs[i];
+			for(size_t j = 0; j < bodies.size(); j++)
 			{
-				const std::shared_ptr<AeroBody2D>& bodyB = world.GetBodies()[j];
+				AeroBody2D* bodyB = bodies[j];
 				if (EarlyOut(world, *bodyA, *bodyB)) continue;
 
-				const auto bBox = bodyB->GetAABB();
-				if (aBox.Intersects(bBox))
+				if (aBox.Intersects(aabbs[j]))
 				{
 					BroadPhasePair pair = { bodyA, bodyB, ComputeIdPair(bodyA->id, bodyB->id)};
 					world.AddBroadPhasePair(pair);
@@ -85,31 +89,36 @@ namespace Aerolite
 	void AeroBroadPhase::Shg(AeroWorld2D& world)
 	{
 		world.ClearBroadPhasePairs();
-		std::vector<std::shared_ptr<AeroBody2D>> bodies = world.GetBodies();
+		const auto bodies = world.GetBodies();
+		const auto aabbs = world.GetBodyAABBs();
 
-		auto shg = world.GetShg();
-		shg.ClearCellContentCache();
-		shg.Place(bodies); 
+		AeroShg& shg = world.GetShg();
+		shg.Place(aabbs);
 
-		for(auto& a : bodies)
+		for (size_t i = 0; i < bodies.size(); i++)
 		{
-			auto aBox = a->GetAABB();
+			AeroBody2D* a = bodies[i];
+			const AeroAABB2D& aBox = aabbs[i];
 			auto [minX, minY, maxX, maxY] = shg.ComputeCellRange(aBox);
 
-			for(int y = minY; y <= maxY; ++y)
+			for (int y = minY; y <= maxY; ++y)
 			{
-				for(int x = minX; x <= maxX; ++x)
+				for (int x = minX; x <= maxX; ++x)
 				{
-					auto cellBodies = shg.GetCellContent(x, y);
-
-					for(const auto& b : cellBodies)
+					for (const aero_int32 j : shg.GetCellContent(x, y))
 					{
+						AeroBody2D* b = bodies[j];
 						if (EarlyOut(world, *a, *b)) continue;
-						if (a == b) continue; // skip the same body
-						const auto bBox = b->GetAABB();
-						if (aBox.Intersects(bBox)) {
-							world.AddBroadPhasePair({ a, b, ComputeIdPair(a->id, b->id) });
-						}
+
+						const AeroAABB2D& bBox = aabbs[j];
+						if (!aBox.Intersects(bBox)) continue;
+
+						// Bodies sharing several cells are only paired in the cell holding the minimum corner of their overlap.
+						const AeroVec2 overlapMin(std::max(aBox.min.x, bBox.min.x), std::max(aBox.min.y, bBox.min.y));
+						auto [ownerX, ownerY, ownerMaxX, ownerMaxY] = shg.ComputeCellRange(AeroAABB2D(overlapMin, overlapMin));
+						if (ownerX != x || ownerY != y) continue;
+
+						world.AddBroadPhasePair({ a, b, ComputeIdPair(a->id, b->id) });
 					}
 				}
 			}
@@ -118,5 +127,80 @@ namespace Aerolite
 
 	void AeroBroadPhase::Bvh(AeroWorld2D& world)
 	{
+		world.ClearBroadPhasePairs();
+		const auto bodies = world.GetBodies();
+		const auto aabbs = world.GetBodyAABBs();
+		AeroBvh& bvh = world.GetBvh();
+
+		// Synchronize the persistent proxies with the bodies. Only bodies that left their fat AABB are re-inserted,
+		// sleeping bodies cannot move. Removing a body moves another one into its index, so the user data is always refreshed.
+		for (size_t i = 0; i < bodies.size(); i++)
+		{
+			AeroBody2D& body = *bodies[i];
+			const auto userData = static_cast<aero_int32>(i);
+			if (!bvh.IsProxyValid(body.bvh_proxy))
+			{
+				body.bvh_proxy = bvh.CreateProxy(aabbs[i], userData);
+				continue;
+			}
+
+			bvh.SetUserData(body.bvh_proxy, userData);
+			if (!body.IsSleeping())
+			{
+				bvh.MoveProxy(body.bvh_proxy, aabbs[i], body.GetLinearVelocity());
+			}
+		}
+		bvh.EndUpdate();
+
+		bvh.ForEachPair([&](const aero_int32 proxyA, const aero_int32 proxyB)
+		{
+			AeroBody2D* a = bodies[bvh.GetUserData(proxyA)];
+			AeroBody2D* b = bodies[bvh.GetUserData(proxyB)];
+			if (a->id > b->id) std::swap(a, b);
+
+			if (EarlyOut(world, *a, *b)) return;
+			if (bvh.GetTightAABB(proxyA).Intersects(bvh.GetTightAABB(proxyB)))
+			{
+				world.AddBroadPhasePair({ a, b, ComputeIdPair(a->id, b->id) });
+			}
+		});
+	}
+
+	void AeroBroadPhase::Sap(AeroWorld2D& world)
+	{
+		world.ClearBroadPhasePairs();
+		const auto bodies = world.GetBodies();
+		const auto aabbs = world.GetBodyAABBs();
+		AeroSap& sap = world.GetSap();
+
+		// Synchronize the persistent proxies with the bodies, sleeping bodies cannot move so their proxies are left alone.
+		for (size_t i = 0; i < bodies.size(); i++)
+		{
+			AeroBody2D& body = *bodies[i];
+			const auto userData = static_cast<aero_int32>(i);
+			if (!sap.IsProxyValid(body.sap_proxy))
+			{
+				body.sap_proxy = sap.CreateProxy(aabbs[i], userData);
+				continue;
+			}
+
+			sap.SetUserData(body.sap_proxy, userData);
+			if (!body.IsSleeping())
+			{
+				sap.MoveProxy(body.sap_proxy, aabbs[i]);
+			}
+		}
+		sap.EndUpdate();
+
+		// The pair set only holds proxies whose AABBs overlap, so there is nothing left to test.
+		sap.ForEachPair([&](const aero_int32 proxyA, const aero_int32 proxyB)
+		{
+			AeroBody2D* a = bodies[sap.GetUserData(proxyA)];
+			AeroBody2D* b = bodies[sap.GetUserData(proxyB)];
+			if (a->id > b->id) std::swap(a, b);
+
+			if (EarlyOut(world, *a, *b)) return;
+			world.AddBroadPhasePair({ a, b, ComputeIdPair(a->id, b->id) });
+		});
 	}
 }
@@ -0,0 +1,528 @@
+#include <algorithm>
+#include <cassert>
+#include "AeroBvh.h"
+
+namespace Aerolite
+{
+	AeroBvh::AeroBvh()
+	{
+		m_root = NullNode;
+		m_freeList = NullNode;
+		m_proxyCount = 0;
+		m_fatMargin = 5;
+		m_predictionTime = make_real<real>(0.05);
+	}
+
+	void AeroBvh::Clear()
+	{
+		m_nodes.clear();
+		m_links.clear();
+		m_moveBuffer.clear();
+		m_pairs.clear();
+		m_root = NullNode;
+		m_freeList = NullNode;
+		m_proxyCount = 0;
+	}
+
+	real AeroBvh::GetFatMargin() const
+	{
+		return m_fatMargin;
+	}
+
+	real AeroBvh::GetPredictionTime() const
+	{
+		return m_predictionTime;
+	}
+
+	void AeroBvh::SetFatMargin(const real margin)
+	{
+		m_fatMargin = std::max(margin, make_real<real>(0.0));
+	}
+
+	void AeroBvh::SetPredictionTime(const real seconds)
+	{
+		m_predictionTime = std::max(seconds, make_real<real>(0.0));
+	}
+
+	aero_int32 AeroBvh::CreateProxy(const AeroAABB2D& aabb, const aero_int32 userData)
+	{
+		const aero_int32 proxyId = AllocateNode();
+		Node& node = m_nodes[proxyId];
+		FatAABB(aabb, AeroVec2(0, 0), node.aabb);
+		node.tight = aabb;
+		node.height = 0;
+		node.userData = userData;
+		node.moved = true;
+		// Room for the usual number of neighbours, so the links rarely grow while the world is running.
+		m_links[proxyId].reserve(8);
+
+		InsertLeaf(proxyId);
+		m_moveBuffer.push_back(proxyId);
+		++m_proxyCount;
+		return proxyId;
+	}
+
+	void AeroBvh::DestroyProxy(const aero_int32 proxyId)
+	{
+		assert(IsProxyValid(proxyId));
+		while (!m_links[proxyId].empty())
+		{
+			RemovePair(m_links[proxyId].back().pair);
+		}
+
+		RemoveLeaf(proxyId);
+		FreeNode(proxyId);
+		--m_proxyCount;
+	}
+
+	bool AeroBvh::MoveProxy(const aero_int32 proxyId, const AeroAABB2D& aabb, const AeroVec2& velocity)
+	{
+		assert(IsProxyValid(proxyId));
+		Node& node = m_nodes[proxyId];
+		node.tight = aabb;
+
+		if (node.aabb.Contains(aabb))
+		{
+			// Still inside the fat AABB, unless the fat AABB has become far too large
+			// compared to the body (e.g. after the body slowed down), keep the leaf where it is.
+			AeroAABB2D hugeAabb;
+			FatAABB(aabb, velocity * 4, hugeAabb);
+			hugeAabb.Expand(AeroVec2(m_fatMargin, m_fatMargin) * 3);
+			if (hugeAabb.Contains(node.aabb))
+			{
+				return false;
+			}
+		}
+
+		RemoveLeaf(proxyId);
+		FatAABB(aabb, velocity, m_nodes[proxyId].aabb);
+		InsertLeaf(proxyId);
+
+		if (!m_nodes[proxyId].moved)
+		{
+			m_nodes[proxyId].moved = true;
+			m_moveBuffer.push_back(proxyId);
+		}
+
+		return true;
+	}
+
+	bool AeroBvh::IsProxyValid(const aero_int32 proxyId) const
+	{
+		return proxyId >= 0 && proxyId < static_cast<aero_int32>(m_nodes.size()) &&
+			m_nodes[proxyId].height == 0;
+	}
+
+	const AeroAABB2D& AeroBvh::GetFatAABB(const aero_int32 proxyId) const
+	{
+		assert(IsProxyValid(proxyId));
+		return m_nodes[proxyId].aabb;
+	}
+
+	const AeroAABB2D& AeroBvh::GetTightAABB(const aero_int32 proxyId) const
+	{
+		assert(IsProxyValid(proxyId));
+		return m_nodes[proxyId].tight;
+	}
+
+	aero_int32 AeroBvh::GetUserData(const aero_int32 proxyId) const
+	{
+		assert(IsProxyValid(proxyId));
+		return m_nodes[proxyId].userData;
+	}
+
+	void AeroBvh::SetUserData(const aero_int32 proxyId, const aero_int32 userData)
+	{
+		assert(IsProxyValid(proxyId));
+		m_nodes[proxyId].userData = userData;
+	}
+
+	void AeroBvh::EndUpdate()
+	{
+		// Fat AABBs only change when a proxy is inserted or re-inserted, so only those pairs can start or stop overlapping.
+		for (const aero_int32 queryProxy : m_moveBuffer)
+		{
+			if (!IsProxyValid(queryProxy)) continue;
+			m_nodes[queryProxy].moved = false;
+
+			// Walk backwards, removing a pair moves the last link, which was already checked, into its place.
+			const AeroAABB2D& fatAabb = m_nodes[queryProxy].aabb;
+			const std::vector<PairLink>& links = m_links[queryProxy];
+			for (std::size_t i = links.size(); i-- > 0;)
+			{
+				if (!fatAabb.Intersects(m_nodes[links[i].partner].aabb))
+				{
+					RemovePair(links[i].pair);
+				}
+			}
+
+			Query(fatAabb, [this, queryProxy](const aero_int32 proxyId)
+			{
+				if (proxyId != queryProxy)
+				{
+					AddPair(queryProxy, proxyId);
+				}
+				return true;
+			});
+		}
+
+		m_moveBuffer.clear();
+	}
+
+	aero_int32 AeroBvh::GetHeight() const
+	{
+		return m_root == NullNode ? 0 : m_nodes[m_root].height;
+	}
+
+	aero_int32 AeroBvh::GetProxyCount() const
+	{
+		return m_proxyCount;
+	}
+
+	std::size_t AeroBvh::GetPairCount() const
+	{
+		return m_pairs.size();
+	}
+
+	aero_int32 AeroBvh::AllocateNode()
+	{
+		if (m_freeList == NullNode)
+		{
+			m_nodes.emplace_back();
+			m_links.emplace_back();
+			return static_cast<aero_int32>(m_nodes.size()) - 1;
+		}
+
+		const aero_int32 nodeId = m_freeList;
+		m_freeList = m_nodes[nodeId].parent;
+		m_nodes[nodeId] = Node();
+		return nodeId;
+	}
+
+	void AeroBvh::FreeNode(const aero_int32 nodeId)
+	{
+		Node& node = m_nodes[nodeId];
+		node.parent = m_freeList;
+		node.child1 = NullNode;
+		node.child2 = NullNode;
+		node.height = -1;
+		node.moved = false;
+		m_freeList = nodeId;
+	}
+
+	void AeroBvh::InsertLeaf(const aero_int32 leaf)
+	{
+		if (m_root == NullNode)
+		{
+			m_root = leaf;
+			m_nodes[m_root].parent = NullNode;
+			return;
+		}
+
+		// Find the best sibling for the leaf using the surface area (perimeter) heuristic.
+		const AeroAABB2D leafAabb = m_nodes[leaf].aabb;
+		aero_int32 index = m_root;
+		while (!m_nodes[index].IsLeaf())
+		{
+			const aero_int32 child1 = m_nodes[index].child1;
+			const aero_int32 child2 = m_nodes[index].child2;
+
+			const real area = m_nodes[index].aabb.Perimeter();
+			const real combinedArea = AeroAABB2D::Combine(m_nodes[index].aabb, leafAabb).Perimeter();
+
+			// Cost of creating a new parent for this node and the new leaf.
+			const real cost = 2 * combinedArea;
+			// Minimum cost of pushing the leaf further down the tree.
+			const real inheritanceCost = 2 * (combinedArea - area);
+
+			auto descendCost = [&](const aero_int32 child)
+			{
+				const AeroAABB2D aabb = AeroAABB2D::Combine(leafAabb, m_nodes[child].aabb);
+				if (m_nodes[child].IsLeaf())
+				{
+					return aabb.Perimeter() + inheritanceCost;
+				}
+				return aabb.Perimeter() - m_nodes[child].aabb.Perimeter() + inheritanceCost;
+			};
+
+			const real cost1 = descendCost(child1);
+			const real cost2 = descendCost(child2);
+
+			if (cost < cost1 && cost < cost2) break;
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		const aero_int32 sibling = index;
+
+		// Create a new parent for the sibling and the leaf.
+		const aero_int32 oldParent = m_nodes[sibling].parent;
+		const aero_int32 newParent = AllocateNode();
+		m_nodes[newParent].parent = oldParent;
+		m_nodes[newParent].aabb = AeroAABB2D::Combine(leafAabb, m_nodes[sibling].aabb);
+		m_nodes[newParent].height = m_nodes[sibling].height + 1;
+		m_nodes[newParent].child1 = sibling;
+		m_nodes[newParent].child2 = leaf;
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		if (oldParent != NullNode)
+		{
+			if (m_nodes[oldParent].child1 == sibling)
+				m_nodes[oldParent].child1 = newParent;
+			else
+				m_nodes[oldParent].child2 = newParent;
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		// Walk back up the tree fixing heights and AABBs.
+		index = m_nodes[leaf].parent;
+		while (index != NullNode)
+		{
+			index = Balance(index);
+
+			const aero_int32 child1 = m_nodes[index].child1;
+			const aero_int32 child2 = m_nodes[index].child2;
+			m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+			m_nodes[index].aabb = AeroAABB2D::Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+
+			index = m_nodes[index].parent;
+		}
+	}
+
+	void AeroBvh::RemoveLeaf(const aero_int32 leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NullNode;
+			return;
+		}
+
+		const aero_int32 parent = m_nodes[leaf].parent;
+		const aero_int32 grandParent = m_nodes[parent].parent;
+		const aero_int32 sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+		if (grandParent != NullNode)
+		{
+			// Destroy the parent and connect the sibling to the grand parent.
+			if (m_nodes[grandParent].child1 == parent)
+				m_nodes[grandParent].child1 = sibling;
+			else
+				m_nodes[grandParent].child2 = sibling;
+			m_nodes[sibling].parent = grandParent;
+			FreeNode(parent);
+
+			// Adjust ancestor bounds.
+			aero_int32 index = grandParent;
+			while (index != NullNode)
+			{
+				index = Balance(index);
+
+				const aero_int32 child1 = m_nodes[index].child1;
+				const aero_int32 child2 = m_nodes[index].child2;
+				m_nodes[index].aabb = AeroAABB2D::Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+				m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+
+				index = m_nodes[index].parent;
+			}
+		}
+		else
+		{
+			m_root = sibling;
+			m_nodes[sibling].parent = NullNode;
+			FreeNode(parent);
+		}
+
+		m_nodes[leaf].parent = NullNode;
+	}
+
+	// Performs a left or right rotation if node A is imbalanced. Returns the new root of the sub tree.
+	aero_int32 AeroBvh::Balance(const aero_int32 iA)
+	{
+		Node& A = m_nodes[iA];
+		if (A.IsLeaf() || A.height < 2)
+		{
+			return iA;
+		}
+
+		const aero_int32 iB = A.child1;
+		const aero_int32 iC = A.child2;
+		Node& B = m_nodes[iB];
+		Node& C = m_nodes[iC];
+
+		const aero_int32 balance = C.height - B.height;
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			const aero_int32 iF = C.child1;
+			const aero_int32 iG = C.child2;
+			Node& F = m_nodes[iF];
+			Node& G = m_nodes[iG];
+
+			// Swap A and C
+			C.child1 = iA;
+			C.parent = A.parent;
+			A.parent = iC;
+
+			// A's old parent should point to C
+			if (C.parent != NullNode)
+			{
+				if (m_nodes[C.parent].child1 == iA)
+					m_nodes[C.parent].child1 = iC;
+				else
+					m_nodes[C.parent].child2 = iC;
+			}
+			else
+			{
+				m_root = iC;
+			}
+
+			// Rotate
+			if (F.height > G.height)
+			{
+				C.child2 = iF;
+				A.child2 = iG;
+				G.parent = iA;
+				A.aabb = AeroAABB2D::Combine(B.aabb, G.aabb);
+				C.aabb = AeroAABB2D::Combine(A.aabb, F.aabb);
+				A.height = 1 + std::max(B.height, G.height);
+				C.height = 1 + std::max(A.height, F.height);
+			}
+			else
+			{
+				C.child2 = iG;
+				A.child2 = iF;
+				F.parent = iA;
+				A.aabb = AeroAABB2D::Combine(B.aabb, F.aabb);
+				C.aabb = AeroAABB2D::Combine(A.aabb, G.aabb);
+				A.height = 1 + std::max(B.height, F.height);
+				C.height = 1 + std::max(A.height, G.height);
+			}
+
+			return iC;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			const aero_int32 iD = B.child1;
+			const aero_int32 iE = B.child2;
+			Node& D = m_nodes[iD];
+			Node& E = m_nodes[iE];
+
+			// Swap A and B
+			B.child1 = iA;
+			B.parent = A.parent;
+			A.parent = iB;
+
+			// A's old parent should point to B
+			if (B.parent != NullNode)
+			{
+				if (m_nodes[B.parent].child1 == iA)
+					m_nodes[B.parent].child1 = iB;
+				else
+					m_nodes[B.parent].child2 = iB;
+			}
+			else
+			{
+				m_root = iB;
+			}
+
+			// Rotate
+			if (D.height > E.height)
+			{
+				B.child2 = iD;
+				A.child1 = iE;
+				E.parent = iA;
+				A.aabb = AeroAABB2D::Combine(C.aabb, E.aabb);
+				B.aabb = AeroAABB2D::Combine(A.aabb, D.aabb);
+				A.height = 1 + std::max(C.height, E.height);
+				B.height = 1 + std::max(A.height, D.height);
+			}
+			else
+			{
+				B.child2 = iE;
+				A.child1 = iD;
+				D.parent = iA;
+				A.aabb = AeroAABB2D::Combine(C.aabb, D.aabb);
+				B.aabb = AeroAABB2D::Combine(A.aabb, E.aabb);
+				A.height = 1 + std::max(C.height, D.height);
+				B.height = 1 + std::max(A.height, E.height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+	void AeroBvh::FatAABB(const AeroAABB2D& aabb, const AeroVec2& velocity, AeroAABB2D& fatAabb) const
+	{
+		fatAabb = aabb;
+		fatAabb.Expand(AeroVec2(m_fatMargin, m_fatMargin));
+
+		// Extend the box in the direction the body is predicted to move.
+		const AeroVec2 d = velocity * m_predictionTime;
+		if (d.x < 0) fatAabb.min.x += d.x; else fatAabb.max.x += d.x;
+		if (d.y < 0) fatAabb.min.y += d.y; else fatAabb.max.y += d.y;
+	}
+
+	void AeroBvh::AddPair(const aero_int32 proxyA, const aero_int32 proxyB)
+	{
+		// Proxies only overlap a handful of others, scanning the shorter link list is cheaper than a hash lookup.
+		const std::vector<PairLink>& linksA = m_links[proxyA];
+		const std::vector<PairLink>& linksB = m_links[proxyB];
+		const bool scanA = linksA.size() <= linksB.size();
+		const aero_int32 partner = scanA ? proxyB : proxyA;
+		for (const PairLink& link : scanA ? linksA : linksB)
+		{
+			if (link.partner == partner) return;
+		}
+
+		const auto pairIndex = static_cast<aero_int32>(m_pairs.size());
+		m_pairs.push_back({ std::min(proxyA, proxyB), std::max(proxyA, proxyB) });
+		m_links[proxyA].push_back({ proxyB, pairIndex });
+		m_links[proxyB].push_back({ proxyA, pairIndex });
+	}
+
+	void AeroBvh::RemovePair(const aero_int32 pairIndex)
+	{
+		const Pair pair = m_pairs[pairIndex];
+		UnlinkPair(pair.proxyA, pair.proxyB);
+		UnlinkPair(pair.proxyB, pair.proxyA);
+
+		// Move the last pair into the hole and point its links at the new index.
+		const auto lastIndex = static_cast<aero_int32>(m_pairs.size()) - 1;
+		if (pairIndex != lastIndex)
+		{
+			const Pair last = m_pairs[lastIndex];
+			m_pairs[pairIndex] = last;
+			for (const aero_int32 proxyId : { last.proxyA, last.proxyB })
+			{
+				for (PairLink& link : m_links[proxyId])
+				{
+					if (link.pair == lastIndex) link.pair = pairIndex;
+				}
+			}
+		}
+		m_pairs.pop_back();
+	}
+
+	void AeroBvh::UnlinkPair(const aero_int32 proxyId, const aero_int32 partner)
+	{
+		std::vector<PairLink>& links = m_links[proxyId];
+		for (std::size_t i = 0; i < links.size(); ++i)
+		{
+			if (links[i].partner == partner)
+			{
+				links[i] = links.back();
+				links.pop_back();
+				return;
+			}
+		}
+	}
+}
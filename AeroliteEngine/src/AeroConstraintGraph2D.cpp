@@ -0,0 +1,104 @@
+#include "AeroConstraintGraph2D.h"
+
+namespace Aerolite
+{
+	void AeroConstraintGraph2D::Build(const AeroIslandManager2D& islands,
+	                                  const std::pmr::vector<PenetrationConstraint>& contacts,
+	                                  const std::vector<std::unique_ptr<Constraint2D>>& joints,
+	                                  const aero_int32 threshold)
+	{
+		// Only the colors used by the last step hold anything. The body sets of a color are cleared when
+		// AssignColor first uses it, so a step without a colored island does not touch them at all.
+		for (aero_int32 color = 0; color < m_colorCount; ++color)
+		{
+			m_colors[color].contacts.clear();
+			m_colors[color].joints.clear();
+		}
+		m_colorCount = 0;
+		m_words = (islands.GetAwakeBodyCount() + 63) / 64;
+		m_islands.clear();
+		m_overflowContacts.clear();
+		m_overflowJoints.clear();
+
+		for (std::size_t i = 0; i < islands.GetIslandCount(); ++i)
+		{
+			const AeroIsland2D& island = islands.GetIsland(i);
+			if (threshold <= 0 || island.contact_count + island.joint_count < threshold)
+			{
+				m_islands.push_back(static_cast<aero_int32>(i));
+				continue;
+			}
+
+			for (const aero_int32 joint : islands.GetJoints(island))
+			{
+				const aero_int32 color = AssignColor(*joints[joint]->a, *joints[joint]->b);
+				(color < MAX_COLORS ? m_colors[color].joints : m_overflowJoints).push_back(joint);
+			}
+			for (const aero_int32 contact : islands.GetContacts(island))
+			{
+				if (contacts[contact].IsBlockPartner()) continue;
+
+				const aero_int32 color = AssignColor(*contacts[contact].a, *contacts[contact].b);
+				(color < MAX_COLORS ? m_colors[color].contacts : m_overflowContacts).push_back(contact);
+			}
+		}
+	}
+
+	aero_int32 AeroConstraintGraph2D::AssignColor(const AeroBody2D& a, const AeroBody2D& b)
+	{
+		// Only awake dynamic bodies have an island index. For the others the bit stays zero, which never conflicts.
+		const bool dynamicA = !a.IsStatic() && !a.IsSleeping();
+		const bool dynamicB = !b.IsStatic() && !b.IsSleeping();
+		const std::size_t wordA = dynamicA ? static_cast<std::size_t>(a.island_index) / 64 : 0;
+		const std::size_t wordB = dynamicB ? static_cast<std::size_t>(b.island_index) / 64 : 0;
+		const aero_uint64 bitA = dynamicA ? aero_uint64{1} << (a.island_index % 64) : 0;
+		const aero_uint64 bitB = dynamicB ? aero_uint64{1} << (b.island_index % 64) : 0;
+
+		for (aero_int32 color = 0; color < MAX_COLORS; ++color)
+		{
+			std::vector<aero_uint64>& bodies = m_colors[color].bodies;
+			if (color >= m_colorCount)
+			{
+				// First constraint of the color this step, every body is free in it.
+				bodies.assign(m_words, 0);
+			}
+			if ((bodies[wordA] & bitA) || (bodies[wordB] & bitB)) continue;
+
+			bodies[wordA] |= bitA;
+			bodies[wordB] |= bitB;
+			if (color >= m_colorCount) m_colorCount = color + 1;
+			return color;
+		}
+		return MAX_COLORS;
+	}
+
+	std::span<const aero_int32> AeroConstraintGraph2D::GetIslands() const
+	{
+		return m_islands;
+	}
+
+	aero_int32 AeroConstraintGraph2D::GetColorCount() const
+	{
+		return m_colorCount;
+	}
+
+	std::span<const aero_int32> AeroConstraintGraph2D::GetContacts(const aero_int32 color) const
+	{
+		return m_colors[color].contacts;
+	}
+
+	std::span<const aero_int32> AeroConstraintGraph2D::GetJoints(const aero_int32 color) const
+	{
+		return m_colors[color].joints;
+	}
+
+	std::span<const aero_int32> AeroConstraintGraph2D::GetOverflowContacts() const
+	{
+		return m_overflowContacts;
+	}
+
+	std::span<const aero_int32> AeroConstraintGraph2D::GetOverflowJoints() const
+	{
+		return m_overflowJoints;
+	}
+}
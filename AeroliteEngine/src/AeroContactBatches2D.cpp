@@ -0,0 +1,471 @@
+#include <algorithm>
+#include "AeroContactBatches2D.h"
+#include "AeroSimd.h"
+
+namespace Aerolite
+{
+	namespace
+	{
+		using Batch = AeroContactBatches2D::Batch;
+		constexpr std::size_t LANES = AeroContactBatches2D::LANES;
+
+		// A register of doubles with the operations the contact kernel needs, so the kernel is written once for
+		// every width. Comparisons give a mask for Select. The gathers read one row of the body states per lane
+		// and the scatters write the lanes whose bit is set in the mask.
+#ifdef AERO_SIMD_SSE2
+		struct Sse2Lanes
+		{
+			static constexpr std::size_t WIDTH = 2;
+			__m128d v;
+
+			static Sse2Lanes Load(const real* p) { return { _mm_load_pd(p) }; }
+			static Sse2Lanes Set(const real x) { return { _mm_set1_pd(x) }; }
+			void Store(real* p) const { _mm_store_pd(p, v); }
+
+			friend Sse2Lanes operator+(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_add_pd(a.v, b.v) }; }
+			friend Sse2Lanes operator-(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_sub_pd(a.v, b.v) }; }
+			friend Sse2Lanes operator*(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_mul_pd(a.v, b.v) }; }
+			friend Sse2Lanes operator>=(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_cmpge_pd(a.v, b.v) }; }
+			friend Sse2Lanes operator&(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_and_pd(a.v, b.v) }; }
+			friend Sse2Lanes Min(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_min_pd(a.v, b.v) }; }
+			friend Sse2Lanes Max(const Sse2Lanes& a, const Sse2Lanes& b) { return { _mm_max_pd(a.v, b.v) }; }
+			friend Sse2Lanes Select(const Sse2Lanes& mask, const Sse2Lanes& a, const Sse2Lanes& b)
+			{
+				return { _mm_or_pd(_mm_and_pd(mask.v, a.v), _mm_andnot_pd(mask.v, b.v)) };
+			}
+
+			static Sse2Lanes Gather(const real* base, const aero_uint32* rows)
+			{
+				return { _mm_setr_pd(base[rows[0]], base[rows[1]]) };
+			}
+
+			static void GatherVec2(const AeroVec2* base, const aero_uint32* rows, Sse2Lanes& x, Sse2Lanes& y)
+			{
+				const __m128d first = Simd::Load(base[rows[0]]);
+				const __m128d second = Simd::Load(base[rows[1]]);
+				x = { _mm_unpacklo_pd(first, second) };
+				y = { _mm_unpackhi_pd(first, second) };
+			}
+
+			static void Scatter(real* base, const aero_uint32* rows, const Sse2Lanes& values, const aero_uint32 mask)
+			{
+				if (mask & 1) _mm_storel_pd(base + rows[0], values.v);
+				if (mask & 2) _mm_storeh_pd(base + rows[1], values.v);
+			}
+
+			static void ScatterVec2(AeroVec2* base, const aero_uint32* rows, const Sse2Lanes& x, const Sse2Lanes& y, const aero_uint32 mask)
+			{
+				if (mask & 1) _mm_storeu_pd(&base[rows[0]].x, _mm_unpacklo_pd(x.v, y.v));
+				if (mask & 2) _mm_storeu_pd(&base[rows[1]].x, _mm_unpackhi_pd(x.v, y.v));
+			}
+		};
+
+		struct AvxLanes
+		{
+			static constexpr std::size_t WIDTH = 4;
+			__m256d v;
+
+			AERO_SIMD_TARGET_AVX static AvxLanes Load(const real* p) { return { _mm256_load_pd(p) }; }
+			AERO_SIMD_TARGET_AVX static AvxLanes Set(const real x) { return { _mm256_set1_pd(x) }; }
+			AERO_SIMD_TARGET_AVX void Store(real* p) const { _mm256_store_pd(p, v); }
+
+			AERO_SIMD_TARGET_AVX friend AvxLanes operator+(const AvxLanes& a, const AvxLanes& b) { return { _mm256_add_pd(a.v, b.v) }; }
+			AERO_SIMD_TARGET_AVX friend AvxLanes operator-(const AvxLanes& a, const AvxLanes& b) { return { _mm256_sub_pd(a.v, b.v) }; }
+			AERO_SIMD_TARGET_AVX friend AvxLanes operator*(const AvxLanes& a, const AvxLanes& b) { return { _mm256_mul_pd(a.v, b.v) }; }
+			AERO_SIMD_TARGET_AVX friend AvxLanes operator>=(const AvxLanes& a, const AvxLanes& b) { return { _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ) }; }
+			AERO_SIMD_TARGET_AVX friend AvxLanes operator&(const AvxLanes& a, const AvxLanes& b) { return { _mm256_and_pd(a.v, b.v) }; }
+			AERO_SIMD_TARGET_AVX friend AvxLanes Min(const AvxLanes& a, const AvxLanes& b) { return { _mm256_min_pd(a.v, b.v) }; }
+			AERO_SIMD_TARGET_AVX friend AvxLanes Max(const AvxLanes& a, const AvxLanes& b) { return { _mm256_max_pd(a.v, b.v) }; }
+			AERO_SIMD_TARGET_AVX friend AvxLanes Select(const AvxLanes& mask, const AvxLanes& a, const AvxLanes& b)
+			{
+				return { _mm256_blendv_pd(b.v, a.v, mask.v) };
+			}
+
+			AERO_SIMD_TARGET_AVX static AvxLanes Gather(const real* base, const aero_uint32* rows)
+			{
+				return { _mm256_setr_pd(base[rows[0]], base[rows[1]], base[rows[2]], base[rows[3]]) };
+			}
+
+			AERO_SIMD_TARGET_AVX static void GatherVec2(const AeroVec2* base, const aero_uint32* rows, AvxLanes& x, AvxLanes& y)
+			{
+				// Rows 0 and 2 go to the low register, 1 and 3 to the high one, so that unpacking them pairs the x and the y.
+				const __m256d low = _mm256_insertf128_pd(_mm256_castpd128_pd256(Simd::Load(base[rows[0]])), Simd::Load(base[rows[2]]), 1);
+				const __m256d high = _mm256_insertf128_pd(_mm256_castpd128_pd256(Simd::Load(base[rows[1]])), Simd::Load(base[rows[3]]), 1);
+				x = { _mm256_unpacklo_pd(low, high) };
+				y = { _mm256_unpackhi_pd(low, high) };
+			}
+
+			AERO_SIMD_TARGET_AVX static void Scatter(real* base, const aero_uint32* rows, const AvxLanes& values, const aero_uint32 mask)
+			{
+				const __m128d low = _mm256_castpd256_pd128(values.v);
+				const __m128d high = _mm256_extractf128_pd(values.v, 1);
+				if (mask & 1) _mm_storel_pd(base + rows[0], low);
+				if (mask & 2) _mm_storeh_pd(base + rows[1], low);
+				if (mask & 4) _mm_storel_pd(base + rows[2], high);
+				if (mask & 8) _mm_storeh_pd(base + rows[3], high);
+			}
+
+			AERO_SIMD_TARGET_AVX static void ScatterVec2(AeroVec2* base, const aero_uint32* rows, const AvxLanes& x, const AvxLanes& y, const aero_uint32 mask)
+			{
+				const __m256d low = _mm256_unpacklo_pd(x.v, y.v); // x0 y0 x2 y2
+				const __m256d high = _mm256_unpackhi_pd(x.v, y.v); // x1 y1 x3 y3
+				if (mask & 1) _mm_storeu_pd(&base[rows[0]].x, _mm256_castpd256_pd128(low));
+				if (mask & 2) _mm_storeu_pd(&base[rows[1]].x, _mm256_castpd256_pd128(high));
+				if (mask & 4) _mm_storeu_pd(&base[rows[2]].x, _mm256_extractf128_pd(low, 1));
+				if (mask & 8) _mm_storeu_pd(&base[rows[3]].x, _mm256_extractf128_pd(high, 1));
+			}
+		};
+#else
+		struct ScalarLanes
+		{
+			static constexpr std::size_t WIDTH = 1;
+			real v;
+
+			static ScalarLanes Load(const real* p) { return { *p }; }
+			static ScalarLanes Set(const real x) { return { x }; }
+			void Store(real* p) const { *p = v; }
+
+			friend ScalarLanes operator+(const ScalarLanes& a, const ScalarLanes& b) { return { a.v + b.v }; }
+			friend ScalarLanes operator-(const ScalarLanes& a, const ScalarLanes& b) { return { a.v - b.v }; }
+			friend ScalarLanes operator*(const ScalarLanes& a, const ScalarLanes& b) { return { a.v * b.v }; }
+			friend ScalarLanes operator>=(const ScalarLanes& a, const ScalarLanes& b) { return { a.v >= b.v ? 1.0 : 0.0 }; }
+			friend ScalarLanes operator&(const ScalarLanes& a, const ScalarLanes& b) { return { a.v != 0.0 && b.v != 0.0 ? 1.0 : 0.0 }; }
+			friend ScalarLanes Min(const ScalarLanes& a, const ScalarLanes& b) { return { std::min(a.v, b.v) }; }
+			friend ScalarLanes Max(const ScalarLanes& a, const ScalarLanes& b) { return { std::max(a.v, b.v) }; }
+			friend ScalarLanes Select(const ScalarLanes& mask, const ScalarLanes& a, const ScalarLanes& b) { return mask.v != 0.0 ? a : b; }
+
+			static ScalarLanes Gather(const real* base, const aero_uint32* rows) { return { base[rows[0]] }; }
+
+			static void GatherVec2(const AeroVec2* base, const aero_uint32* rows, ScalarLanes& x, ScalarLanes& y)
+			{
+				x = { base[rows[0]].x };
+				y = { base[rows[0]].y };
+			}
+
+			static void Scatter(real* base, const aero_uint32* rows, const ScalarLanes& values, const aero_uint32 mask)
+			{
+				if (mask & 1) base[rows[0]] = values.v;
+			}
+
+			static void ScatterVec2(AeroVec2* base, const aero_uint32* rows, const ScalarLanes& x, const ScalarLanes& y, const aero_uint32 mask)
+			{
+				if (mask & 1) base[rows[0]] = AeroVec2(x.v, y.v);
+			}
+		};
+#endif
+
+		// Velocities and inverse masses of the two bodies of every lane, held in registers while the lanes are solved.
+		template<typename Lanes>
+		struct LaneBodies
+		{
+			Lanes vax, vay, wa;
+			Lanes vbx, vby, wb;
+			Lanes invMassA, invInertiaA;
+			Lanes invMassB, invInertiaB;
+
+			// Velocity of "b" relative to "a" at a point, see PenetrationConstraint::RelativeVelocity.
+			AERO_SIMD_INLINE void RelativeVelocity(const Lanes& rax, const Lanes& ray, const Lanes& rbx, const Lanes& rby, Lanes& x, Lanes& y) const
+			{
+				x = vbx - wb * rby - vax + wa * ray;
+				y = vby + wb * rbx - vay - wa * rax;
+			}
+
+			// Applies an impulse to "b" at a point and the opposite impulse to "a". Static bodies have no inverse mass
+			// and keep their velocity, they are not scattered back either.
+			AERO_SIMD_INLINE void ApplyImpulse(const Lanes& x, const Lanes& y, const Lanes& rax, const Lanes& ray, const Lanes& rbx, const Lanes& rby)
+			{
+				vax = vax - x * invMassA;
+				vay = vay - y * invMassA;
+				wa = wa - (rax * y - ray * x) * invInertiaA;
+				vbx = vbx + x * invMassB;
+				vby = vby + y * invMassB;
+				wb = wb + (rbx * y - rby * x) * invInertiaB;
+			}
+		};
+
+		// Solves the lanes lane to lane + Lanes::WIDTH of a batch once. Friction goes first so it is bounded by the
+		// normal impulses of the last iteration, then the normal rows are solved either as a block, with the cases of
+		// PenetrationConstraint::SolveBlockNormal, or one after the other.
+		template<typename Lanes>
+		AERO_SIMD_INLINE void SolveLanes(Batch& batch, const std::size_t lane, AeroBodyStates2D& states, const bool useBias)
+		{
+			const aero_uint32* rowsA = batch.row_a + lane;
+			const aero_uint32* rowsB = batch.row_b + lane;
+			LaneBodies<Lanes> bodies;
+			Lanes::GatherVec2(states.linear_velocities.data(), rowsA, bodies.vax, bodies.vay);
+			Lanes::GatherVec2(states.linear_velocities.data(), rowsB, bodies.vbx, bodies.vby);
+			bodies.wa = Lanes::Gather(states.angular_velocities.data(), rowsA);
+			bodies.wb = Lanes::Gather(states.angular_velocities.data(), rowsB);
+			bodies.invMassA = Lanes::Load(batch.inv_mass_a + lane);
+			bodies.invInertiaA = Lanes::Load(batch.inv_inertia_a + lane);
+			bodies.invMassB = Lanes::Load(batch.inv_mass_b + lane);
+			bodies.invInertiaB = Lanes::Load(batch.inv_inertia_b + lane);
+
+			const Lanes zero = Lanes::Set(0.0);
+			const Lanes friction = Lanes::Load(batch.friction + lane);
+			Lanes nx[2], ny[2], rax[2], ray[2], rbx[2], rby[2];
+			for (std::size_t point = 0; point < 2; ++point)
+			{
+				nx[point] = Lanes::Load(batch.normal_x[point] + lane);
+				ny[point] = Lanes::Load(batch.normal_y[point] + lane);
+				rax[point] = Lanes::Load(batch.ra_x[point] + lane);
+				ray[point] = Lanes::Load(batch.ra_y[point] + lane);
+				rbx[point] = Lanes::Load(batch.rb_x[point] + lane);
+				rby[point] = Lanes::Load(batch.rb_y[point] + lane);
+
+				// The tangent is the normal turned clockwise, (ny, -nx), see AeroVec2::Normal. A friction of zero
+				// clamps the impulse to zero.
+				Lanes vx, vy;
+				bodies.RelativeVelocity(rax[point], ray[point], rbx[point], rby[point], vx, vy);
+				const Lanes max = friction * Lanes::Load(batch.normal_impulse[point] + lane);
+				const Lanes oldImpulse = Lanes::Load(batch.tangent_impulse[point] + lane);
+				const Lanes impulse = Min(Max(oldImpulse - (vx * ny[point] - vy * nx[point]) * Lanes::Load(batch.tangent_mass[point] + lane), zero - max), max);
+				impulse.Store(batch.tangent_impulse[point] + lane);
+				const Lanes delta = impulse - oldImpulse;
+				bodies.ApplyImpulse(ny[point] * delta, zero - nx[point] * delta, rax[point], ray[point], rbx[point], rby[point]);
+			}
+
+			// Residuals J * V + bias of both normal rows at the same velocities.
+			const real (&bias)[2][LANES] = useBias ? batch.bias : batch.restitution_bias;
+			Lanes w[2];
+			for (std::size_t point = 0; point < 2; ++point)
+			{
+				Lanes vx, vy;
+				bodies.RelativeVelocity(rax[point], ray[point], rbx[point], rby[point], vx, vy);
+				w[point] = vx * nx[point] + vy * ny[point] + Lanes::Load(bias[point] + lane);
+			}
+
+			const Lanes old1 = Lanes::Load(batch.normal_impulse[0] + lane);
+			const Lanes old2 = Lanes::Load(batch.normal_impulse[1] + lane);
+			const Lanes normalMass1 = Lanes::Load(batch.normal_mass[0] + lane);
+			const Lanes normalMass2 = Lanes::Load(batch.normal_mass[1] + lane);
+			const Lanes k11 = Lanes::Load(batch.k11 + lane);
+			const Lanes k12 = Lanes::Load(batch.k12 + lane);
+			const Lanes k22 = Lanes::Load(batch.k22 + lane);
+
+			// One after the other, the impulse of the first point changes the residual of the second by k12 per unit.
+			const Lanes sequential1 = Max(old1 - w[0] * normalMass1, zero);
+			const Lanes sequential2 = Max(old2 - (w[1] + k12 * (sequential1 - old1)) * normalMass2, zero);
+
+			// As a block, the cases are checked from the last to the first so that the first one that holds wins.
+			// If none holds the impulses of the last iteration are kept.
+			const Lanes q1 = w[0] - (k11 * old1 + k12 * old2);
+			const Lanes q2 = w[1] - (k12 * old1 + k22 * old2);
+			Lanes block1 = old1;
+			Lanes block2 = old2;
+
+			const Lanes bothSeparate = (q1 >= zero) & (q2 >= zero);
+			block1 = Select(bothSeparate, zero, block1);
+			block2 = Select(bothSeparate, zero, block2);
+
+			const Lanes secondImpulse = zero - q2 * normalMass2;
+			const Lanes secondPushes = (secondImpulse >= zero) & (k12 * secondImpulse + q1 >= zero);
+			block1 = Select(secondPushes, zero, block1);
+			block2 = Select(secondPushes, secondImpulse, block2);
+
+			const Lanes firstImpulse = zero - q1 * normalMass1;
+			const Lanes firstPushes = (firstImpulse >= zero) & (k12 * firstImpulse + q2 >= zero);
+			block1 = Select(firstPushes, firstImpulse, block1);
+			block2 = Select(firstPushes, zero, block2);
+
+			const Lanes both1 = zero - (Lanes::Load(batch.block_mass11 + lane) * q1 + Lanes::Load(batch.block_mass12 + lane) * q2);
+			const Lanes both2 = zero - (Lanes::Load(batch.block_mass12 + lane) * q1 + Lanes::Load(batch.block_mass22 + lane) * q2);
+			const Lanes bothPush = (both1 >= zero) & (both2 >= zero);
+			block1 = Select(bothPush, both1, block1);
+			block2 = Select(bothPush, both2, block2);
+
+			const Lanes useBlock = Lanes::Load(batch.use_block + lane) >= Lanes::Set(1.0);
+			const Lanes impulse1 = Select(useBlock, block1, sequential1);
+			const Lanes impulse2 = Select(useBlock, block2, sequential2);
+			impulse1.Store(batch.normal_impulse[0] + lane);
+			impulse2.Store(batch.normal_impulse[1] + lane);
+
+			const Lanes delta1 = impulse1 - old1;
+			const Lanes delta2 = impulse2 - old2;
+			bodies.ApplyImpulse(nx[0] * delta1, ny[0] * delta1, rax[0], ray[0], rbx[0], rby[0]);
+			bodies.ApplyImpulse(nx[1] * delta2, ny[1] * delta2, rax[1], ray[1], rbx[1], rby[1]);
+
+			const aero_uint32 writeA = batch.write_a >> lane;
+			const aero_uint32 writeB = batch.write_b >> lane;
+			Lanes::ScatterVec2(states.linear_velocities.data(), rowsA, bodies.vax, bodies.vay, writeA);
+			Lanes::ScatterVec2(states.linear_velocities.data(), rowsB, bodies.vbx, bodies.vby, writeB);
+			Lanes::Scatter(states.angular_velocities.data(), rowsA, bodies.wa, writeA);
+			Lanes::Scatter(states.angular_velocities.data(), rowsB, bodies.wb, writeB);
+		}
+
+		template<typename Lanes>
+		AERO_SIMD_INLINE void SolveBatches(Batch* batches, const std::size_t count, AeroBodyStates2D& states, const bool useBias)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				for (std::size_t lane = 0; lane < LANES; lane += Lanes::WIDTH)
+				{
+					SolveLanes<Lanes>(batches[i], lane, states, useBias);
+				}
+			}
+		}
+
+		using BatchSolver = void (*)(Batch* batches, std::size_t count, AeroBodyStates2D& states, bool useBias);
+
+#ifdef AERO_SIMD_SSE2
+		void SolveBatchesSse2(Batch* batches, const std::size_t count, AeroBodyStates2D& states, const bool useBias)
+		{
+			SolveBatches<Sse2Lanes>(batches, count, states, useBias);
+		}
+
+		AERO_SIMD_TARGET_AVX void SolveBatchesAvx(Batch* batches, const std::size_t count, AeroBodyStates2D& states, const bool useBias)
+		{
+			SolveBatches<AvxLanes>(batches, count, states, useBias);
+		}
+#else
+		void SolveBatchesScalar(Batch* batches, const std::size_t count, AeroBodyStates2D& states, const bool useBias)
+		{
+			SolveBatches<ScalarLanes>(batches, count, states, useBias);
+		}
+#endif
+
+		BatchSolver SelectBatchSolver()
+		{
+#ifdef AERO_SIMD_SSE2
+			return Simd::HasAvx() ? &SolveBatchesAvx : &SolveBatchesSse2;
+#else
+			return &SolveBatchesScalar;
+#endif
+		}
+
+		std::size_t GetBatchCount(const std::span<const aero_int32> contacts)
+		{
+			return (contacts.size() + LANES - 1) / LANES;
+		}
+	}
+
+	void AeroContactBatches2D::Build(const AeroConstraintGraph2D& graph)
+	{
+		m_firstBatches.clear();
+		std::size_t batchCount = 0;
+		for (aero_int32 color = 0; color < graph.GetColorCount(); ++color)
+		{
+			m_firstBatches.push_back(static_cast<aero_int32>(batchCount));
+			batchCount += GetBatchCount(graph.GetContacts(color));
+		}
+
+		if (m_batches.size() < batchCount)
+		{
+			m_batches.resize(batchCount);
+		}
+	}
+
+	aero_int32 AeroContactBatches2D::GetFirstBatch(const aero_int32 color) const
+	{
+		return m_firstBatches[color];
+	}
+
+	void AeroContactBatches2D::Pack(const aero_int32 firstBatch, const std::span<const aero_int32> contacts,
+	                                std::pmr::vector<PenetrationConstraint>& penetrations)
+	{
+		for (std::size_t i = 0; i < GetBatchCount(contacts); ++i)
+		{
+			Batch& batch = m_batches[firstBatch + i];
+			batch.write_a = 0;
+			batch.write_b = 0;
+			for (std::size_t lane = 0; lane < LANES; ++lane)
+			{
+				const std::size_t index = i * LANES + lane;
+				PackLane(batch, lane, index < contacts.size() ? &penetrations[contacts[index]] : nullptr);
+			}
+		}
+	}
+
+	void AeroContactBatches2D::Solve(AeroBodyStates2D& states, const aero_int32 firstBatch,
+	                                 const std::span<const aero_int32> contacts, const bool useBias)
+	{
+		static const BatchSolver solver = SelectBatchSolver();
+		solver(m_batches.data() + firstBatch, GetBatchCount(contacts), states, useBias);
+	}
+
+	void AeroContactBatches2D::Unpack(const aero_int32 firstBatch, const std::span<const aero_int32> contacts) const
+	{
+		for (std::size_t i = 0; i < contacts.size(); ++i)
+		{
+			const Batch& batch = m_batches[firstBatch + i / LANES];
+			const std::size_t lane = i % LANES;
+			PenetrationConstraint& constraint = *batch.constraints[lane];
+			constraint.normalImpulse = batch.normal_impulse[0][lane];
+			constraint.tangentImpulse = batch.tangent_impulse[0][lane];
+			if (constraint.blockPartner != nullptr)
+			{
+				constraint.blockPartner->normalImpulse = batch.normal_impulse[1][lane];
+				constraint.blockPartner->tangentImpulse = batch.tangent_impulse[1][lane];
+			}
+		}
+	}
+
+	void AeroContactBatches2D::PackLane(Batch& batch, const std::size_t lane, PenetrationConstraint* constraint)
+	{
+		batch.constraints[lane] = constraint;
+		if (constraint == nullptr)
+		{
+			// An empty lane solves against the bodies of the first lane, with no mass and no point, and writes nothing.
+			PackPoint(batch, 0, lane, nullptr);
+			PackPoint(batch, 1, lane, nullptr);
+			batch.friction[lane] = 0.0;
+			batch.inv_mass_a[lane] = batch.inv_inertia_a[lane] = 0.0;
+			batch.inv_mass_b[lane] = batch.inv_inertia_b[lane] = 0.0;
+			batch.k11[lane] = batch.k12[lane] = batch.k22[lane] = 0.0;
+			batch.block_mass11[lane] = batch.block_mass12[lane] = batch.block_mass22[lane] = 0.0;
+			batch.use_block[lane] = 0.0;
+			batch.row_a[lane] = batch.row_a[0];
+			batch.row_b[lane] = batch.row_b[0];
+			return;
+		}
+
+		const PenetrationConstraint& c = *constraint;
+		PackPoint(batch, 0, lane, &c);
+		PackPoint(batch, 1, lane, c.blockPartner);
+		batch.friction[lane] = c.friction;
+		batch.inv_mass_a[lane] = c.invMassA;
+		batch.inv_inertia_a[lane] = c.invInertiaA;
+		batch.inv_mass_b[lane] = c.invMassB;
+		batch.inv_inertia_b[lane] = c.invInertiaB;
+		const bool isBlock = c.blockPartner != nullptr;
+		batch.k11[lane] = isBlock ? c.k11 : 0.0;
+		batch.k12[lane] = isBlock ? c.k12 : 0.0;
+		batch.k22[lane] = isBlock ? c.k22 : 0.0;
+		batch.block_mass11[lane] = isBlock ? c.blockMass11 : 0.0;
+		batch.block_mass12[lane] = isBlock ? c.blockMass12 : 0.0;
+		batch.block_mass22[lane] = isBlock ? c.blockMass22 : 0.0;
+		batch.use_block[lane] = isBlock && c.useBlock ? 1.0 : 0.0;
+		batch.row_a[lane] = c.stateA;
+		batch.row_b[lane] = c.stateB;
+		if (c.invMassA > 0.0) batch.write_a |= 1u << lane;
+		if (c.invMassB > 0.0) batch.write_b |= 1u << lane;
+	}
+
+	void AeroContactBatches2D::PackPoint(Batch& batch, const std::size_t point, const std::size_t lane, const PenetrationConstraint* constraint)
+	{
+		if (constraint == nullptr)
+		{
+			batch.normal_x[point][lane] = batch.normal_y[point][lane] = 0.0;
+			batch.ra_x[point][lane] = batch.ra_y[point][lane] = 0.0;
+			batch.rb_x[point][lane] = batch.rb_y[point][lane] = 0.0;
+			batch.normal_mass[point][lane] = batch.tangent_mass[point][lane] = 0.0;
+			batch.bias[point][lane] = batch.restitution_bias[point][lane] = 0.0;
+			batch.normal_impulse[point][lane] = batch.tangent_impulse[point][lane] = 0.0;
+			return;
+		}
+
+		const PenetrationConstraint& c = *constraint;
+		batch.normal_x[point][lane] = c.n.x;
+		batch.normal_y[point][lane] = c.n.y;
+		batch.ra_x[point][lane] = c.ra.x;
+		batch.ra_y[point][lane] = c.ra.y;
+		batch.rb_x[point][lane] = c.rb.x;
+		batch.rb_y[point][lane] = c.rb.y;
+		batch.normal_mass[point][lane] = c.normalMass;
+		batch.tangent_mass[point][lane] = c.tangentMass;
+		batch.bias[point][lane] = c.bias;
+		batch.restitution_bias[point][lane] = c.restitutionBias;
+		batch.normal_impulse[point][lane] = c.normalImpulse;
+		batch.tangent_impulse[point][lane] = c.tangentImpulse;
+	}
+}
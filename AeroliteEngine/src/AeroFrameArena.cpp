@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include "AeroFrameArena.h"
+
+namespace Aerolite
+{
+	AeroFrameArena::AeroFrameArena(const std::size_t capacity)
+		: m_buffer(std::make_unique<std::byte[]>(capacity)), m_capacity(capacity)
+	{
+	}
+
+	AeroFrameArena::~AeroFrameArena()
+	{
+		ReleaseOverflow();
+	}
+
+	void AeroFrameArena::Reset()
+	{
+		const std::size_t used = m_offset.load();
+		m_highWaterMark = std::max(m_highWaterMark, used);
+		ReleaseOverflow();
+
+		// The step did not fit, make room for it at once instead of overflowing again on the next steps.
+		if (used > m_capacity)
+		{
+			m_capacity = std::max(used, m_capacity * 2);
+			m_buffer = std::make_unique<std::byte[]>(m_capacity);
+		}
+		m_offset = 0;
+	}
+
+	std::size_t AeroFrameArena::GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	std::size_t AeroFrameArena::GetUsed() const
+	{
+		return m_offset.load();
+	}
+
+	std::size_t AeroFrameArena::GetHighWaterMark() const
+	{
+		return std::max(m_highWaterMark, m_offset.load());
+	}
+
+	void* AeroFrameArena::do_allocate(const std::size_t bytes, const std::size_t alignment)
+	{
+		const auto base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+		std::size_t offset = m_offset.load(std::memory_order_relaxed);
+		std::size_t aligned;
+		do
+		{
+			aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+		}
+		while (!m_offset.compare_exchange_weak(offset, aligned + bytes, std::memory_order_relaxed));
+
+		if (aligned + bytes <= m_capacity)
+		{
+			return m_buffer.get() + aligned;
+		}
+
+		// Past the end of the buffer. The offset still counts the bytes, Reset grows the buffer by them.
+		void* memory = ::operator new(bytes, std::align_val_t(alignment));
+		std::lock_guard lock(m_overflowMutex);
+		m_overflow.push_back({ memory, bytes, alignment });
+		return memory;
+	}
+
+	void AeroFrameArena::do_deallocate(void*, std::size_t, std::size_t)
+	{
+		// Memory is only released all at once by Reset.
+	}
+
+	bool AeroFrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	void AeroFrameArena::ReleaseOverflow()
+	{
+		for (const Overflow& overflow : m_overflow)
+		{
+			::operator delete(overflow.memory, overflow.bytes, std::align_val_t(overflow.alignment));
+		}
+		m_overflow.clear();
+	}
+}
@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <limits>
+#include "AeroIsland2D.h"
+
+namespace Aerolite {
+
+    void AeroIslandManager2D::Clear()
+    {
+        m_sleepingIslands.clear();
+        m_freeIslands.clear();
+        m_sleepingIslandCount = 0;
+        m_awakeBodies.clear();
+        m_islands.clear();
+        m_solveOrder.clear();
+        m_edges.clear();
+        m_previousEdges.clear();
+    }
+
+    bool AeroIslandManager2D::IsSleepingEnabled() const
+    {
+        return m_sleepingEnabled;
+    }
+
+    real AeroIslandManager2D::GetLinearSleepTolerance() const
+    {
+        return m_linearSleepTolerance;
+    }
+
+    real AeroIslandManager2D::GetAngularSleepTolerance() const
+    {
+        return m_angularSleepTolerance;
+    }
+
+    real AeroIslandManager2D::GetTimeToSleep() const
+    {
+        return m_timeToSleep;
+    }
+
+    void AeroIslandManager2D::SetSleepingEnabled(const bool enabled)
+    {
+        m_sleepingEnabled = enabled;
+        if (!enabled) {
+            WakeAll();
+        }
+    }
+
+    void AeroIslandManager2D::SetLinearSleepTolerance(const real tolerance)
+    {
+        m_linearSleepTolerance = tolerance;
+    }
+
+    void AeroIslandManager2D::SetAngularSleepTolerance(const real tolerance)
+    {
+        m_angularSleepTolerance = tolerance;
+    }
+
+    void AeroIslandManager2D::SetTimeToSleep(const real seconds)
+    {
+        m_timeToSleep = seconds;
+    }
+
+    bool AeroIslandManager2D::WakeIsland(AeroBody2D& body)
+    {
+        if (!body.IsSleeping()) return false;
+
+        if (body.island_index < 0 || body.island_index >= static_cast<aero_int32>(m_sleepingIslands.size())) {
+            // Put to sleep by hand rather than by the manager, so it has no island to wake.
+            body.Awake();
+            return true;
+        }
+
+        WakeIslandAt(body.island_index);
+        return true;
+    }
+
+    void AeroIslandManager2D::WakeIslandAt(const aero_int32 islandIndex)
+    {
+        auto& island = m_sleepingIslands[islandIndex];
+        if (island.empty()) return;
+
+        for (AeroBody2D* body : island) {
+            body->Awake();
+            body->island_index = -1;
+        }
+
+        island.clear();
+        m_freeIslands.push_back(islandIndex);
+        m_sleepingIslandCount--;
+    }
+
+    void AeroIslandManager2D::WakeAll()
+    {
+        for (aero_int32 i = 0; i < static_cast<aero_int32>(m_sleepingIslands.size()); i++) {
+            WakeIslandAt(i);
+        }
+    }
+
+    void AeroIslandManager2D::RemoveBody(AeroBody2D& body)
+    {
+        if (body.IsStatic()) {
+            // Static bodies are not part of any island, so there is no telling what rested on them.
+            WakeAll();
+        }
+        else {
+            WakeIsland(body);
+        }
+
+        const auto touches = [&body](const std::pair<AeroBody2D*, AeroBody2D*>& edge) {
+            return edge.first == &body || edge.second == &body;
+        };
+        std::erase_if(m_edges, touches);
+        std::erase_if(m_previousEdges, touches);
+    }
+
+    bool AeroIslandManager2D::WakeDisturbedIslands()
+    {
+        bool woke = false;
+        for (aero_int32 i = 0; i < static_cast<aero_int32>(m_sleepingIslands.size()); i++) {
+            for (const AeroBody2D* body : m_sleepingIslands[i]) {
+                if (!body->IsSleeping()) {
+                    WakeIslandAt(i);
+                    woke = true;
+                    break;
+                }
+            }
+        }
+        return woke;
+    }
+
+    aero_int32 AeroIslandManager2D::Find(aero_int32 node)
+    {
+        while (m_parent[node] != node) {
+            m_parent[node] = m_parent[m_parent[node]]; // Path halving.
+            node = m_parent[node];
+        }
+        return node;
+    }
+
+    void AeroIslandManager2D::Union(const AeroBody2D& a, const AeroBody2D& b)
+    {
+        // Static bodies do not connect islands, and sleeping bodies belong to an island that is already built.
+        if (a.IsStatic() || b.IsStatic() || a.IsSleeping() || b.IsSleeping()) return;
+
+        const aero_int32 rootA = Find(a.island_index);
+        const aero_int32 rootB = Find(b.island_index);
+        if (rootA != rootB) {
+            m_parent[rootB] = rootA;
+        }
+    }
+
+    void AeroIslandManager2D::BuildIslands(const std::span<AeroBody2D* const> bodies,
+                                           const std::pmr::vector<PenetrationConstraint>& contacts,
+                                           const std::vector<std::unique_ptr<Constraint2D>>& joints)
+    {
+        m_awakeBodies.clear();
+        m_parent.clear();
+
+        // Every awake dynamic body starts as its own island.
+        for (AeroBody2D* body : bodies) {
+            if (body->IsStatic() || body->IsSleeping()) continue;
+
+            body->island_index = static_cast<aero_int32>(m_awakeBodies.size());
+            m_parent.push_back(body->island_index);
+            m_awakeBodies.push_back(body);
+        }
+
+        m_previousEdges.swap(m_edges);
+        m_edges.clear();
+        for (const auto& contact : contacts) {
+            m_edges.emplace_back(contact.a, contact.b);
+            Union(*contact.a, *contact.b);
+        }
+
+        for (const auto& [a, b] : m_previousEdges) {
+            Union(*a, *b);
+        }
+
+        for (const auto& joint : joints) {
+            Union(*joint->a, *joint->b);
+        }
+
+        // Number the islands in the order their first body appears, so the layout only depends on the input.
+        m_islands.clear();
+        m_islandOfRoot.assign(m_awakeBodies.size(), -1);
+        m_bodyIsland.resize(m_awakeBodies.size());
+        for (std::size_t i = 0; i < m_awakeBodies.size(); i++) {
+            const aero_int32 root = Find(static_cast<aero_int32>(i));
+            if (m_islandOfRoot[root] < 0) {
+                m_islandOfRoot[root] = static_cast<aero_int32>(m_islands.size());
+                m_islands.emplace_back();
+            }
+            m_bodyIsland[i] = m_islandOfRoot[root];
+            m_islands[m_bodyIsland[i]].body_count++;
+        }
+
+        // A constraint belongs to the island of its dynamic body. Constraints between static or sleeping
+        // bodies have nothing to solve and are left out.
+        const auto islandOf = [this](const AeroBody2D& a, const AeroBody2D& b) -> aero_int32 {
+            if (!a.IsStatic() && !a.IsSleeping()) return m_bodyIsland[a.island_index];
+            if (!b.IsStatic() && !b.IsSleeping()) return m_bodyIsland[b.island_index];
+            return -1;
+        };
+
+        m_contactIsland.resize(contacts.size());
+        for (std::size_t i = 0; i < contacts.size(); i++) {
+            m_contactIsland[i] = islandOf(*contacts[i].a, *contacts[i].b);
+            if (m_contactIsland[i] >= 0) m_islands[m_contactIsland[i]].contact_count++;
+        }
+
+        m_jointIsland.resize(joints.size());
+        for (std::size_t i = 0; i < joints.size(); i++) {
+            m_jointIsland[i] = islandOf(*joints[i]->a, *joints[i]->b);
+            if (m_jointIsland[i] >= 0) m_islands[m_jointIsland[i]].joint_count++;
+        }
+
+        // Lay the islands out back to back and scatter the bodies and constraints into them, keeping
+        // their original order inside every island.
+        aero_int32 bodyOffset = 0, contactOffset = 0, jointOffset = 0;
+        for (auto& island : m_islands) {
+            island.first_body = bodyOffset;
+            island.first_contact = contactOffset;
+            island.first_joint = jointOffset;
+            bodyOffset += island.body_count;
+            contactOffset += island.contact_count;
+            jointOffset += island.joint_count;
+            island.body_count = island.contact_count = island.joint_count = 0;
+        }
+
+        m_islandBodies.resize(bodyOffset);
+        m_islandContacts.resize(contactOffset);
+        m_islandJoints.resize(jointOffset);
+        for (std::size_t i = 0; i < m_awakeBodies.size(); i++) {
+            auto& island = m_islands[m_bodyIsland[i]];
+            m_islandBodies[island.first_body + island.body_count++] = m_awakeBodies[i];
+        }
+        for (std::size_t i = 0; i < contacts.size(); i++) {
+            if (m_contactIsland[i] < 0) continue;
+            auto& island = m_islands[m_contactIsland[i]];
+            m_islandContacts[island.first_contact + island.contact_count++] = static_cast<aero_int32>(i);
+        }
+        for (std::size_t i = 0; i < joints.size(); i++) {
+            if (m_jointIsland[i] < 0) continue;
+            auto& island = m_islands[m_jointIsland[i]];
+            m_islandJoints[island.first_joint + island.joint_count++] = static_cast<aero_int32>(i);
+        }
+
+        // Largest islands first, so the solver hands out the longest jobs before the short ones. Ties keep
+        // the island order; std::sort with the index as tie breaker does so without stable_sort's buffer.
+        m_solveOrder.resize(m_islands.size());
+        for (std::size_t i = 0; i < m_islands.size(); i++) {
+            m_solveOrder[i] = static_cast<aero_int32>(i);
+        }
+        std::sort(m_solveOrder.begin(), m_solveOrder.end(), [this](const aero_int32 a, const aero_int32 b) {
+            const aero_int32 sizeA = m_islands[a].contact_count + m_islands[a].joint_count;
+            const aero_int32 sizeB = m_islands[b].contact_count + m_islands[b].joint_count;
+            return sizeA != sizeB ? sizeA > sizeB : a < b;
+        });
+    }
+
+    void AeroIslandManager2D::UpdateSleep(const real dt)
+    {
+        const real linearToleranceSquared = m_linearSleepTolerance * m_linearSleepTolerance;
+        const real angularToleranceSquared = m_angularSleepTolerance * m_angularSleepTolerance;
+
+        for (const auto& island : m_islands) {
+            // An island can only sleep once its most restless body can.
+            real minSleepTime = std::numeric_limits<real>::max();
+            for (AeroBody2D* body : GetBodies(island)) {
+                // The position integration adds half a step of acceleration on top of the velocity, so a body
+                // resting on the ground under gravity keeps a small velocity that is cancelled by that term.
+                const AeroVec2 motion = body->GetLinearVelocity() + body->linear_acceleration * (dt * 0.5);
+                if (motion.MagnitudeSquared() > linearToleranceSquared ||
+                    body->GetAngularVelocity() * body->GetAngularVelocity() > angularToleranceSquared) {
+                    body->sleep_timer = 0;
+                }
+                else {
+                    body->sleep_timer += dt;
+                }
+                minSleepTime = std::min(minSleepTime, body->sleep_timer);
+                body->island_index = -1;
+            }
+
+            if (!m_sleepingEnabled || minSleepTime < m_timeToSleep) continue;
+
+            aero_int32 slot;
+            if (!m_freeIslands.empty()) {
+                slot = m_freeIslands.back();
+                m_freeIslands.pop_back();
+            }
+            else {
+                slot = static_cast<aero_int32>(m_sleepingIslands.size());
+                m_sleepingIslands.emplace_back();
+            }
+            m_sleepingIslandCount++;
+
+            for (AeroBody2D* body : GetBodies(island)) {
+                body->island_index = slot;
+                body->Sleep();
+                m_sleepingIslands[slot].push_back(body);
+            }
+        }
+    }
+
+    std::size_t AeroIslandManager2D::GetAwakeBodyCount() const
+    {
+        return m_awakeBodies.size();
+    }
+
+    std::size_t AeroIslandManager2D::GetIslandCount() const
+    {
+        return m_islands.size();
+    }
+
+    const AeroIsland2D& AeroIslandManager2D::GetIsland(const std::size_t index) const
+    {
+        return m_islands[m_solveOrder[index]];
+    }
+
+    std::span<AeroBody2D* const> AeroIslandManager2D::GetBodies(const AeroIsland2D& island) const
+    {
+        return { m_islandBodies.data() + island.first_body, static_cast<std::size_t>(island.body_count) };
+    }
+
+    std::span<const aero_int32> AeroIslandManager2D::GetContacts(const AeroIsland2D& island) const
+    {
+        return { m_islandContacts.data() + island.first_contact, static_cast<std::size_t>(island.contact_count) };
+    }
+
+    std::span<const aero_int32> AeroIslandManager2D::GetJoints(const AeroIsland2D& island) const
+    {
+        return { m_islandJoints.data() + island.first_joint, static_cast<std::size_t>(island.joint_count) };
+    }
+
+    std::size_t AeroIslandManager2D::GetSleepingIslandCount() const
+    {
+        return m_sleepingIslandCount;
+    }
+}
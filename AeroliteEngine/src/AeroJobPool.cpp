@@ -0,0 +1,145 @@
+#include <algorithm>
+#include "AeroJobPool.h"
+
+namespace Aerolite {
+
+    AeroJobPool::AeroJobPool(const aero_int32 workerCount)
+    {
+        StartWorkers(workerCount);
+    }
+
+    AeroJobPool::~AeroJobPool()
+    {
+        StopWorkers();
+    }
+
+    aero_int32 AeroJobPool::GetWorkerCount() const
+    {
+        return static_cast<aero_int32>(m_queues.size());
+    }
+
+    void AeroJobPool::SetWorkerCount(const aero_int32 workerCount)
+    {
+        if (workerCount == GetWorkerCount()) return;
+
+        StopWorkers();
+        StartWorkers(workerCount);
+    }
+
+    void AeroJobPool::StartWorkers(aero_int32 workerCount)
+    {
+        workerCount = std::max(workerCount, 1);
+
+        m_stop = false;
+        m_queues.clear();
+        for (aero_int32 i = 0; i < workerCount; i++) {
+            m_queues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        // The calling thread is worker 0, so only the other workers get a thread.
+        for (aero_int32 i = 1; i < workerCount; i++) {
+            m_threads.emplace_back(&AeroJobPool::WorkerLoop, this, i);
+        }
+    }
+
+    void AeroJobPool::StopWorkers()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+        m_threads.clear();
+    }
+
+    void AeroJobPool::ParallelFor(const aero_int32 count, const std::function<void(aero_int32)>& job)
+    {
+        if (count <= 0) return;
+
+        if (m_threads.empty() || count == 1) {
+            for (aero_int32 i = 0; i < count; i++) {
+                job(i);
+            }
+            return;
+        }
+
+        m_job = &job;
+        m_remaining = count;
+
+        const auto workerCount = static_cast<aero_int32>(m_queues.size());
+        for (aero_int32 worker = 0; worker < workerCount; worker++) {
+            WorkQueue& queue = *m_queues[worker];
+            std::lock_guard lock(queue.mutex);
+            queue.jobs.clear();
+            queue.front = 0;
+            for (aero_int32 i = worker; i < count; i += workerCount) {
+                queue.jobs.push_back(i);
+            }
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_batch++;
+        }
+        m_wake.notify_all();
+
+        // Help out until there is nothing left to take, then wait for the jobs still running elsewhere.
+        while (RunJob(0)) {}
+
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [this] { return m_remaining.load() == 0; });
+        m_job = nullptr;
+    }
+
+    void AeroJobPool::WorkerLoop(const aero_int32 worker)
+    {
+        aero_uint64 batch = 0;
+        while (true) {
+            {
+                std::unique_lock lock(m_mutex);
+                m_wake.wait(lock, [this, batch] { return m_stop || m_batch != batch; });
+                if (m_stop) return;
+                batch = m_batch;
+            }
+
+            while (RunJob(worker)) {}
+        }
+    }
+
+    bool AeroJobPool::RunJob(const aero_int32 worker)
+    {
+        aero_int32 job = -1;
+        {
+            WorkQueue& queue = *m_queues[worker];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.IsEmpty()) {
+                job = queue.jobs[queue.front++];
+            }
+        }
+
+        // Steal from the back of the other queues, where the smallest jobs of the batch are.
+        const auto workerCount = static_cast<aero_int32>(m_queues.size());
+        for (aero_int32 i = 1; job < 0 && i < workerCount; i++) {
+            WorkQueue& victim = *m_queues[(worker + i) % workerCount];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.IsEmpty()) {
+                job = victim.jobs.back();
+                victim.jobs.pop_back();
+            }
+        }
+
+        if (job < 0) return false;
+
+        (*m_job)(job);
+
+        if (m_remaining.fetch_sub(1) == 1) {
+            std::lock_guard lock(m_mutex);
+            m_done.notify_all();
+        }
+        return true;
+    }
+}
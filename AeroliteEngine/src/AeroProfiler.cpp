@@ -0,0 +1,166 @@
+#include <algorithm>
+#include "AeroProfiler.h"
+
+namespace Aerolite {
+
+    AeroProfiler::AeroProfiler(const std::size_t capacity)
+    {
+        SetCapacity(capacity);
+    }
+
+    void AeroProfiler::Clear()
+    {
+        m_head = 0;
+        m_size = 0;
+        m_stepCount = 0;
+        m_current = AeroStepProfile();
+    }
+
+    std::size_t AeroProfiler::GetCapacity() const
+    {
+        return m_history.size();
+    }
+
+    void AeroProfiler::SetCapacity(const std::size_t capacity)
+    {
+        m_history.assign(std::max<std::size_t>(capacity, 1), AeroStepProfile());
+        Clear();
+    }
+
+    void AeroProfiler::BeginStep()
+    {
+        m_current = AeroStepProfile();
+        m_current.step = m_stepCount;
+        m_stepStart = Clock::now();
+    }
+
+    void AeroProfiler::EndStep()
+    {
+        m_current.total_ms = std::chrono::duration<double, std::milli>(Clock::now() - m_stepStart).count();
+
+        m_history[m_head] = m_current;
+        m_head = (m_head + 1) % m_history.size();
+        m_size = std::min(m_size + 1, m_history.size());
+        m_stepCount++;
+    }
+
+    void AeroProfiler::BeginPhase(const ProfilePhase phase)
+    {
+        m_phaseStart[static_cast<std::size_t>(phase)] = Clock::now();
+    }
+
+    void AeroProfiler::EndPhase(const ProfilePhase phase)
+    {
+        const auto index = static_cast<std::size_t>(phase);
+        m_current.phase_ms[index] += std::chrono::duration<double, std::milli>(Clock::now() - m_phaseStart[index]).count();
+    }
+
+    AeroStepProfile& AeroProfiler::GetCurrentStep()
+    {
+        return m_current;
+    }
+
+    std::size_t AeroProfiler::GetHistorySize() const
+    {
+        return m_size;
+    }
+
+    const AeroStepProfile& AeroProfiler::GetHistory(const std::size_t index) const
+    {
+        // The oldest step sits right after the newest one once the buffer wrapped around.
+        const std::size_t oldest = (m_head + m_history.size() - m_size) % m_history.size();
+        return m_history[(oldest + index) % m_history.size()];
+    }
+
+    const AeroStepProfile& AeroProfiler::GetLastStep() const
+    {
+        static const AeroStepProfile empty;
+        if (m_size == 0) return empty;
+        return GetHistory(m_size - 1);
+    }
+
+    AeroStepProfile AeroProfiler::GetAverage() const
+    {
+        AeroStepProfile average;
+        if (m_size == 0) return average;
+
+        double pairs = 0, contacts = 0, constraints = 0, awakeBodies = 0, islands = 0;
+        for (std::size_t i = 0; i < m_size; i++) {
+            const AeroStepProfile& step = GetHistory(i);
+            average.total_ms += step.total_ms;
+            for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+                average.phase_ms[phase] += step.phase_ms[phase];
+            }
+            pairs += step.pair_count;
+            contacts += step.contact_count;
+            constraints += step.constraint_count;
+            awakeBodies += step.awake_body_count;
+            islands += step.island_count;
+        }
+
+        const auto count = static_cast<double>(m_size);
+        average.step = GetLastStep().step;
+        average.total_ms /= count;
+        for (auto& phase : average.phase_ms) {
+            phase /= count;
+        }
+        average.pair_count = static_cast<aero_uint32>(pairs / count);
+        average.contact_count = static_cast<aero_uint32>(contacts / count);
+        average.constraint_count = static_cast<aero_uint32>(constraints / count);
+        average.awake_body_count = static_cast<aero_uint32>(awakeBodies / count);
+        average.island_count = static_cast<aero_uint32>(islands / count);
+        return average;
+    }
+
+    void AeroProfiler::WriteCsv(std::ostream& out) const
+    {
+        out << "step,total_ms";
+        for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            out << ',' << GetPhaseName(static_cast<ProfilePhase>(phase)) << "_ms";
+        }
+        out << ",pairs,contacts,constraints,awake_bodies,islands\n";
+
+        for (std::size_t i = 0; i < m_size; i++) {
+            const AeroStepProfile& step = GetHistory(i);
+            out << step.step << ',' << step.total_ms;
+            for (const double phase : step.phase_ms) {
+                out << ',' << phase;
+            }
+            out << ',' << step.pair_count << ',' << step.contact_count << ',' << step.constraint_count
+                << ',' << step.awake_body_count << ',' << step.island_count << '\n';
+        }
+    }
+
+    void AeroProfiler::WriteJson(std::ostream& out) const
+    {
+        out << '[';
+        for (std::size_t i = 0; i < m_size; i++) {
+            const AeroStepProfile& step = GetHistory(i);
+            out << (i == 0 ? "\n" : ",\n");
+            out << "  {\"step\": " << step.step << ", \"total_ms\": " << step.total_ms << ", \"phases_ms\": {";
+            for (std::size_t phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+                out << (phase == 0 ? "" : ", ") << '"' << GetPhaseName(static_cast<ProfilePhase>(phase)) << "\": " << step.phase_ms[phase];
+            }
+            out << "}, \"pairs\": " << step.pair_count << ", \"contacts\": " << step.contact_count
+                << ", \"constraints\": " << step.constraint_count << ", \"awake_bodies\": " << step.awake_body_count
+                << ", \"islands\": " << step.island_count << '}';
+        }
+        out << (m_size == 0 ? "]\n" : "\n]\n");
+    }
+
+    const char* AeroProfiler::GetPhaseName(const ProfilePhase phase)
+    {
+        switch (phase) {
+        case ProfilePhase::Forces: return "forces";
+        case ProfilePhase::IntegrateForces: return "integrate_forces";
+        case ProfilePhase::BroadPhase: return "broad_phase";
+        case ProfilePhase::NarrowPhase: return "narrow_phase";
+        case ProfilePhase::Islands: return "islands";
+        case ProfilePhase::PreSolve: return "pre_solve";
+        case ProfilePhase::Solve: return "solve";
+        case ProfilePhase::IntegrateVelocities: return "integrate_velocities";
+        case ProfilePhase::Particles: return "particles";
+        default: return "unknown";
+        }
+    }
+}
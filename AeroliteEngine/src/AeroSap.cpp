@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cassert>
+#include "AeroSap.h"
+
+namespace Aerolite
+{
+	void AeroSap::Clear()
+	{
+		m_proxies.clear();
+		m_freeProxies.clear();
+		m_destroyedProxies.clear();
+		m_proxyCount = 0;
+		m_createdCount = 0;
+		m_axes[0].clear();
+		m_axes[1].clear();
+		m_pairs.clear();
+	}
+
+	aero_int32 AeroSap::CreateProxy(const AeroAABB2D& aabb, const aero_int32 userData)
+	{
+		aero_int32 proxyId;
+		if (!m_freeProxies.empty())
+		{
+			proxyId = m_freeProxies.back();
+			m_freeProxies.pop_back();
+		}
+		else
+		{
+			proxyId = static_cast<aero_int32>(m_proxies.size());
+			m_proxies.emplace_back();
+		}
+
+		Proxy& proxy = m_proxies[proxyId];
+		proxy.aabb = aabb;
+		proxy.userData = userData;
+		proxy.pairCount = 0;
+		proxy.alive = true;
+
+		// Appended after every other end point, the new interval overlaps nothing until it is sorted in.
+		const auto data = static_cast<aero_uint32>(proxyId) << 1;
+		m_axes[0].push_back({ aabb.min.x, data });
+		m_axes[0].push_back({ aabb.max.x, data | 1 });
+		m_axes[1].push_back({ aabb.min.y, data });
+		m_axes[1].push_back({ aabb.max.y, data | 1 });
+
+		++m_proxyCount;
+		++m_createdCount;
+		return proxyId;
+	}
+
+	void AeroSap::DestroyProxy(const aero_int32 proxyId)
+	{
+		assert(IsProxyValid(proxyId));
+		m_proxies[proxyId].alive = false;
+		m_destroyedProxies.push_back(proxyId);
+		--m_proxyCount;
+	}
+
+	void AeroSap::MoveProxy(const aero_int32 proxyId, const AeroAABB2D& aabb)
+	{
+		assert(IsProxyValid(proxyId));
+		m_proxies[proxyId].aabb = aabb;
+	}
+
+	bool AeroSap::IsProxyValid(const aero_int32 proxyId) const
+	{
+		return proxyId >= 0 && proxyId < static_cast<aero_int32>(m_proxies.size()) && m_proxies[proxyId].alive;
+	}
+
+	const AeroAABB2D& AeroSap::GetAABB(const aero_int32 proxyId) const
+	{
+		assert(IsProxyValid(proxyId));
+		return m_proxies[proxyId].aabb;
+	}
+
+	aero_int32 AeroSap::GetUserData(const aero_int32 proxyId) const
+	{
+		assert(IsProxyValid(proxyId));
+		return m_proxies[proxyId].userData;
+	}
+
+	void AeroSap::SetUserData(const aero_int32 proxyId, const aero_int32 userData)
+	{
+		assert(IsProxyValid(proxyId));
+		m_proxies[proxyId].userData = userData;
+	}
+
+	void AeroSap::EndUpdate()
+	{
+		// Drop the end points and pairs of destroyed proxies before their ids can be reused.
+		if (!m_destroyedProxies.empty())
+		{
+			const auto dead = [this](const EndPoint& point) { return !m_proxies[point.GetProxy()].alive; };
+			std::erase_if(m_axes[0], dead);
+			std::erase_if(m_axes[1], dead);
+			std::erase_if(m_pairs, [this](const aero_uint64 key)
+			{
+				Proxy& a = m_proxies[key >> 32];
+				Proxy& b = m_proxies[key & 0xFFFFFFFF];
+				if (a.alive && b.alive) return false;
+				a.pairCount--;
+				b.pairCount--;
+				return true;
+			});
+
+			m_freeProxies.insert(m_freeProxies.end(), m_destroyedProxies.begin(), m_destroyedProxies.end());
+			m_destroyedProxies.clear();
+		}
+
+		// Sorting many new proxies in one by one is quadratic, so start over when a large share of them is new.
+		if (m_createdCount * 4 > m_proxyCount)
+		{
+			Rebuild();
+		}
+		else
+		{
+			RefreshValues(m_axes[0], 0);
+			RefreshValues(m_axes[1], 1);
+			InsertionSort(m_axes[0]);
+			InsertionSort(m_axes[1]);
+		}
+		m_createdCount = 0;
+	}
+
+	aero_int32 AeroSap::GetProxyCount() const
+	{
+		return m_proxyCount;
+	}
+
+	std::size_t AeroSap::GetPairCount() const
+	{
+		return m_pairs.size();
+	}
+
+	bool AeroSap::Less(const EndPoint& a, const EndPoint& b)
+	{
+		// Begin points go first on ties, so touching intervals overlap just like AeroAABB2D::Intersects.
+		return a.value < b.value || (a.value == b.value && !a.IsMax() && b.IsMax());
+	}
+
+	void AeroSap::RefreshValues(std::vector<EndPoint>& axis, const int axisIndex) const
+	{
+		for (EndPoint& point : axis)
+		{
+			const AeroAABB2D& aabb = m_proxies[point.GetProxy()].aabb;
+			const AeroVec2& corner = point.IsMax() ? aabb.max : aabb.min;
+			point.value = axisIndex == 0 ? corner.x : corner.y;
+		}
+	}
+
+	void AeroSap::InsertionSort(std::vector<EndPoint>& axis)
+	{
+		for (std::size_t i = 1; i < axis.size(); ++i)
+		{
+			const EndPoint point = axis[i];
+			std::size_t j = i;
+			while (j > 0 && Less(point, axis[j - 1]))
+			{
+				const EndPoint& other = axis[j - 1];
+				if (point.IsMax() != other.IsMax())
+				{
+					const aero_int32 proxyA = point.GetProxy();
+					const aero_int32 proxyB = other.GetProxy();
+					if (!point.IsMax())
+					{
+						// A begin point passed an end point: the intervals started overlapping on this axis.
+						// Every AABB is already up to date, so the test on both axes gives the final answer.
+						if (m_proxies[proxyA].aabb.Intersects(m_proxies[proxyB].aabb))
+						{
+							AddPair(proxyA, proxyB);
+						}
+					}
+					else
+					{
+						// An end point passed a begin point: the intervals stopped overlapping on this axis.
+						RemovePair(proxyA, proxyB);
+					}
+				}
+
+				axis[j] = axis[j - 1];
+				--j;
+			}
+			axis[j] = point;
+		}
+	}
+
+	void AeroSap::Rebuild()
+	{
+		RefreshValues(m_axes[0], 0);
+		RefreshValues(m_axes[1], 1);
+		std::sort(m_axes[0].begin(), m_axes[0].end(), Less);
+		std::sort(m_axes[1].begin(), m_axes[1].end(), Less);
+
+		// Sweep along x, testing every interval that opens against the intervals that are still open.
+		m_pairs.clear();
+		m_active.clear();
+		for (Proxy& proxy : m_proxies)
+		{
+			proxy.pairCount = 0;
+		}
+
+		for (const EndPoint& point : m_axes[0])
+		{
+			const aero_int32 proxyId = point.GetProxy();
+			if (point.IsMax())
+			{
+				const auto it = std::find(m_active.begin(), m_active.end(), proxyId);
+				*it = m_active.back();
+				m_active.pop_back();
+				continue;
+			}
+
+			const AeroAABB2D& aabb = m_proxies[proxyId].aabb;
+			for (const aero_int32 activeId : m_active)
+			{
+				if (aabb.Intersects(m_proxies[activeId].aabb))
+				{
+					AddPair(proxyId, activeId);
+				}
+			}
+			m_active.push_back(proxyId);
+		}
+	}
+
+	void AeroSap::AddPair(const aero_int32 proxyA, const aero_int32 proxyB)
+	{
+		if (m_pairs.insert(ComputePairKey(proxyA, proxyB)).second)
+		{
+			m_proxies[proxyA].pairCount++;
+			m_proxies[proxyB].pairCount++;
+		}
+	}
+
+	void AeroSap::RemovePair(const aero_int32 proxyA, const aero_int32 proxyB)
+	{
+		// Most intervals that pass each other never overlapped on the other axis, skip the lookup when possible.
+		if (m_proxies[proxyA].pairCount == 0 || m_proxies[proxyB].pairCount == 0) return;
+
+		if (m_pairs.erase(ComputePairKey(proxyA, proxyB)) != 0)
+		{
+			m_proxies[proxyA].pairCount--;
+			m_proxies[proxyB].pairCount--;
+		}
+	}
+
+	aero_uint64 AeroSap::ComputePairKey(const aero_int32 a, const aero_int32 b)
+	{
+		const auto lo = static_cast<aero_uint64>(std::min(a, b));
+		const auto hi = static_cast<aero_uint64>(std::max(a, b));
+		return (lo << 32) | hi;
+	}
+}
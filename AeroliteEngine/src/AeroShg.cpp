@@ -1,4 +1,6 @@
 // ReSharper disable All
+#include <algorithm>
+#include <cmath>
 #include "AeroShg.h"
 
 namespace Aerolite
@@ -8,29 +10,13 @@ namespace Aerolite
 		m_bounds = AeroAABB2D({0, 0}, {1920, 1080});
 		m_cellWidth = 10;
 		m_cellHeight = 10;
-		m_invCellWidth = 1.0f / m_cellWidth;
-		m_invCellHeight = 1.0f / m_cellHeight;
-		m_cols = static_cast<uint32_t>(std::ceil(m_bounds.Width() * m_invCellWidth));
-		m_rows = static_cast<uint32_t>(std::ceil(m_bounds.Height() * m_invCellHeight));
+		ResizeGrid();
 	}
 
 	AeroShg::AeroShg(const AeroAABB2D& bounds, const real cellWidth, const real cellHeight)
 		: m_bounds(bounds), m_cellWidth(cellWidth), m_cellHeight(cellHeight)
 	{
-		m_invCellWidth = 1.0f / m_cellWidth;
-		m_invCellHeight = 1.0f / m_cellHeight;
-		m_cols = static_cast<uint32_t>(std::ceil(bounds.Width() / cellWidth));
-		m_rows = static_cast<uint32_t>(std::ceil(bounds.Height() / cellHeight));
-	}
-
-	AeroShg::~AeroShg()
-	{
-		for(const auto& cell : m_cells)
-		{
-			delete cell.second;
-		}
-
-		m_cells.clear();
+		ResizeGrid();
 	}
 
 	real AeroShg::GetCellWidth() const
@@ -43,6 +29,16 @@ namespace Aerolite
 		return m_cellHeight;
 	}
 
+	aero_int32 AeroShg::GetColumnCount() const
+	{
+		return static_cast<aero_int32>(m_cols);
+	}
+
+	aero_int32 AeroShg::GetRowCount() const
+	{
+		return static_cast<aero_int32>(m_rows);
+	}
+
 	void AeroShg::SetBounds(const AeroVec2& minPoint, const AeroVec2& maxPoint)
 	{
 		m_bounds = AeroAABB2D(minPoint, maxPoint);
@@ -67,88 +63,87 @@ namespace Aerolite
 		ResizeGrid();
 	}
 
-	void AeroShg::Place(const std::vector<std::shared_ptr<AeroBody2D>>& bodies) {
-		for (const auto& body : bodies) { // body is a raw pointer
-			const auto bodyAabb = body->GetAABB();
-			auto [minX, minY, maxX, maxY] = ComputeCellRange(bodyAabb);
+	void AeroShg::Place(const std::span<const AeroAABB2D> aabbs) {
+		const auto bodyCount = static_cast<aero_int32>(aabbs.size());
+		const std::size_t cellCount = static_cast<std::size_t>(m_cols) * m_rows;
+		m_cellStart.assign(cellCount + 1, 0);
 
+		// Count the bodies of every cell, one slot ahead so the prefix sum yields the start offsets.
+		for (aero_int32 i = 0; i < bodyCount; ++i) {
+			auto [minX, minY, maxX, maxY] = ComputeCellRange(aabbs[i]);
 			for (int y = minY; y <= maxY; ++y) {
 				for (int x = minX; x <= maxX; ++x) {
-					const auto key = ComputeCellKey(x, y);
-					InsertBodyIntoCell(key, body); // Adjusted to accept raw pointer
+					m_cellStart[ComputeCellKey(x, y) + 1]++;
 				}
 			}
 		}
+
+		for (std::size_t cell = 1; cell <= cellCount; ++cell) {
+			m_cellStart[cell] += m_cellStart[cell - 1];
+		}
+
+		// Scatter the indices. Every cell's offset is advanced past its bodies and restored afterwards.
+		m_cellBodies.resize(m_cellStart[cellCount]);
+		for (aero_int32 i = 0; i < bodyCount; ++i) {
+			auto [minX, minY, maxX, maxY] = ComputeCellRange(aabbs[i]);
+			for (int y = minY; y <= maxY; ++y) {
+				for (int x = minX; x <= maxX; ++x) {
+					m_cellBodies[m_cellStart[ComputeCellKey(x, y)]++] = i;
+				}
+			}
+		}
+
+		for (std::size_t cell = cellCount; cell > 0; --cell) {
+			m_cellStart[cell] = m_cellStart[cell - 1];
+		}
+		m_cellStart[0] = 0;
 	}
 
-	std::vector<std::shared_ptr<AeroBody2D>> AeroShg::GetNeighbors(const aero_int16 x0, const aero_int16 y0) const
+	std::span<const aero_int32> AeroShg::GetNeighbors(const aero_int32 x0, const aero_int32 y0) const
 	{
 		return GetCellContent(x0, y0);
 	}
 
 	std::tuple<int, int, int, int> AeroShg::ComputeCellRange(const AeroAABB2D& aabb) const
 	{
-		// Convert AABB min and max points to cell coordinates
-		int minX = static_cast<int>((aabb.min.x - m_bounds.min.x) * m_invCellWidth);
-		int minY = static_cast<int>((aabb.min.y - m_bounds.min.y) * m_invCellHeight);
-		int maxX = static_cast<int>((aabb.max.x - m_bounds.min.x) * m_invCellWidth);
-		int maxY = static_cast<int>((aabb.max.y - m_bounds.min.y) * m_invCellHeight);
-
-		// Clamp values to ensure they're within the bounds of the grid
-		minX = std::max(minX, 0);
-		minY = std::max(minY, 0);
-		maxX = std::min(maxX, static_cast<int>(m_cols) - 1);
-		maxY = std::min(maxY, static_cast<int>(m_rows) - 1);
+		// Convert AABB min and max points to cell coordinates, clamped to the grid
+		const int minX = ToCell(aabb.min.x, m_bounds.min.x, m_invCellWidth, m_cols);
+		const int minY = ToCell(aabb.min.y, m_bounds.min.y, m_invCellHeight, m_rows);
+		const int maxX = ToCell(aabb.max.x, m_bounds.min.x, m_invCellWidth, m_cols);
+		const int maxY = ToCell(aabb.max.y, m_bounds.min.y, m_invCellHeight, m_rows);
 
 		return { minX, minY, maxX, maxY };
 	}
 
-	std::vector<std::shared_ptr<AeroBody2D>> AeroShg::GetCellContent(const aero_int16 x, const aero_int16 y) const
+	std::span<const aero_int32> AeroShg::GetCellContent(const aero_int32 x, const aero_int32 y) const
 	{
 		const auto cellKey = ComputeCellKey(x, y);
-		// Check if the cell content is already in the cache
-		const auto it = m_cellContentCache.find(cellKey);
-		if (it != m_cellContentCache.end()) {
-			return it->second; // Return the cached result
-		}
-
-		// If not cached, perform the usual lookup
-		const auto contentIt = m_cells.find(cellKey);
-		if (contentIt != m_cells.end()) {
-			// Cache the result before returning
-			m_cellContentCache[cellKey] = contentIt->second->bodies;
-			return contentIt->second->bodies;
-		}
-
-		// Cache an empty vector for cells that are looked up but not found
-		m_cellContentCache[cellKey] = {};
-		return {};
-	}
-
-	void AeroShg::ClearCellContentCache() const
-	{
-		m_cellContentCache.clear();
+		const aero_int32 begin = m_cellStart[cellKey];
+		return { m_cellBodies.data() + begin, static_cast<std::size_t>(m_cellStart[cellKey + 1] - begin) };
 	}
 
 	void AeroShg::ResizeGrid()
 	{
 		m_invCellWidth = 1.0f / m_cellWidth;
 		m_invCellHeight = 1.0f / m_cellHeight;
-		m_cols = static_cast<uint32_t>(std::ceil(m_bounds.Width() * m_invCellWidth));
-		m_rows = static_cast<uint32_t>(std::ceil(m_bounds.Height() * m_invCellHeight));
+		m_cols = std::max(1u, static_cast<aero_uint32>(std::ceil(m_bounds.Width() * m_invCellWidth)));
+		m_rows = std::max(1u, static_cast<aero_uint32>(std::ceil(m_bounds.Height() * m_invCellHeight)));
+
+		// Nothing is placed in the resized grid until the next call to Place.
+		m_cellStart.assign(static_cast<std::size_t>(m_cols) * m_rows + 1, 0);
 	}
 
-	aero_uint32 AeroShg::ComputeCellKey(const aero_int16 x, const aero_int16 y) const
+	int AeroShg::ToCell(const real value, const real origin, const real invCellSize, const aero_uint32 cellCount)
 	{
-		return y * m_rows + x;
+		// Clamp before converting, so coordinates far outside the grid cannot overflow the int.
+		const real cell = (value - origin) * invCellSize;
+		if (!(cell >= 0)) return 0;
+		if (cell >= static_cast<real>(cellCount)) return static_cast<int>(cellCount) - 1;
+		return static_cast<int>(cell);
 	}
 
-	void AeroShg::InsertBodyIntoCell(const aero_uint32 key, const std::shared_ptr<AeroBody2D>& body)
+	aero_uint32 AeroShg::ComputeCellKey(const aero_int32 x, const aero_int32 y) const
 	{
-		if (!m_cells.contains(key)) 
-		{
-			m_cells[key] = new Cell(); // Allocate a new Cell if it doesn't exist
-		}
-		m_cells[key]->bodies.push_back(body); // Add the body to the cell
+		return y * m_cols + x;
 	}
 }
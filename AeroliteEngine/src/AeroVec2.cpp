@@ -13,8 +13,8 @@ namespace Aerolite {
         if (std::is_same_v<real, float>)
         {
             return AeroVec2(
-                x * std::cosf(angle) - y * std::sinf(angle), // New x coordinate.
-                x * std::sinf(angle) + y * std::cosf(angle)  // New y coordinate.
+                x * std::cos(angle) - y * std::sin(angle), // New x coordinate.
+                x * std::sin(angle) + y * std::cos(angle)  // New y coordinate.
             );
         }
         else
@@ -64,7 +64,7 @@ namespace Aerolite {
         const real dx = v.x - x;
         const real dy = v.y - y;
         if (std::is_same_v<real, float>) {
-            return std::sqrtf(dx * dx + dy * dy);
+            return std::sqrt(dx * dx + dy * dy);
         }
         else if (std::is_same_v<real, double>) {
             return std::sqrt(dx * dx + dy * dy);
@@ -1,7 +1,8 @@
 #include "AeroWorld2D.h"
 #include "Collision2D.h"
 #include "Constants.h"
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace Aerolite {
@@ -10,47 +11,46 @@ namespace Aerolite {
     {
     }
 
+    AeroWorld2D::~AeroWorld2D()
+    {
+        CompletePendingStep();
+        if (m_stepThread.joinable()) {
+            {
+                std::lock_guard lock(m_stepMutex);
+                m_stopStepThread = true;
+            }
+            m_stepWake.notify_one();
+            m_stepThread.join();
+        }
+    }
+
     void AeroWorld2D::ClearWorld()
     {
-        m_bodies.clear();
+        WaitForStep();
+        m_bodies.Clear();
         m_broadphasePairs.clear();
         m_constraints.clear();
-        m_contactsList.clear();
+        m_contacts.clear();
         m_globalForces.clear();
         m_particles.clear();
+        m_accumulator = 0;
+        m_bvh.Clear();
+        m_sap.Clear();
+        m_manifolds.Clear();
+        m_islands.Clear();
     }
 
-    std::shared_ptr<AeroBody2D> AeroWorld2D::CreateBody2D(const std::shared_ptr<Shape>& shape, const real x, const real y, const real mass)
+    AeroBody2D* AeroWorld2D::CreateBody2D(const std::shared_ptr<const Shape>& shape, const real x, const real y, const real mass)
     {
-        std::shared_ptr<AeroBody2D> body;
-        // Check the type of the shape and create the corresponding derived shape
-        if (std::dynamic_pointer_cast<CircleShape>(shape) != nullptr) {
-	        const auto concreteShape = std::dynamic_pointer_cast<CircleShape>(shape);
-        	body = std::make_shared<AeroBody2D>(shape, x, y, mass);
-            m_bodies.push_back(body);
-            return body;
-        }
-        else if (std::dynamic_pointer_cast<PolygonShape>(shape) != nullptr) {
-	        const auto concreteShape = std::dynamic_pointer_cast<PolygonShape>(shape);
-            body = std::make_shared<AeroBody2D>(shape, x, y, mass);
-            m_bodies.push_back(body);
-            return body;
-        }
-        else if (std::dynamic_pointer_cast<BoxShape>(shape) != nullptr) {
-	        const auto concreteShape = std::dynamic_pointer_cast<BoxShape>(shape);
-            body = std::make_shared<AeroBody2D>(shape, x, y, mass);
-            m_bodies.push_back(body);
-            return body;
-        }
-        else {
-            // Handle unknown shape type or add additional checks for other shape types
-            // You may throw an exception, return nullptr, or handle it in another way.
+        // Every shape type is either a circle or a polygon (boxes are polygons), bodies need nothing else.
+        if (shape == nullptr) {
+            return nullptr;
         }
 
-        return body;
+        return m_bodies.Create(shape, x, y, mass);
     }
 
-    void AeroWorld2D::AddJointConstraint(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, const AeroVec2& anchorPoint) {
+    void AeroWorld2D::AddJointConstraint(AeroBody2D* a, AeroBody2D* b, const AeroVec2& anchorPoint) {
         m_constraints.push_back(std::make_unique<JointConstraint>(a, b, anchorPoint));
     }
 
@@ -73,6 +73,11 @@ namespace Aerolite {
         m_broadphasePairs.clear();
     }
 
+    AeroShg& AeroWorld2D::GetShg()
+    {
+        return m_shg;
+    }
+
     const AeroShg& AeroWorld2D::GetShg() const
     {
         return m_shg;
@@ -98,6 +103,103 @@ namespace Aerolite {
         m_shg.SetCellHeight(cellHeight);
     }
 
+    AeroBvh& AeroWorld2D::GetBvh()
+    {
+        return m_bvh;
+    }
+
+    const AeroBvh& AeroWorld2D::GetBvh() const
+    {
+        return m_bvh;
+    }
+
+    void AeroWorld2D::BvhSetFatMargin(const real margin)
+    {
+        m_bvh.SetFatMargin(margin);
+    }
+
+    void AeroWorld2D::BvhSetPredictionTime(const real seconds)
+    {
+        m_bvh.SetPredictionTime(seconds);
+    }
+
+    AeroSap& AeroWorld2D::GetSap()
+    {
+        return m_sap;
+    }
+
+    const AeroSap& AeroWorld2D::GetSap() const
+    {
+        return m_sap;
+    }
+
+    const AeroIslandManager2D& AeroWorld2D::GetIslands() const
+    {
+        return m_islands;
+    }
+
+    void AeroWorld2D::SetSleepingEnabled(const bool enabled)
+    {
+        m_islands.SetSleepingEnabled(enabled);
+    }
+
+    const AeroWorldSettings2D& AeroWorld2D::GetSettings() const
+    {
+        return m_settings;
+    }
+
+    void AeroWorld2D::SetSettings(const AeroWorldSettings2D& settings)
+    {
+        m_settings = settings;
+        m_settings.velocity_iterations = std::max(m_settings.velocity_iterations, 0);
+        m_settings.relax_iterations = std::max(m_settings.relax_iterations, 0);
+        m_settings.sub_steps = std::max(m_settings.sub_steps, 1);
+        m_settings.max_steps_per_frame = std::max(m_settings.max_steps_per_frame, 1);
+        if (!(m_settings.fixed_time_step > 0)) {
+            m_settings.fixed_time_step = AeroWorldSettings2D{}.fixed_time_step;
+        }
+    }
+
+    void AeroWorld2D::SleepSetLinearTolerance(const real tolerance)
+    {
+        m_islands.SetLinearSleepTolerance(tolerance);
+    }
+
+    void AeroWorld2D::SleepSetAngularTolerance(const real tolerance)
+    {
+        m_islands.SetAngularSleepTolerance(tolerance);
+    }
+
+    void AeroWorld2D::SleepSetTimeToSleep(const real seconds)
+    {
+        m_islands.SetTimeToSleep(seconds);
+    }
+
+    aero_int32 AeroWorld2D::GetWorkerCount() const
+    {
+        return m_jobPool.GetWorkerCount();
+    }
+
+    void AeroWorld2D::SetWorkerCount(const aero_int32 workerCount)
+    {
+        m_jobPool.SetWorkerCount(workerCount);
+    }
+
+    AeroProfiler& AeroWorld2D::GetProfiler()
+    {
+        return m_profiler;
+    }
+
+    const AeroProfiler& AeroWorld2D::GetProfiler() const
+    {
+        return m_profiler;
+    }
+
+    const AeroFrameArena& AeroWorld2D::GetFrameArena() const
+    {
+        return m_frameArena;
+    }
+
     void AeroWorld2D::CreateParticle2D(const real x, const real y, const real mass)
     {
         auto particle = std::make_shared<Particle2D>(x, y, mass);
@@ -118,36 +220,62 @@ namespace Aerolite {
         }
     }
 
+    void AeroWorld2D::RemoveBody2D(const AeroBodyHandle2D handle)
+    {
+        AeroBody2D* body = m_bodies.Get(handle);
+        if (body == nullptr) return;
+
+        // Whatever rested on the body has to react to it being gone.
+        m_islands.RemoveBody(*body);
+
+        // Joints do not own their bodies, so a joint to the removed body cannot be solved anymore.
+        if (!m_constraints.empty()) {
+            std::erase_if(m_constraints, [body](const std::unique_ptr<Constraint2D>& constraint) {
+                return constraint->a == body || constraint->b == body;
+            });
+        }
+
+        // The broad-phase proxies outlive the steps, so they have to go together with the body.
+        if (m_bvh.IsProxyValid(body->bvh_proxy)) {
+            m_bvh.DestroyProxy(body->bvh_proxy);
+        }
+        if (m_sap.IsProxyValid(body->sap_proxy)) {
+            m_sap.DestroyProxy(body->sap_proxy);
+        }
+
+        m_bodies.Destroy(handle);
+    }
+
     void AeroWorld2D::RemoveBody2D(const int index)
     {
         // Check if the index is within bounds
-        if (index < 0 || index >= m_bodies.size()) {
+        if (index < 0 || index >= static_cast<int>(m_bodies.GetSize())) {
             throw std::out_of_range("Index is out of range in RemoveBody2D");
         }
 
-        // Remove the element at the specified index
-        m_bodies.erase(m_bodies.begin() + index);
+        RemoveBody2D(m_bodies.GetBodies()[index]->handle);
     }
 
     void AeroWorld2D::RemoveBody2D(AeroBody2D* bodyToRemove) {
-	    const auto it = std::remove_if(m_bodies.begin(), m_bodies.end(),
-	                                   [bodyToRemove](const std::shared_ptr<AeroBody2D>& body) {
-		                                   return body.get() == bodyToRemove;
-	                                   });
-
-        if (it != m_bodies.end()) {
-            m_bodies.erase(it, m_bodies.end());
+        // Bodies that were already removed have a stale handle, so removing them twice does nothing.
+        if (bodyToRemove != nullptr && m_bodies.Get(bodyToRemove->handle) == bodyToRemove) {
+            RemoveBody2D(bodyToRemove->handle);
         }
     }
 
-	const std::vector<std::shared_ptr<AeroBody2D>>& AeroWorld2D::GetBodies() const
+    std::span<AeroBody2D* const> AeroWorld2D::GetBodies() const
     {
-        return m_bodies;
+        return m_bodies.GetBodies();
     }
 
-    std::vector<std::shared_ptr<AeroBody2D>>& AeroWorld2D::GetBodies()
+    std::span<const AeroAABB2D> AeroWorld2D::GetBodyAABBs() const
     {
-        return m_bodies;
+        return m_bodyAabbs;
+    }
+
+    AeroBody2D* AeroWorld2D::GetBody(const AeroBodyHandle2D handle) const
+    {
+        return m_bodies.Get(handle);
     }
 
     std::vector<Particle2D*> AeroWorld2D::GetParticle2Ds() const
@@ -160,22 +288,158 @@ namespace Aerolite {
         return pointers;
     }
 
-	std::vector<Contact2D> AeroWorld2D::GetContacts() const
+	std::span<const AeroContactRecord2D> AeroWorld2D::GetContacts() const
     {
-        return m_contactsList;
+        return m_contacts;
     }
 
     void AeroWorld2D::AddGlobalForce(const AeroVec2& force) {
         m_globalForces.push_back(force);
     }
 
+    bool AeroWorld2D::WakeTouchedIslands()
+    {
+        bool woke = false;
+
+        // Sleeping bodies are not integrated and sleeping pairs are skipped by the broad-phase, so a sleeping
+        // island has to be woken as a whole before it is touched by an awake body.
+        std::vector<Contact2D>& contacts = m_wakeContacts;
+        for (const auto& pair : m_broadphasePairs)
+        {
+            if (pair.a->IsSleeping() == pair.b->IsSleeping()) continue;
+
+            contacts.clear();
+            if (CollisionDetection2D::IsColliding(pair.a, pair.b, contacts))
+            {
+                woke |= m_islands.WakeIsland(pair.a->IsSleeping() ? *pair.a : *pair.b);
+            }
+        }
+
+        // Joints pull a sleeping body along as soon as the other end moves.
+        for (const auto& constraint : m_constraints) {
+            if (constraint->a->IsSleeping() && !constraint->b->IsSleeping() && !constraint->b->IsStatic()) {
+                woke |= m_islands.WakeIsland(*constraint->a);
+            }
+            else if (constraint->b->IsSleeping() && !constraint->a->IsSleeping() && !constraint->a->IsStatic()) {
+                woke |= m_islands.WakeIsland(*constraint->b);
+            }
+        }
+
+        return woke;
+    }
+
+    void AeroWorld2D::PreSolveConstraints(const std::span<const aero_int32> joints, const std::span<const aero_int32> contacts,
+                                          std::pmr::vector<PenetrationConstraint>& penetrations, const real dt)
+    {
+        // The Baumgarte factors are per update, every sub-step corrects its share of the error.
+        const real jointBeta = m_settings.joint_beta / m_settings.sub_steps;
+        const real contactBeta = m_settings.contact_beta / m_settings.sub_steps;
+
+        for (const aero_int32 joint : joints) {
+            m_constraints[joint]->PreSolve(dt, jointBeta);
+        }
+
+        for (const aero_int32 contact : contacts) {
+            penetrations[contact].PreSolve(dt, contactBeta);
+        }
+    }
+
+    void AeroWorld2D::SolveConstraints(const std::span<const aero_int32> joints, const std::span<const aero_int32> contacts,
+                                       std::pmr::vector<PenetrationConstraint>& penetrations)
+    {
+        for (const aero_int32 joint : joints) {
+            m_constraints[joint]->Solve();
+        }
+
+        for (const aero_int32 contact : contacts) {
+            penetrations[contact].Solve();
+        }
+    }
+
+    void AeroWorld2D::RelaxConstraints(const std::span<const aero_int32> joints, const std::span<const aero_int32> contacts,
+                                       std::pmr::vector<PenetrationConstraint>& penetrations)
+    {
+        for (const aero_int32 joint : joints) {
+            m_constraints[joint]->Relax();
+        }
+
+        for (const aero_int32 contact : contacts) {
+            penetrations[contact].Relax();
+        }
+    }
+
+    void AeroWorld2D::PostSolveConstraints(const std::span<const aero_int32> joints, const std::span<const aero_int32> contacts,
+                                           std::pmr::vector<PenetrationConstraint>& penetrations)
+    {
+        for (const aero_int32 joint : joints) {
+            m_constraints[joint]->PostSolve();
+        }
+
+        for (const aero_int32 contact : contacts) {
+            penetrations[contact].PostSolve();
+        }
+    }
+
+    template<typename Stage, typename BatchStage>
+    void AeroWorld2D::RunSolverStage(const aero_int32 iterations, const Stage& stage, const BatchStage& batchStage)
+    {
+        if (iterations <= 0) return;
+
+        // Islands that were not colored run every iteration on one worker, without waiting for the others.
+        const auto islands = m_graph.GetIslands();
+        m_jobPool.ParallelFor(static_cast<aero_int32>(islands.size()), [&](const aero_int32 index) {
+            const AeroIsland2D& island = m_islands.GetIsland(islands[index]);
+            for (aero_int32 i = 0; i < iterations; i++) {
+                stage(m_islands.GetJoints(island), m_islands.GetContacts(island));
+            }
+        });
+
+        // The colored islands iterate color by color. The constraints of a color share no dynamic body,
+        // so a color is cut into chunks for the workers and the workers meet after every color. A chunk of
+        // penetration constraints is made of whole batches.
+        constexpr std::size_t chunkSize = 32;
+        static_assert(chunkSize % AeroContactBatches2D::LANES == 0);
+        for (aero_int32 i = 0; i < iterations; i++) {
+            stage(m_graph.GetOverflowJoints(), m_graph.GetOverflowContacts());
+
+            for (aero_int32 color = 0; color < m_graph.GetColorCount(); color++) {
+                const auto joints = m_graph.GetJoints(color);
+                const auto contacts = m_graph.GetContacts(color);
+                const std::size_t jointChunks = (joints.size() + chunkSize - 1) / chunkSize;
+                const std::size_t contactChunks = (contacts.size() + chunkSize - 1) / chunkSize;
+
+                m_jobPool.ParallelFor(static_cast<aero_int32>(jointChunks + contactChunks), [&](const aero_int32 job) {
+                    const auto chunk = static_cast<std::size_t>(job);
+                    if (chunk < jointChunks) {
+                        const std::size_t first = chunk * chunkSize;
+                        stage(joints.subspan(first, std::min(chunkSize, joints.size() - first)), std::span<const aero_int32>());
+                    }
+                    else {
+                        const std::size_t first = (chunk - jointChunks) * chunkSize;
+                        batchStage(m_contactBatches.GetFirstBatch(color) + static_cast<aero_int32>(first / AeroContactBatches2D::LANES),
+                                   contacts.subspan(first, std::min(chunkSize, contacts.size() - first)));
+                    }
+                });
+            }
+        }
+    }
+
     void AeroWorld2D::Update(const real dt) {
-	    const auto startTime = std::chrono::high_resolution_clock::now();
-        // Create a vector of penetration constraint to be solved per frame
-        std::vector<PenetrationConstraint> penetrations;
+        AERO_PROFILE_STEP_BEGIN(m_profiler);
+
+        // The penetration constraints of the last update are gone, their memory is reused by this one.
+        m_frameArena.Reset();
+        std::pmr::vector<PenetrationConstraint> penetrations(&m_frameArena);
+
+        m_contacts.clear();
+
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Forces);
+        // Wake the islands of bodies that were pushed or woken by hand since the last update.
+        m_islands.WakeDisturbedIslands();
+
+        for (AeroBody2D* body : m_bodies.GetBodies()) {
+            if (body->IsSleeping()) continue;
 
-        m_contactsList.clear();
-        for (const auto& body : m_bodies) {
 	        auto weight = AeroVec2(0.0, body->mass * m_g * PIXELS_PER_METER);
             body->AddForce(weight);
 
@@ -183,82 +447,380 @@ namespace Aerolite {
                 body->AddForce(force);
             }
         }
-
-        for (const auto& body : m_bodies) {
-            body->IntegrateForces(dt);
+        AERO_PROFILE_END(m_profiler, ProfilePhase::Forces);
+
+        // The forces of the first sub-step are integrated before collision detection, as without sub-steps.
+        const aero_int32 subSteps = m_settings.sub_steps;
+        const real h = dt / subSteps;
+        const real stepFraction = make_real<real>(1.0) / subSteps;
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::IntegrateForces);
+        for (AeroBody2D* body : m_bodies.GetBodies()) {
+            body->IntegrateForces(h, stepFraction);
         }
+        AERO_PROFILE_END(m_profiler, ProfilePhase::IntegrateForces);
 
         // Broad phase detection
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::BroadPhase);
+        UpdateBodyAabbs();
         m_broadPhasePipeline.Execute(*this);
+        if (WakeTouchedIslands()) {
+            // The woken bodies have to find the pairs they have with the rest of their island.
+            m_broadPhasePipeline.Execute(*this);
+        }
+        AERO_PROFILE_END(m_profiler, ProfilePhase::BroadPhase);
 
-        /*std::cout << "Number of broadphase pairs: " << m_broadphasePairs.size() << std::endl;*/
         // Narrow phase detection
-        for(const auto& pair : m_broadphasePairs)
-        {
-            std::vector<Contact2D> contacts;
-            if (CollisionDetection2D::IsColliding(pair.a, pair.b, contacts))
-            {
-                m_contactsList.insert(m_contactsList.end(), contacts.begin(), contacts.end());
-                for (auto& contact : contacts) {
-					penetrations.emplace_back(contact.a, contact.b, contact.start, contact.end, contact.normal);
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::NarrowPhase);
+        NarrowPhase(penetrations);
+        if (m_settings.block_solver) {
+            m_manifolds.LinkBlocks(penetrations);
+        }
+        AERO_PROFILE_END(m_profiler, ProfilePhase::NarrowPhase);
+
+        // Islands share no dynamic body, so they are solved in parallel. Constraints of sleeping bodies
+        // belong to no island and are skipped, a joint to an awake body has woken them above.
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Islands);
+        m_islands.BuildIslands(m_bodies.GetBodies(), penetrations, m_constraints);
+        AERO_PROFILE_END(m_profiler, ProfilePhase::Islands);
+
+        const auto islandCount = static_cast<aero_int32>(m_islands.GetIslandCount());
+
+        // Large islands would keep a single worker busy, their constraints are colored to be solved by all of them.
+        // A single worker solves every island on its own anyway, packing the colors would only add work.
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Islands);
+        const aero_int32 coloringThreshold = m_jobPool.GetWorkerCount() > 1 ? m_settings.coloring_threshold : 0;
+        m_graph.Build(m_islands, penetrations, m_constraints, coloringThreshold);
+        m_contactBatches.Build(m_graph);
+        AERO_PROFILE_END(m_profiler, ProfilePhase::Islands);
+
+        // Every sub-step measures the constraints again at the integrated positions, the contact points
+        // found above stay attached to their bodies. Accumulated impulses carry over as warm start.
+        for (aero_int32 subStep = 0; subStep < subSteps; subStep++) {
+            if (subStep > 0) {
+                AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::IntegrateForces);
+                for (AeroBody2D* body : m_bodies.GetBodies()) {
+                    body->IntegrateForces(h, stepFraction);
                 }
+                AERO_PROFILE_END(m_profiler, ProfilePhase::IntegrateForces);
             }
+
+            // The colored penetration constraints are packed once presolved and solved in their batches. From the
+            // second sub-step on, the impulses they accumulated are written back first for the warm start.
+            AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::PreSolve);
+            RunSolverStage(1, [&](const auto joints, const auto contacts) {
+                PreSolveConstraints(joints, contacts, penetrations, h);
+            }, [&](const aero_int32 firstBatch, const auto contacts) {
+                if (subStep > 0) {
+                    m_contactBatches.Unpack(firstBatch, contacts);
+                }
+                PreSolveConstraints({}, contacts, penetrations, h);
+                m_contactBatches.Pack(firstBatch, contacts, penetrations);
+            });
+            AERO_PROFILE_END(m_profiler, ProfilePhase::PreSolve);
+
+            AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Solve);
+            RunSolverStage(m_settings.velocity_iterations, [&](const auto joints, const auto contacts) {
+                SolveConstraints(joints, contacts, penetrations);
+            }, [&](const aero_int32 firstBatch, const auto contacts) {
+                m_contactBatches.Solve(m_bodies.GetStates(), firstBatch, contacts, true);
+            });
+            AERO_PROFILE_END(m_profiler, ProfilePhase::Solve);
+
+            AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::IntegrateVelocities);
+            for (AeroBody2D* body : m_bodies.GetBodies()) {
+                body->IntegrateVelocities(h);
+            }
+            AERO_PROFILE_END(m_profiler, ProfilePhase::IntegrateVelocities);
+
+            AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Solve);
+            RunSolverStage(m_settings.relax_iterations, [&](const auto joints, const auto contacts) {
+                RelaxConstraints(joints, contacts, penetrations);
+            }, [&](const aero_int32 firstBatch, const auto contacts) {
+                m_contactBatches.Solve(m_bodies.GetStates(), firstBatch, contacts, false);
+            });
+            AERO_PROFILE_END(m_profiler, ProfilePhase::Solve);
         }
 
-        for (const auto& constraint : m_constraints) {
-            constraint->PreSolve(dt);
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Solve);
+        RunSolverStage(1, [&](const auto joints, const auto contacts) {
+            PostSolveConstraints(joints, contacts, penetrations);
+        }, [&](const aero_int32 firstBatch, const auto contacts) {
+            m_contactBatches.Unpack(firstBatch, contacts);
+            PostSolveConstraints({}, contacts, penetrations);
+        });
+        m_manifolds.StoreImpulses(penetrations);
+        // Every contact point created one penetration constraint, in the same order.
+        for (std::size_t i = 0; i < m_contacts.size(); ++i) {
+            m_contacts[i].normal_impulse = penetrations[i].GetNormalImpulse();
+            m_contacts[i].tangent_impulse = penetrations[i].GetTangentImpulse();
         }
+        m_manifolds.EndStep();
+        AERO_PROFILE_END(m_profiler, ProfilePhase::Solve);
+
+        for (AeroBody2D* body : m_bodies.GetBodies()) {
+            body->ClearForces();
+            body->ClearTorque();
+        }
+
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Islands);
+        m_islands.UpdateSleep(dt);
+        AERO_PROFILE_END(m_profiler, ProfilePhase::Islands);
 
-        for (auto& constraint : penetrations) {
-            constraint.PreSolve(dt);
+        AERO_PROFILE_BEGIN(m_profiler, ProfilePhase::Particles);
+        for (const auto& particle : m_particles) {
+	        auto weight = AeroVec2(0.0, particle->mass * m_g * PIXELS_PER_METER);
+            particle->ApplyForce(weight);
+            particle->Integrate(dt);
         }
+        AERO_PROFILE_END(m_profiler, ProfilePhase::Particles);
+
+        AERO_PROFILE_COUNTER(m_profiler, pair_count, m_broadphasePairs.size());
+        AERO_PROFILE_COUNTER(m_profiler, contact_count, m_contacts.size());
+        AERO_PROFILE_COUNTER(m_profiler, constraint_count, penetrations.size() + m_constraints.size());
+        AERO_PROFILE_COUNTER(m_profiler, awake_body_count, m_islands.GetAwakeBodyCount());
+        AERO_PROFILE_COUNTER(m_profiler, island_count, islandCount);
+        AERO_PROFILE_STEP_END(m_profiler);
+    }
 
-        for (int i = 0; i < 3; i++) {
-            for (const auto& constraint : m_constraints) {
-                constraint->Solve();
+    void AeroWorld2D::UpdateBodyAabbs()
+    {
+        // Waking bodies does not move them, so the boxes stay valid when the broad-phase runs again.
+        const std::span<AeroBody2D* const> bodies = m_bodies.GetBodies();
+        m_bodyAabbs.resize(bodies.size());
+        const std::size_t chunkCount = (bodies.size() + AABB_CHUNK_SIZE - 1) / AABB_CHUNK_SIZE;
+        m_jobPool.ParallelFor(static_cast<aero_int32>(chunkCount), [&](const aero_int32 job) {
+            const std::size_t begin = job * AABB_CHUNK_SIZE;
+            const std::size_t end = std::min(begin + AABB_CHUNK_SIZE, bodies.size());
+            for (std::size_t i = begin; i < end; ++i) {
+                m_bodyAabbs[i] = bodies[i]->GetAABB();
             }
+        });
+    }
 
-            for (auto& constraint : penetrations) {
-                constraint.Solve();
+    void AeroWorld2D::NarrowPhase(std::pmr::vector<PenetrationConstraint>& penetrations)
+    {
+        const std::size_t pairCount = m_broadphasePairs.size();
+        const auto kernelIndex = [](const BroadPhasePair& pair) {
+            return CollisionDetection2D::GetKernelIndex(pair.a->shape->GetType(), pair.b->shape->GetType());
+        };
+
+        // Counting sort of the pairs by kernel. Pairs with a sleeping body were already found not to touch when waking islands.
+        std::array<std::size_t, CollisionDetection2D::KERNEL_COUNT + 1> kernelStart{};
+        for (const BroadPhasePair& pair : m_broadphasePairs) {
+            if (pair.a->IsSleeping() || pair.b->IsSleeping()) continue;
+            kernelStart[kernelIndex(pair) + 1]++;
+        }
+        for (aero_int32 kernel = 0; kernel < CollisionDetection2D::KERNEL_COUNT; ++kernel) {
+            kernelStart[kernel + 1] += kernelStart[kernel];
+        }
+        std::array<std::size_t, CollisionDetection2D::KERNEL_COUNT> kernelNext;
+        std::copy_n(kernelStart.begin(), kernelNext.size(), kernelNext.begin());
+        m_narrowPhasePairs.resize(kernelStart.back());
+        for (std::size_t i = 0; i < pairCount; ++i) {
+            const BroadPhasePair& pair = m_broadphasePairs[i];
+            if (pair.a->IsSleeping() || pair.b->IsSleeping()) continue;
+            m_narrowPhasePairs[kernelNext[kernelIndex(pair)]++] = static_cast<aero_int32>(i);
+        }
+
+        // Chunks never straddle two kernels, the kernel is looked up once per chunk.
+        std::size_t chunkCount = 0;
+        for (aero_int32 kernel = 0; kernel < CollisionDetection2D::KERNEL_COUNT; ++kernel) {
+            for (std::size_t begin = kernelStart[kernel]; begin < kernelStart[kernel + 1]; begin += NARROW_PHASE_CHUNK_SIZE) {
+                if (m_narrowPhaseChunks.size() == chunkCount) {
+                    m_narrowPhaseChunks.emplace_back();
+                }
+                NarrowPhaseChunk& chunk = m_narrowPhaseChunks[chunkCount++];
+                chunk.kernel_index = kernel;
+                chunk.kernel = CollisionDetection2D::GetKernel(kernel);
+                chunk.begin = begin;
+                chunk.end = std::min(begin + NARROW_PHASE_CHUNK_SIZE, kernelStart[kernel + 1]);
             }
         }
 
-        for (const auto& constraint : m_constraints) {
-            constraint->PostSolve();
+        // Collision detection only reads the bodies, so the chunks are independent. Every pair is in one chunk,
+        // so the jobs write distinct entries of m_pairContacts.
+        m_pairContacts.assign(pairCount, {});
+        m_jobPool.ParallelFor(static_cast<aero_int32>(chunkCount), [&](const aero_int32 job) {
+            NarrowPhaseChunk& chunk = m_narrowPhaseChunks[job];
+            chunk.contacts.clear();
+
+            // Circle pairs are tested several at a time, every overlapping pair gets exactly one contact.
+            if (chunk.kernel_index == CollisionDetection2D::GetKernelIndex(Circle, Circle)) {
+                std::array<AeroBody2D*, NARROW_PHASE_CHUNK_SIZE> a;
+                std::array<AeroBody2D*, NARROW_PHASE_CHUNK_SIZE> b;
+                std::array<aero_int32, NARROW_PHASE_CHUNK_SIZE> hits;
+                const std::size_t count = chunk.end - chunk.begin;
+                for (std::size_t k = 0; k < count; ++k) {
+                    const BroadPhasePair& pair = m_broadphasePairs[m_narrowPhasePairs[chunk.begin + k]];
+                    a[k] = pair.a;
+                    b[k] = pair.b;
+                }
+                const std::size_t hitCount = CollisionDetection2D::CollideCircleBatch(
+                    std::span(a).first(count), std::span(b).first(count), chunk.contacts, hits);
+                for (std::size_t hit = 0; hit < hitCount; ++hit) {
+                    m_pairContacts[m_narrowPhasePairs[chunk.begin + hits[hit]]] = { job, hit, 1 };
+                }
+                return;
+            }
+
+            for (std::size_t k = chunk.begin; k < chunk.end; ++k) {
+                const aero_int32 i = m_narrowPhasePairs[k];
+                const BroadPhasePair& pair = m_broadphasePairs[i];
+                const std::size_t first = chunk.contacts.size();
+                if (chunk.kernel(pair.a, pair.b, chunk.contacts)) {
+                    m_pairContacts[i] = { job, first, chunk.contacts.size() - first };
+                }
+                else {
+                    chunk.contacts.resize(first);
+                }
+            }
+        });
+
+        // The manifold cache is shared, so the manifolds are added on this thread in pair order.
+        // Block partners point at each other, so the constraints must not move once they are created.
+        std::size_t contactCount = 0;
+        for (std::size_t job = 0; job < chunkCount; ++job) {
+            contactCount += m_narrowPhaseChunks[job].contacts.size();
         }
+        penetrations.reserve(contactCount);
+        m_contacts.reserve(contactCount);
+        m_manifolds.BeginStep();
+        for (std::size_t i = 0; i < pairCount; ++i) {
+            const PairContacts& pairContacts = m_pairContacts[i];
+            if (pairContacts.chunk < 0) continue;
+
+            const auto contacts = std::span(m_narrowPhaseChunks[pairContacts.chunk].contacts).subspan(pairContacts.first, pairContacts.count);
+            for (const Contact2D& contact : contacts) {
+                AeroContactRecord2D& record = m_contacts.emplace_back();
+                record.a = contact.a->handle;
+                record.b = contact.b->handle;
+                record.start = contact.start;
+                record.end = contact.end;
+                record.normal = contact.normal;
+                record.depth = contact.depth;
+            }
+            // Creates the penetration constraints of the pair, warm started with the impulses of the previous step.
+            m_manifolds.AddManifold(m_broadphasePairs[i], contacts, penetrations);
+        }
+    }
 
-        for (auto& constraint : penetrations) {
-            constraint.PostSolve();
+    aero_int32 AeroWorld2D::Step(const real frameTime)
+    {
+        const real fixedDt = m_settings.fixed_time_step;
+        m_accumulator += std::max(frameTime, make_real<real>(0.0));
+
+        aero_int32 steps = 0;
+        while (m_accumulator >= fixedDt && steps < m_settings.max_steps_per_frame) {
+            for (AeroBody2D* body : m_bodies.GetBodies()) {
+                body->previous_position = body->GetPosition();
+                body->previous_rotation = body->GetRotation();
+            }
+            Update(fixedDt);
+            m_accumulator -= fixedDt;
+            ++steps;
         }
 
-        for (const auto& body : m_bodies) {
-            body->IntegrateVelocities(dt);
+        // Drop the whole steps the cap left, keeping the fraction so the interpolation does not jump.
+        if (m_accumulator >= fixedDt) {
+            m_accumulator = std::fmod(m_accumulator, fixedDt);
         }
+        return steps;
+    }
 
-        for (const auto& particle : m_particles) {
-	        auto weight = AeroVec2(0.0, particle->mass * m_g * PIXELS_PER_METER);
-            particle->ApplyForce(weight);
-            particle->Integrate(dt);
+    real AeroWorld2D::GetInterpolationAlpha() const
+    {
+        // The fixed step may have been made shorter since the last Step.
+        return std::min(m_accumulator / m_settings.fixed_time_step, make_real<real>(1.0));
+    }
+
+    std::shared_future<aero_int32> AeroWorld2D::StepAsync(const real frameTime)
+    {
+        CompletePendingStep();
+
+        // The step writes the back snapshot, which nobody reads until the step completes and it becomes the front.
+        AeroWorldSnapshot2D& back = m_snapshots[m_frontSnapshot ^ 1];
+        std::packaged_task<aero_int32()> task([this, frameTime, &back] {
+            const aero_int32 updateCount = Step(frameTime);
+            WriteSnapshot(back, updateCount);
+            return updateCount;
+        });
+        m_pendingStep = task.get_future().share();
+
+        if (!m_stepThread.joinable()) {
+            m_stepThread = std::thread(&AeroWorld2D::StepThreadLoop, this);
+        }
+        {
+            std::lock_guard lock(m_stepMutex);
+            m_stepTask = std::move(task);
         }
+        m_stepWake.notify_one();
+        return m_pendingStep;
+    }
 
-        const auto endTime = std::chrono::high_resolution_clock::now();
-        m_accumulatedTime += endTime - startTime;
-        m_frameCount++;
+    void AeroWorld2D::WaitForStep()
+    {
+        CompletePendingStep();
+    }
 
-        // Check if more than a second has passed since the last log
-        auto now = std::chrono::steady_clock::now();
-        if (now - lastLogTime >= std::chrono::seconds(1)) {
-            const double averageTime = m_accumulatedTime.count() / m_frameCount;
-            const std::size_t bodyCount = m_bodies.size();
+    const AeroWorldSnapshot2D& AeroWorld2D::GetSnapshot() const
+    {
+        return m_snapshots[m_frontSnapshot];
+    }
 
-            std::cout << "Average frame time: " << averageTime << " seconds, "
-                << "Number of bodies: " << bodyCount << std::endl;
+    void AeroWorld2D::CompletePendingStep()
+    {
+        if (!m_pendingStep.valid()) return;
 
-            // Reset counters and update lastLogTime
-            m_accumulatedTime = std::chrono::seconds(0);
-            m_frameCount = 0;
-            lastLogTime = now;
+        // A step that threw leaves its snapshot half written, the caller gets the exception from its future.
+        bool completed = true;
+        try {
+            m_pendingStep.get();
+        }
+        catch (...) {
+            completed = false;
+        }
+        m_pendingStep = {};
+        if (completed) {
+            m_frontSnapshot ^= 1;
+            ++m_asyncStepCount;
         }
     }
-}
 
+    void AeroWorld2D::StepThreadLoop()
+    {
+        std::unique_lock lock(m_stepMutex);
+        while (true) {
+            m_stepWake.wait(lock, [this] { return m_stepTask.valid() || m_stopStepThread; });
+            if (m_stopStepThread) return;
+
+            std::packaged_task<aero_int32()> task = std::move(m_stepTask);
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    void AeroWorld2D::WriteSnapshot(AeroWorldSnapshot2D& snapshot, const aero_int32 updateCount) const
+    {
+        // The vectors keep their capacity, so once the world stops growing no step allocates for its snapshot.
+        snapshot.step = m_asyncStepCount + 1;
+        snapshot.update_count = updateCount;
+        snapshot.interpolation_alpha = GetInterpolationAlpha();
+
+        snapshot.bodies.clear();
+        for (const AeroBody2D* body : m_bodies.GetBodies()) {
+            AeroBodySnapshot2D& state = snapshot.bodies.emplace_back();
+            state.handle = body->handle;
+            state.shape = body->shape;
+            state.position = body->GetPosition();
+            state.rotation = body->GetRotation();
+            state.previous_position = body->previous_position;
+            state.previous_rotation = body->previous_rotation;
+            state.linear_velocity = body->GetLinearVelocity();
+            state.angular_velocity = body->GetAngularVelocity();
+            state.is_sleeping = body->IsSleeping();
+        }
+
+        snapshot.contacts.assign(m_contacts.begin(), m_contacts.end());
+    }
+}
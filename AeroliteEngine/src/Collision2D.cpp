@@ -1,45 +1,154 @@
+#include <algorithm>
+#include <bit>
 #include <limits>
 #include <complex>
+#include "AeroSimd.h"
 #include "Collision2D.h"
 #include "Precision.h"
 #include "Shape.h"
 
 namespace Aerolite
 {
+    namespace
+    {
+        // Packs the features that generated a polygon contact point into a single id: which body owns
+        // the reference edge, the reference edge, the incident edge and the index of the clipped point.
+        aero_uint32 MakeFeatureId(const bool referenceIsB, const int referenceEdge, const int incidentEdge, const int point)
+        {
+            return (static_cast<aero_uint32>(referenceIsB) << 24) |
+                ((static_cast<aero_uint32>(referenceEdge) & 0xFF) << 16) |
+                ((static_cast<aero_uint32>(incidentEdge) & 0xFF) << 8) |
+                (static_cast<aero_uint32>(point) & 0xFF);
+        }
+
+        // Circle vs polygon contact regions, combined with the closest edge index into the feature id.
+        enum CirclePolygonRegion : aero_uint32 { RegionA = 0, RegionB = 1, RegionC = 2, RegionInside = 3 };
+
+        // Contact of two overlapping circles, from the circle of b to the circle of a.
+        Contact2D MakeCircleContact(AeroBody2D* a, AeroBody2D* b, const real radiusA, const real radiusB)
+        {
+            const AeroVec2 distanceBetweenCenters = b->GetPosition() - a->GetPosition();
+            Contact2D contact;
+            contact.a = a;
+            contact.b = b;
+            contact.normal = distanceBetweenCenters.UnitVector();
+            contact.start = b->GetPosition() - (contact.normal * radiusB);
+            contact.end = a->GetPosition() + (contact.normal * radiusA);
+            contact.depth = (contact.end - contact.start).Magnitude();
+            return contact;
+        }
+
+        constexpr std::size_t CIRCLE_BLOCK_SIZE = 64; // Circle pairs per overlap test, one bit of the result each.
+
+        // Centers and summed radii of a block of circle pairs, one array per coordinate so that
+        // a SIMD load reads the same coordinate of consecutive pairs.
+        struct CircleLanes {
+            alignas(32) real ax[CIRCLE_BLOCK_SIZE];
+            alignas(32) real ay[CIRCLE_BLOCK_SIZE];
+            alignas(32) real bx[CIRCLE_BLOCK_SIZE];
+            alignas(32) real by[CIRCLE_BLOCK_SIZE];
+            alignas(32) real radius[CIRCLE_BLOCK_SIZE];
+        };
+
+        // Tests the pairs of a block, bit i of the result is set if pair i overlaps. The lanes are filled
+        // up to the next multiple of four, and every variant computes exactly what IsCollidingCircleCircle does.
+        using CircleOverlap = aero_uint64 (*)(const CircleLanes& lanes, std::size_t count);
+
+#ifdef AERO_SIMD_SSE2
+        aero_uint64 OverlapCirclesSse2(const CircleLanes& lanes, const std::size_t count)
+        {
+            aero_uint64 mask = 0;
+            for (std::size_t i = 0; i < count; i += 2) {
+                const __m128d dx = _mm_sub_pd(_mm_load_pd(lanes.bx + i), _mm_load_pd(lanes.ax + i));
+                const __m128d dy = _mm_sub_pd(_mm_load_pd(lanes.by + i), _mm_load_pd(lanes.ay + i));
+                const __m128d distanceSquared = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+                const __m128d radius = _mm_load_pd(lanes.radius + i);
+                const __m128d overlap = _mm_cmple_pd(distanceSquared, _mm_mul_pd(radius, radius));
+                mask |= static_cast<aero_uint64>(_mm_movemask_pd(overlap)) << i;
+            }
+            return mask;
+        }
+
+        AERO_SIMD_TARGET_AVX aero_uint64 OverlapCirclesAvx(const CircleLanes& lanes, const std::size_t count)
+        {
+            aero_uint64 mask = 0;
+            for (std::size_t i = 0; i < count; i += 4) {
+                const __m256d dx = _mm256_sub_pd(_mm256_load_pd(lanes.bx + i), _mm256_load_pd(lanes.ax + i));
+                const __m256d dy = _mm256_sub_pd(_mm256_load_pd(lanes.by + i), _mm256_load_pd(lanes.ay + i));
+                const __m256d distanceSquared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+                const __m256d radius = _mm256_load_pd(lanes.radius + i);
+                const __m256d overlap = _mm256_cmp_pd(distanceSquared, _mm256_mul_pd(radius, radius), _CMP_LE_OQ);
+                mask |= static_cast<aero_uint64>(_mm256_movemask_pd(overlap)) << i;
+            }
+            return mask;
+        }
+#else
+        aero_uint64 OverlapCirclesScalar(const CircleLanes& lanes, const std::size_t count)
+        {
+            aero_uint64 mask = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const real dx = lanes.bx[i] - lanes.ax[i];
+                const real dy = lanes.by[i] - lanes.ay[i];
+                if (dx * dx + dy * dy <= lanes.radius[i] * lanes.radius[i]) {
+                    mask |= aero_uint64{1} << i;
+                }
+            }
+            return mask;
+        }
+#endif
+
+        CircleOverlap SelectCircleOverlap()
+        {
+#ifdef AERO_SIMD_SSE2
+            return Simd::HasAvx() ? &OverlapCirclesAvx : &OverlapCirclesSse2;
+#else
+            return &OverlapCirclesScalar;
+#endif
+        }
+    }
+
     // Function: IsColliding
     // Purpose: Determines if two 2D bodies are colliding.
     // Parameters:
     //   - a, b: Pointers to the two AeroBody2D objects being checked for collision.
     //   - contact: A reference to a Contact2D object where collision details will be stored.
-    // Description: This function first checks the shape types of the bodies (circle or polygon).
-    //              It then delegates the collision detection to the appropriate function based
-    //              on the shape types.
-    bool CollisionDetection2D::IsColliding(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, std::vector<Contact2D>& contacts)
+    // Description: This function looks up the kernel of the shape types of the bodies in the
+    //              dispatch table and delegates the collision detection to it.
+    bool CollisionDetection2D::IsColliding(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts)
+    {
+        return GetKernel(GetKernelIndex(a->shape->GetType(), b->shape->GetType()))(a, b, contacts);
+    }
+
+    template<ShapeType A, ShapeType B>
+    bool CollisionDetection2D::Collide(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts)
     {
 #ifndef CHECK_STATIC_COLLISIONS
         if (a->IsStatic() && b->IsStatic()) return false;
 #endif
-        const bool aIsCircle = a->shape->GetType() == Circle;
-        const bool bIsCircle = b->shape->GetType() == Circle;
-
-        if (aIsCircle && bIsCircle)
-        {
+        // Boxes are polygons, so every combination is one of three routines.
+        if constexpr (A == Circle && B == Circle) {
             return IsCollidingCircleCircle(a, b, contacts);
         }
-        else if (!aIsCircle && !bIsCircle)
-        {
-            return IsCollidingPolygonPolygon(a, b, contacts);
-        }
-        else if (aIsCircle && !bIsCircle)
-        {
+        else if constexpr (A == Circle) {
             return IsCollidingCirclePolygon(b, a, contacts);
         }
-        else if (!aIsCircle && bIsCircle)
-        {
+        else if constexpr (B == Circle) {
             return IsCollidingCirclePolygon(a, b, contacts);
         }
+        else {
+            return IsCollidingPolygonPolygon(a, b, contacts);
+        }
+    }
 
-        return false;
+    CollisionDetection2D::Kernel CollisionDetection2D::GetKernel(const aero_int32 kernelIndex)
+    {
+        // Rows are the type of the first shape, columns the type of the second, in the order of ShapeType.
+        static constexpr std::array<Kernel, KERNEL_COUNT> kernels = {
+            &Collide<Circle, Circle>, &Collide<Circle, Box>, &Collide<Circle, Polygon>,
+            &Collide<Box, Circle>, &Collide<Box, Box>, &Collide<Box, Polygon>,
+            &Collide<Polygon, Circle>, &Collide<Polygon, Box>, &Collide<Polygon, Polygon>,
+        };
+        return kernels[kernelIndex];
     }
 
 
@@ -58,31 +167,70 @@ namespace Aerolite
     //   - contact: A reference to a Contact2D object to store collision details.
     // Description: This function calculates if two circles are colliding by comparing
     //              the distance between their centers to the sum of their radii.
-    bool CollisionDetection2D::IsCollidingCircleCircle(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, std::vector<Contact2D>& contacts)
+    bool CollisionDetection2D::IsCollidingCircleCircle(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts)
     {
-	    const auto aCircleShape = std::dynamic_pointer_cast<CircleShape>(a->shape);
-	    const auto bCircleShape =  std::dynamic_pointer_cast<CircleShape>(b->shape);
+	    const auto& aCircleShape = static_cast<const CircleShape&>(*a->shape);
+	    const auto& bCircleShape = static_cast<const CircleShape&>(*b->shape);
 
-        const AeroVec2 distanceBetweenCenters = b->position - a->position;
-        const real sumRadius = aCircleShape->radius + bCircleShape->radius;
+        const AeroVec2 distanceBetweenCenters = b->GetPosition() - a->GetPosition();
+        const real sumRadius = aCircleShape.radius + bCircleShape.radius;
 	    const bool isColliding = distanceBetweenCenters.MagnitudeSquared() <= (sumRadius * sumRadius);
 
         if (!isColliding) {
             return false;
         }
-        Contact2D contact;
-
-        contact.a = a;
-        contact.b = b;
-        contact.normal = distanceBetweenCenters.UnitVector();
-        contact.start = b->position - (contact.normal * bCircleShape->radius);
-        contact.end = a->position + (contact.normal * aCircleShape->radius);
-        contact.depth = (contact.end - contact.start).Magnitude();
 
-        contacts.push_back(contact);
+        contacts.push_back(MakeCircleContact(a, b, aCircleShape.radius, bCircleShape.radius));
         return true;
     }
 
+    std::size_t CollisionDetection2D::CollideCircleBatch(const std::span<AeroBody2D* const> a, const std::span<AeroBody2D* const> b,
+                                                         std::vector<Contact2D>& contacts, const std::span<aero_int32> hits)
+    {
+        static const CircleOverlap overlap = SelectCircleOverlap();
+
+        CircleLanes lanes;
+        std::size_t hitCount = 0;
+        for (std::size_t begin = 0; begin < a.size(); begin += CIRCLE_BLOCK_SIZE) {
+            const std::size_t count = std::min(CIRCLE_BLOCK_SIZE, a.size() - begin);
+            aero_uint64 candidates = count == CIRCLE_BLOCK_SIZE ? ~aero_uint64{0} : (aero_uint64{1} << count) - 1;
+
+            // Gather the pairs into the lanes, the padding up to the SIMD width is tested and discarded.
+            const std::size_t padded = std::min((count + 3) & ~std::size_t{3}, CIRCLE_BLOCK_SIZE);
+            for (std::size_t i = 0; i < padded; ++i) {
+                if (i >= count) {
+                    lanes.ax[i] = lanes.ay[i] = lanes.bx[i] = lanes.by[i] = lanes.radius[i] = 0;
+                    continue;
+                }
+                const AeroBody2D& bodyA = *a[begin + i];
+                const AeroBody2D& bodyB = *b[begin + i];
+                lanes.ax[i] = bodyA.GetPosition().x;
+                lanes.ay[i] = bodyA.GetPosition().y;
+                lanes.bx[i] = bodyB.GetPosition().x;
+                lanes.by[i] = bodyB.GetPosition().y;
+                lanes.radius[i] = static_cast<const CircleShape&>(*bodyA.shape).radius +
+                    static_cast<const CircleShape&>(*bodyB.shape).radius;
+#ifndef CHECK_STATIC_COLLISIONS
+                if (bodyA.IsStatic() && bodyB.IsStatic()) candidates &= ~(aero_uint64{1} << i);
+#endif
+            }
+
+            aero_uint64 mask = overlap(lanes, padded) & candidates;
+            while (mask != 0) {
+                const std::size_t i = std::countr_zero(mask);
+                mask &= mask - 1;
+
+                AeroBody2D* bodyA = a[begin + i];
+                AeroBody2D* bodyB = b[begin + i];
+                contacts.push_back(MakeCircleContact(bodyA, bodyB,
+                    static_cast<const CircleShape&>(*bodyA->shape).radius,
+                    static_cast<const CircleShape&>(*bodyB->shape).radius));
+                hits[hitCount++] = static_cast<aero_int32>(begin + i);
+            }
+        }
+        return hitCount;
+    }
+
     // Function: IsCollidingPolygonPolygon
     // Purpose: Checks for collision between two polygons using the Separating Axis Theorem (SAT).
     // Parameters:
@@ -90,24 +238,24 @@ namespace Aerolite
     //   - contact: A reference to a Contact2D object, not used in this function as SAT does not provide contact points.
     // Description: This function checks for overlap along all possible axes formed by the edges of the polygons.
     //              If a separating axis is found (no overlap on an axis), the polygons are not colliding.
-    bool CollisionDetection2D::IsCollidingPolygonPolygon(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, std::vector<Contact2D>& contacts)
+    bool CollisionDetection2D::IsCollidingPolygonPolygon(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts)
     {
         return IsCollidingSATOptimized(a, b, contacts);
     }
 
-    bool CollisionDetection2D::IsCollidingSATBruteForce(std::shared_ptr<AeroBody2D> a, std::shared_ptr<AeroBody2D> b, Contact2D& contact)
+    bool CollisionDetection2D::IsCollidingSATBruteForce(AeroBody2D* a, AeroBody2D* b, Contact2D& contact)
     {
-        // Casting the shape of each body to a PolygonShape to access polygon-specific properties.
-        const auto aPolygonShape =  std::dynamic_pointer_cast<PolygonShape>(a->shape);
-        const auto bPolygonShape =  std::dynamic_pointer_cast<PolygonShape>(b->shape);
+        // The world space vertices and normals of the polygon of each body.
+        const PolygonLanes aPolygon = a->GetPolygonLanes();
+        const PolygonLanes bPolygon = b->GetPolygonLanes();
         auto contactDepth = std::numeric_limits<real>::max();
         auto contactNormal = AeroVec2();
 
         // Checking for overlap along all axes formed by the edges of polygon a->
-        for (int i = 0; i < aPolygonShape->worldVertices.size(); i++)
+        for (std::size_t i = 0; i < aPolygon.count; i++)
         {
-            // Compute the normal to the edge.
-            AeroVec2 normal = aPolygonShape->EdgeAt(i).Normal().UnitVector();
+            // The unit normal to the edge.
+            AeroVec2 normal = aPolygon.Normal(i);
 
             // Initialize min and max projection values.
             auto minA = std::numeric_limits<real>::max();
@@ -116,8 +264,8 @@ namespace Aerolite
             auto maxB = std::numeric_limits<real>::min();
 
             // Find the min and max projections of both polygons onto the axis.
-            FindMinMaxProjections(aPolygonShape->worldVertices, normal, minA, maxA);
-            FindMinMaxProjections(bPolygonShape->worldVertices, normal, minB, maxB);
+            FindMinMaxProjections(aPolygon, normal, minA, maxA);
+            FindMinMaxProjections(bPolygon, normal, minB, maxB);
 
             // If projections do not overlap, there is a separating axis, so no collision.
             if (minA >= maxB || minB >= maxA) return false;
@@ -132,17 +280,17 @@ namespace Aerolite
         }
 
         // Repeat the process for all axes formed by the edges of polygon b->
-        for (int i = 0; i < bPolygonShape->worldVertices.size(); i++)
+        for (std::size_t i = 0; i < bPolygon.count; i++)
         {
-	        AeroVec2 normal = bPolygonShape->EdgeAt(i).Normal().UnitVector();
+	        AeroVec2 normal = bPolygon.Normal(i);
 
             auto minA = std::numeric_limits<real>::max();
             auto maxA = std::numeric_limits<real>::min();
             auto minB = std::numeric_limits<real>::max();
             auto maxB = std::numeric_limits<real>::min();
 
-            FindMinMaxProjections(aPolygonShape->worldVertices, normal, minA, maxA);
-            FindMinMaxProjections(bPolygonShape->worldVertices, normal, minB, maxB);
+            FindMinMaxProjections(aPolygon, normal, minA, maxA);
+            FindMinMaxProjections(bPolygon, normal, minB, maxB);
 
             if (minA >= maxB || minB >= maxA) return false;
 
@@ -156,8 +304,8 @@ namespace Aerolite
         }
 
         // Ensuring that the normal of the contact points from body A to body B.
-        const AeroVec2 centerA = aPolygonShape->GeometricCenter();
-        const AeroVec2 centerB = bPolygonShape->GeometricCenter();
+        const AeroVec2 centerA = PolygonShape::GeometricCenter(aPolygon);
+        const AeroVec2 centerB = PolygonShape::GeometricCenter(bPolygon);
 
         const AeroVec2 direction = centerB - centerA;
         if (direction.Dot(contactNormal) < 0.0f)
@@ -171,62 +319,61 @@ namespace Aerolite
         contact.depth = contactDepth;
         contact.normal = contactNormal;
 
-        FindContactPointsPolygons(*aPolygonShape, *bPolygonShape, contact);
+        FindContactPointsPolygons(aPolygon, bPolygon, contact);
 
         // If no separating axis is found, the polygons are colliding.
         return true;
     }
 
     // Check for collision between two polygon shapes using the Separating Axis Theorem (SAT).
-    bool CollisionDetection2D::IsCollidingSATOptimized(std::shared_ptr<AeroBody2D> a, std::shared_ptr<AeroBody2D> b, std::vector<Contact2D>& contacts)
+    bool CollisionDetection2D::IsCollidingSATOptimized(AeroBody2D* a, AeroBody2D* b, std::vector<Contact2D>& contacts)
     {
-        // Cast the shapes of the bodies to polygon shapes
-        const auto polygonShapeA =  std::dynamic_pointer_cast<PolygonShape>(a->shape);
-        const auto polygonShapeB =  std::dynamic_pointer_cast<PolygonShape>(b->shape);
+        // The world space vertices and normals of the polygon of each body
+        const PolygonLanes polygonA = a->GetPolygonLanes();
+        const PolygonLanes polygonB = b->GetPolygonLanes();
 
         // Variables to store the axis of minimum separation and the corresponding points
         int aIndexReferenceEdge, bIndexReferenceEdge;
         AeroVec2 aSupportPoint, bSupportPoint;
 
-        // Find the minimum separation from A to B, along with the separation axis and point
-        const real abSeparation = polygonShapeA->FindMinimumSeparation(*polygonShapeB, aIndexReferenceEdge, aSupportPoint);
-        // Find the minimum separation from B to A, along with the separation axis and point
-        const real baSeparation = polygonShapeB->FindMinimumSeparation(*polygonShapeA, bIndexReferenceEdge, bSupportPoint);
-
-        // If either separation is non-negative, no overlap occurs, thus no collision
+        // Find the minimum separation from A to B, along with the separation axis and point.
+        // A non-negative separation means no overlap, the search from B to A is not needed then.
+        const real abSeparation = PolygonShape::FindMinimumSeparation(polygonA, polygonB, aIndexReferenceEdge, aSupportPoint);
         if (abSeparation >= 0) return false;
+        // Find the minimum separation from B to A, along with the separation axis and point
+        const real baSeparation = PolygonShape::FindMinimumSeparation(polygonB, polygonA, bIndexReferenceEdge, bSupportPoint);
         if (baSeparation >= 0) return false;
 
-        std::shared_ptr<PolygonShape> referenceShape;
-        std::shared_ptr<PolygonShape> incidentShape;
+        const PolygonLanes* reference;
+        const PolygonLanes* incident;
         int indexReferenceEdge;
         if (abSeparation > baSeparation) {
             // Set "A" as our reference shape and "B" as incident shape.
-            referenceShape = polygonShapeA;
-            incidentShape = polygonShapeB;
+            reference = &polygonA;
+            incident = &polygonB;
             indexReferenceEdge = aIndexReferenceEdge;
         }
         else {
             // Set "B" as our reference shape and "A" as incident shape.
-            referenceShape = polygonShapeB;
-            incidentShape = polygonShapeA;
+            reference = &polygonB;
+            incident = &polygonA;
             indexReferenceEdge = bIndexReferenceEdge;
         }
 
-        const AeroVec2 referenceEdge = referenceShape->EdgeAt(indexReferenceEdge);
-        
+        // The normal of the reference edge is kept with the body's vertices, it serves both the clipping and the contacts.
+        const AeroVec2 referenceNormal = reference->Normal(indexReferenceEdge);
+
         // Clipping
-        const int incidentIndex = incidentShape->FindIncidentEdgeIndex(referenceEdge.Normal());
-        const int incidentNextIndex = (incidentIndex + 1) % incidentShape->worldVertices.size();
-        const AeroVec2 v0 = incidentShape->worldVertices[incidentIndex];
-        const AeroVec2 v1 = incidentShape->worldVertices[incidentNextIndex];
-        std::vector<AeroVec2> contactPoints = { v0, v1 };
-        std::vector<AeroVec2> clippedPoints = contactPoints;
-        for (int i = 0; i < referenceShape->worldVertices.size(); i++) {
-            if (i == indexReferenceEdge) continue;
-
-            AeroVec2 c0 = referenceShape->worldVertices[i];
-            AeroVec2 c1 = referenceShape->worldVertices[(i + 1) % referenceShape->worldVertices.size()];
+        const int incidentIndex = PolygonShape::FindIncidentEdgeIndex(*incident, referenceNormal);
+        const AeroVec2 v0 = incident->Vertex(incidentIndex);
+        const AeroVec2 v1 = incident->Vertex(incident->Next(incidentIndex));
+        std::array<AeroVec2, 2> contactPoints = { v0, v1 };
+        std::array<AeroVec2, 2> clippedPoints = contactPoints;
+        for (std::size_t i = 0; i < reference->count; i++) {
+            if (i == static_cast<std::size_t>(indexReferenceEdge)) continue;
+
+            AeroVec2 c0 = reference->Vertex(i);
+            AeroVec2 c1 = reference->Vertex(reference->Next(i));
             const int numClipped = Aerolite::PolygonShape::ClipLineSegmentToLine(contactPoints, clippedPoints, c0, c1);
             if(numClipped < 2) {
                 break;
@@ -235,18 +382,21 @@ namespace Aerolite
             contactPoints = clippedPoints; // Make the next contact points the ones that were just clipped.
         }
 
-        const auto vref = referenceShape->worldVertices[indexReferenceEdge];
+        const auto vref = reference->Vertex(indexReferenceEdge);
+        const bool referenceIsB = baSeparation >= abSeparation;
 
-        for (auto& vclip : clippedPoints) {
-	        const real separation = (vclip - vref).Dot(referenceEdge.Normal());
+        for (int k = 0; k < static_cast<int>(clippedPoints.size()); k++) {
+            const AeroVec2& vclip = clippedPoints[k];
+	        const real separation = (vclip - vref).Dot(referenceNormal);
             if (separation <= 0) {
                 Contact2D contact;
                 contact.a = a;
                 contact.b = b;
-                contact.normal = referenceEdge.Normal();
+                contact.normal = referenceNormal;
                 contact.start = vclip;
                 contact.end = vclip + contact.normal * -separation;
-                if (baSeparation >= abSeparation) {
+                contact.feature_id = MakeFeatureId(referenceIsB, indexReferenceEdge, incidentIndex, k);
+                if (referenceIsB) {
                     std::swap(contact.start, contact.end);
                     contact.normal *= -1.0;
                 }
@@ -259,29 +409,28 @@ namespace Aerolite
     }
 
     // Check for collision between a circle and a polygon.
-    bool CollisionDetection2D::IsCollidingCirclePolygon(const std::shared_ptr<AeroBody2D>& polygon, const std::shared_ptr<AeroBody2D>
-                                                        & circle, std::vector<Contact2D>& contacts)
+    bool CollisionDetection2D::IsCollidingCirclePolygon(AeroBody2D* polygon, AeroBody2D* circle, std::vector<Contact2D>& contacts)
     {
-        // Cast the shapes to their respective types
-        const auto polygonShape =  std::dynamic_pointer_cast<PolygonShape>(polygon->shape);
-        const auto circleShape =  std::dynamic_pointer_cast<CircleShape>(circle->shape);
+        // The polygon's world space vertices and the circle's shape
+        const PolygonLanes vertices = polygon->GetPolygonLanes();
+        const auto& circleShape = static_cast<const CircleShape&>(*circle->shape);
 
         // Initialization of variables to track the closest edge and if the circle is outside the polygon
         bool isOutside = false;
         AeroVec2 minCurrVertex;
         AeroVec2 minNextVertex;
+        int minEdgeIndex = 0;
         real distanceToCircleEdge = std::numeric_limits<real>::lowest();
 
         // Iterate over each edge of the polygon
-        for (int i = 0; i < polygonShape->worldVertices.size(); i++)
+        for (std::size_t i = 0; i < vertices.count; i++)
         {
-	        const int currVertex = i;
-	        const int nextVertex = (i + 1) % polygonShape->worldVertices.size();
-            AeroVec2 edge = polygonShape->EdgeAt(currVertex);
-            AeroVec2 normal = edge.Normal();
+	        const std::size_t currVertex = i;
+	        const std::size_t nextVertex = vertices.Next(i);
+            AeroVec2 normal = vertices.Normal(currVertex);
 
             // Compute vector from the current vertex to the circle's center
-            AeroVec2 vertexToCircleCenter = circle->position - polygonShape->worldVertices[currVertex];
+            AeroVec2 vertexToCircleCenter = circle->GetPosition() - vertices.Vertex(currVertex);
 
             // Project the vertex-to-center vector onto the edge's normal
 	        const real projection = vertexToCircleCenter.Dot(normal);
@@ -289,63 +438,70 @@ namespace Aerolite
             // Determine if the circle is outside the polygon and find the closest edge
             if (projection > 0) {
                 distanceToCircleEdge = projection;
-                minCurrVertex = polygonShape->worldVertices[currVertex];
-                minNextVertex = polygonShape->worldVertices[nextVertex];
+                minCurrVertex = vertices.Vertex(currVertex);
+                minNextVertex = vertices.Vertex(nextVertex);
+                minEdgeIndex = static_cast<int>(currVertex);
                 isOutside = true;
                 break;
             }
             else {
                 if (projection > distanceToCircleEdge) {
                     distanceToCircleEdge = projection;
-                    minCurrVertex = polygonShape->worldVertices[currVertex];
-                    minNextVertex = polygonShape->worldVertices[nextVertex];
+                    minCurrVertex = vertices.Vertex(currVertex);
+                    minNextVertex = vertices.Vertex(nextVertex);
+                    minEdgeIndex = static_cast<int>(currVertex);
                 }
             }
         }
 
         Contact2D contact;
+        aero_uint32 region = RegionInside;
         // Check for collision based on the region where the circle is relative to the closest edge
         if (isOutside)
         {
             // Handle collision detection for region A
-            AeroVec2 v1 = circle->position - minCurrVertex;
+            AeroVec2 v1 = circle->GetPosition() - minCurrVertex;
             AeroVec2 v2 = minNextVertex - minCurrVertex;
             if (v1.Dot(v2) < 0) {
-                if (v1.Magnitude() > circleShape->radius) {
+                if (v1.Magnitude() > circleShape.radius) {
                     return false;
                 }
                 else {
-                    SetContactDetails(contact, polygon, circle, v1, circleShape->radius);
+                    SetContactDetails(contact, polygon, circle, v1, circleShape.radius);
+                    region = RegionA;
                 }
             }
             else {
                 // Handle collision detection for region B
-                v1 = circle->position - minNextVertex;
+                v1 = circle->GetPosition() - minNextVertex;
                 v2 = minCurrVertex - minNextVertex;
                 if (v1.Dot(v2) < 0) {
-                    if (v1.Magnitude() > circleShape->radius) {
+                    if (v1.Magnitude() > circleShape.radius) {
                         return false;
                     }
                     else {
-                        SetContactDetails(contact, polygon, circle, v1, circleShape->radius);
+                        SetContactDetails(contact, polygon, circle, v1, circleShape.radius);
+                        region = RegionB;
                     }
                 }
                 else {
                     // Handle collision detection for region C
-                    if (distanceToCircleEdge > circleShape->radius) {
+                    if (distanceToCircleEdge > circleShape.radius) {
                         return false;
                     }
                     else {
-                        SetContactDetailsForRegionC(contact, polygon, circle, minCurrVertex, minNextVertex, circleShape->radius, distanceToCircleEdge);
+                        SetContactDetailsForRegionC(contact, polygon, circle, minCurrVertex, minNextVertex, circleShape.radius, distanceToCircleEdge);
+                        region = RegionC;
                     }
                 }
             }
         }
         else {
             // Circle's center is inside the polygon, indicating a definite collision
-            SetContactDetailsForInsideCollision(contact, polygon, circle, minCurrVertex, minNextVertex, circleShape->radius, distanceToCircleEdge);
+            SetContactDetailsForInsideCollision(contact, polygon, circle, minCurrVertex, minNextVertex, circleShape.radius, distanceToCircleEdge);
         }
 
+        contact.feature_id = (static_cast<aero_uint32>(minEdgeIndex) << 2) | region;
         contacts.push_back(contact);
 
         // Collision detected
@@ -353,36 +509,36 @@ namespace Aerolite
     }
 
     // Helper functions for setting contact details (to avoid code repetition)
-    void CollisionDetection2D::SetContactDetails(Contact2D& contact, const std::shared_ptr<AeroBody2D>& polygon,
-                                                 const std::shared_ptr<AeroBody2D>& circle, const AeroVec2& v1,
+    void CollisionDetection2D::SetContactDetails(Contact2D& contact, AeroBody2D* polygon,
+                                                 AeroBody2D* circle, const AeroVec2& v1,
                                                  const real radius) {
         contact.a = polygon;
         contact.b = circle;
         contact.depth = radius - v1.Magnitude();
         contact.normal = v1.UnitVector();
-        contact.start = circle->position + (contact.normal * -radius);
+        contact.start = circle->GetPosition() + (contact.normal * -radius);
         contact.end = contact.start + (contact.normal * contact.depth);
     }
 
-    void CollisionDetection2D::SetContactDetailsForRegionC(Contact2D& contact, const std::shared_ptr<AeroBody2D>& polygon, const std::shared_ptr<AeroBody2D>& circle,
+    void CollisionDetection2D::SetContactDetailsForRegionC(Contact2D& contact, AeroBody2D* polygon, AeroBody2D* circle,
                                                            const AeroVec2& minCurrVertex, const AeroVec2& minNextVertex, const real radius,
                                                            const real distanceToCircleEdge) {
         contact.a = polygon;
         contact.b = circle;
         contact.depth = radius - distanceToCircleEdge;
         contact.normal = (minNextVertex - minCurrVertex).Normal();
-        contact.start = circle->position - (contact.normal * radius);
+        contact.start = circle->GetPosition() - (contact.normal * radius);
         contact.end = contact.start + (contact.normal * contact.depth);
     }
 
-    void CollisionDetection2D::SetContactDetailsForInsideCollision(Contact2D& contact, const std::shared_ptr<AeroBody2D>& polygon, const std::shared_ptr<AeroBody2D>& circle,
+    void CollisionDetection2D::SetContactDetailsForInsideCollision(Contact2D& contact, AeroBody2D* polygon, AeroBody2D* circle,
                                                                    const AeroVec2& minCurrVertex, const AeroVec2& minNextVertex,
                                                                    const real radius, const real distanceToCircleEdge) {
         contact.a = polygon;
         contact.b = circle;
         contact.depth = radius - distanceToCircleEdge;
         contact.normal = (minNextVertex - minCurrVertex).Normal();
-        contact.start = circle->position - (contact.normal * radius);
+        contact.start = circle->GetPosition() - (contact.normal * radius);
         contact.end = contact.start + (contact.start * contact.depth);
     }
 
@@ -395,13 +551,13 @@ namespace Aerolite
     //   - min, max: References to store the minimum and maximum projections.
     // Description: This function is a helper for the Separating Axis Theorem. It projects each vertex onto the axis
     //              and keeps track of the minimum and maximum values of these projections.
-    void CollisionDetection2D::FindMinMaxProjections(const std::vector<AeroVec2>& vertices, const AeroVec2& axis,
+    void CollisionDetection2D::FindMinMaxProjections(const PolygonLanes& polygon, const AeroVec2& axis,
                                                      real& min, real& max)
     {
-        for (auto currentVertex : vertices)
+        for (std::size_t i = 0; i < polygon.count; i++)
         {
 	        // Projecting the vertex onto the axis.
-            const auto projection = currentVertex.Dot(axis);
+            const auto projection = polygon.x[i] * axis.x + polygon.y[i] * axis.y;
 
             // Updating the min and max values based on the projection.
             if (projection < min) {
@@ -414,7 +570,7 @@ namespace Aerolite
         }
     }
 
-    void CollisionDetection2D::FindContactPointsPolygons(const PolygonShape& shapeA, const PolygonShape& shapeB, Contact2D& contact)
+    void CollisionDetection2D::FindContactPointsPolygons(const PolygonLanes& polygonA, const PolygonLanes& polygonB, Contact2D& contact)
     {
 	    AeroVec2 c1;
 	    AeroVec2 c2;
@@ -422,12 +578,13 @@ namespace Aerolite
 
 	    real minDistance = std::numeric_limits<real>::max();
 
-        for (const auto p : shapeA.worldVertices)
+        for (std::size_t i = 0; i < polygonA.count; i++)
         {
-	        for (int j = 0; j < shapeB.worldVertices.size(); j++)
+            const AeroVec2 p = polygonA.Vertex(i);
+	        for (std::size_t j = 0; j < polygonB.count; j++)
             {
-	            AeroVec2 edgePoint1 = shapeB.worldVertices[j];
-	            AeroVec2 edgePoint2 = shapeB.worldVertices[(j + 1) % shapeB.worldVertices.size()];
+	            AeroVec2 edgePoint1 = polygonB.Vertex(j);
+	            AeroVec2 edgePoint2 = polygonB.Vertex(polygonB.Next(j));
 
 	            AeroVec2 closestPoint;
 	            real distance;
@@ -449,12 +606,13 @@ namespace Aerolite
             }
         }
 
-        for (const auto p : shapeB.worldVertices)
+        for (std::size_t i = 0; i < polygonB.count; i++)
         {
-	        for (size_t j = 0; j < shapeA.worldVertices.size(); j++)
+            const AeroVec2 p = polygonB.Vertex(i);
+	        for (std::size_t j = 0; j < polygonA.count; j++)
             {
-	            AeroVec2 edgePoint1 = shapeA.worldVertices[j];
-	            AeroVec2 edgePoint2 = shapeA.worldVertices[(j + 1) % shapeA.worldVertices.size()];
+	            AeroVec2 edgePoint1 = polygonA.Vertex(j);
+	            AeroVec2 edgePoint2 = polygonA.Vertex(polygonA.Next(j));
 
 	            AeroVec2 closestPoint;
 	            real distance;
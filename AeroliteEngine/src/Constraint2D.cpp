@@ -9,7 +9,7 @@ namespace Aerolite {
 	/// </summary>
 	/// <param name="a">The first body used for the constraint.</param>
 	/// <param name="b">The second body used for the constraint.</param>
-	Constraint2D::Constraint2D(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b) : a(a), b(b)
+	Constraint2D::Constraint2D(AeroBody2D* a, AeroBody2D* b) : a(a), b(b)
 	{
 	}
 
@@ -20,33 +20,51 @@ namespace Aerolite {
 	MatrixMxN<6, 6> Constraint2D::GetInvM() const {
 		MatrixMxN<6, 6> invM;
 		invM.Zero();
-		invM[0][0] = a->inv_mass;
-		invM[1][1] = a->inv_mass;
-		invM[2][2] = a->inv_inertia;
-		invM[3][3] = b->inv_mass;
-		invM[4][4] = b->inv_mass;
-		invM[5][5] = b->inv_inertia;
+		invM[0][0] = a->GetInvMass();
+		invM[1][1] = a->GetInvMass();
+		invM[2][2] = a->GetInvInertia();
+		invM[3][3] = b->GetInvMass();
+		invM[4][4] = b->GetInvMass();
+		invM[5][5] = b->GetInvInertia();
+		return invM;
+	}
+
+	/// <summary>
+	/// Creates the diagonal of the inverse mass/moment matrix.
+	/// </summary>
+	/// <returns>Returns a Vec6 with the inverse mass and inverse inertia of bodies "a" and "b"</returns>
+	VecN<6> Constraint2D::GetInvMDiagonal() const
+	{
+		VecN<6> invM;
+		invM[0] = a->GetInvMass();
+		invM[1] = a->GetInvMass();
+		invM[2] = a->GetInvInertia();
+		invM[3] = b->GetInvMass();
+		invM[4] = b->GetInvMass();
+		invM[5] = b->GetInvInertia();
 		return invM;
 	}
 
 	/// <summary>
 	/// Creates linear_velocity vector for constraint solving.
 	/// </summary>
-	/// <returns>Returns a Mat6x6 with all the inverse mass and inverse inertia of bodies "a" and "b"</returns>
-	MatrixMxN<6,1>Constraint2D::GetVelocities() const
+	/// <returns>Returns a Vec6 with the linear and angular velocities of bodies "a" and "b"</returns>
+	VecN<6> Constraint2D::GetVelocities() const
 	{
-		MatrixMxN<6,1> v;
-		v[0][0] = a->linear_velocity.x;
-		v[1][0] = a->linear_velocity.y;
-		v[2][0] = a->angular_velocity;
-		v[3][0] = b->linear_velocity.x;
-		v[4][0] = b->linear_velocity.y;
-		v[5][0] = b->angular_velocity;
+		VecN<6> v;
+		const AeroVec2 va = a->GetLinearVelocity();
+		const AeroVec2 vb = b->GetLinearVelocity();
+		v[0] = va.x;
+		v[1] = va.y;
+		v[2] = a->GetAngularVelocity();
+		v[3] = vb.x;
+		v[4] = vb.y;
+		v[5] = b->GetAngularVelocity();
 
 		return v;
 	}
 
-	JointConstraint::JointConstraint(const std::shared_ptr<AeroBody2D>& a, const std::shared_ptr<AeroBody2D>& b, const AeroVec2& anchorPoint) : Constraint2D(a, b)
+	JointConstraint::JointConstraint(AeroBody2D* a, AeroBody2D* b, const AeroVec2& anchorPoint) : Constraint2D(a, b)
 	{
 		this->aPoint = a->WorldSpaceToLocalSpace(anchorPoint);
 		this->bPoint = b->WorldSpaceToLocalSpace(anchorPoint);
@@ -55,14 +73,14 @@ namespace Aerolite {
 		this->cachedLambda = 0;
 	}
 
-	void JointConstraint::PreSolve(const real dt)
+	void JointConstraint::PreSolve(const real dt, const real beta)
 	{
 		// Get the anchor points in world space.
 		const AeroVec2 pa = a->LocalSpaceToWorldSpace(aPoint);
 		const AeroVec2 pb = b->LocalSpaceToWorldSpace(bPoint);
 
-		const AeroVec2 ra = pa - a->position; // vector from center of mass of body "a" to the anchor point in world space.
-		const AeroVec2 rb = pb - b->position; // vector from center of mass of body "b" to the anchor point in world space.
+		const AeroVec2 ra = pa - a->GetPosition(); // vector from center of mass of body "a" to the anchor point in world space.
+		const AeroVec2 rb = pb - b->GetPosition(); // vector from center of mass of body "b" to the anchor point in world space.
 		jacobian.Zero();
 		// Load the joint constraint jacobian matrix.
 		const AeroVec2 J1 = (pa - pb) * 2.0;
@@ -79,16 +97,17 @@ namespace Aerolite {
 		const real J4 = 2.0 * (rb.Cross(pb - pa));
 		jacobian[0][5] = J4; // coefficient for body "b" angular linear_velocity.
 
-		auto impulses = jacobian.Transpose() * cachedLambda;
+		VecN<1> lambda;
+		lambda[0] = cachedLambda;
+		const VecN<6> impulses = jacobian.TransposeMultiply(lambda);
 
-		a->ApplyImpulseLinear(AeroVec2(impulses[0][0], impulses[1][0]));
-		a->ApplyImpulseAngular(impulses[2][0]);
+		a->ApplyImpulseLinear(AeroVec2(impulses[0], impulses[1]));
+		a->ApplyImpulseAngular(impulses[2]);
 
-		b->ApplyImpulseLinear(AeroVec2(impulses[3][0], impulses[4][0]));
-		b->ApplyImpulseAngular(impulses[5][0]);
+		b->ApplyImpulseLinear(AeroVec2(impulses[3], impulses[4]));
+		b->ApplyImpulseAngular(impulses[5]);
 
 		// Compute the bias factor (baumgarte stabilization)
-		constexpr real beta = 0.1f;
 		// Compute the positional error
 		real c = (pb - pa).Dot(pb - pa);
 		c = std::max(0.0, c - 0.01);
@@ -96,34 +115,42 @@ namespace Aerolite {
 	}
 
 	void JointConstraint::Solve(void)
+	{
+		SolveWithBias(bias);
+	}
+
+	void JointConstraint::Relax(void)
+	{
+		SolveWithBias(0.0);
+	}
+
+	void JointConstraint::SolveWithBias(const real rowBias)
 	{
 		// Get the velocities vector
-		const MatrixMxN v = GetVelocities();
+		const VecN<6> v = GetVelocities();
 
-		// Get inverse mass/moment matrix.
-		const MatrixMxN invM = GetInvM();
+		// Get the diagonal of the inverse mass/moment matrix.
+		const VecN<6> invM = GetInvMDiagonal();
 
 		// Compute lagrangian multiplier lambda which is the impulse magnitude to apply to "a" and "b".
-		const MatrixMxN Jt = jacobian.Transpose();
-
 		// Lambda = -(J * V + b) / (J * M^-1 * J^T)
-		MatrixMxN lambdaNumerator = (jacobian * v * -1.0); 
-		lambdaNumerator[0][0] -= bias;
-		const MatrixMxN lambdaDenominator = jacobian * invM * Jt;
+		VecN<1> lambdaNumerator = jacobian * v * -1.0;
+		lambdaNumerator[0] -= rowBias;
+		const MatrixMxN<1, 1> lambdaDenominator = jacobian.MultiplyDiagonalTranspose(invM);
 
 		// (J * M^-1 * J^T) * Lambda = -(J * V + b) [Ax = B]
-		auto lambda = MatrixMxN<1,1>::SolveGaussSeidel(lambdaDenominator, VecN(lambdaNumerator[0]));
+		const VecN<1> lambda = MatrixMxN<1, 1>::SolveGaussSeidel(lambdaDenominator, lambdaNumerator);
 		cachedLambda += lambda[0];
 
 		// Compute the final impulses
-		auto impulses = Jt * lambda[0];
+		const VecN<6> impulses = jacobian.TransposeMultiply(lambda);
 
 		// Apply the impulses to bodies a and b
-		a->ApplyImpulseLinear(AeroVec2(impulses[0][0], impulses[1][0]));
-		a->ApplyImpulseAngular(impulses[2][0]);
+		a->ApplyImpulseLinear(AeroVec2(impulses[0], impulses[1]));
+		a->ApplyImpulseAngular(impulses[2]);
 		 
-		b->ApplyImpulseLinear(AeroVec2(impulses[3][0], impulses[4][0]));
-		b->ApplyImpulseAngular(impulses[5][0]);
+		b->ApplyImpulseLinear(AeroVec2(impulses[3], impulses[4]));
+		b->ApplyImpulseAngular(impulses[5]);
 	}
 
 	void JointConstraint::PostSolve(void)
@@ -132,130 +159,281 @@ namespace Aerolite {
 	}
 
 	PenetrationConstraint::PenetrationConstraint(
-		std::shared_ptr<AeroBody2D> a,
-		std::shared_ptr<AeroBody2D> b,
+		AeroBody2D* a,
+		AeroBody2D* b,
 		const AeroVec2& aCollisionPoint, const AeroVec2& bCollisionPoint,
 		const AeroVec2& collisionNormal) : Constraint2D(a, b)
 	{
-		this->jacobian = MatrixMxN<2, 6>();
 		this->bias = 0.0;
+		this->restitutionBias = 0.0;
 		this->friction = 0.0f;
-		this->cachedLambda = VecN<2>();
+		this->normalImpulse = 0.0;
+		this->tangentImpulse = 0.0;
+		this->normalMass = 0.0;
+		this->tangentMass = 0.0;
+		this->invMassA = this->invInertiaA = 0.0;
+		this->invMassB = this->invInertiaB = 0.0;
+		this->states = nullptr;
+		this->stateA = this->stateB = 0;
+		this->blockPartner = nullptr;
+		this->isBlockPartner = false;
+		this->useBlock = false;
+		this->k11 = this->k12 = this->k22 = 0.0;
+		this->blockMass11 = this->blockMass12 = this->blockMass22 = 0.0;
 		this->aPoint = a->WorldSpaceToLocalSpace(aCollisionPoint);
 		this->bPoint = b->WorldSpaceToLocalSpace(bCollisionPoint);
 		this->normal = a->WorldSpaceToLocalSpace(collisionNormal);
 	}
 
-	void PenetrationConstraint::PreSolve(const real dt) {
+	void PenetrationConstraint::PreSolve(const real dt, const real beta) {
+		if (isBlockPartner) return;
+
+		PreSolvePoint(dt, beta);
+		if (blockPartner == nullptr) return;
+
+		PenetrationConstraint& p = *blockPartner;
+		p.PreSolvePoint(dt, beta);
+
+		// K = J * M^-1 * J^T of the two normal rows. The diagonal is the inverse of the scalar normal masses.
+		const real ra1CrossN = ra.Cross(n);
+		const real rb1CrossN = rb.Cross(n);
+		const real ra2CrossN = p.ra.Cross(p.n);
+		const real rb2CrossN = p.rb.Cross(p.n);
+		k11 = invMassA + invMassB + invInertiaA * ra1CrossN * ra1CrossN + invInertiaB * rb1CrossN * rb1CrossN;
+		k22 = invMassA + invMassB + invInertiaA * ra2CrossN * ra2CrossN + invInertiaB * rb2CrossN * rb2CrossN;
+		k12 = (invMassA + invMassB) * n.Dot(p.n) + invInertiaA * ra1CrossN * ra2CrossN + invInertiaB * rb1CrossN * rb2CrossN;
+
+		// Points that (nearly) coincide make the rows parallel, K is then close to singular.
+		constexpr real maxCondition = 1000.0;
+		const real det = k11 * k22 - k12 * k12;
+		useBlock = k11 * k11 < maxCondition * det;
+		if (useBlock) {
+			const real invDet = 1.0 / det;
+			blockMass11 = k22 * invDet;
+			blockMass12 = -k12 * invDet;
+			blockMass22 = k11 * invDet;
+		}
+	}
+
+	void PenetrationConstraint::PreSolvePoint(const real dt, const real beta) {
 		// Get the collision points in world space
 		const AeroVec2 pa = a->LocalSpaceToWorldSpace(aPoint);
 		const AeroVec2 pb = b->LocalSpaceToWorldSpace(bPoint);
-		const AeroVec2 n = a->LocalSpaceToWorldSpace(normal).UnitVector();
-
-		const AeroVec2 ra = pa - a->position; // vector from center of mass of body "a" to the anchor point in world space.
-		const AeroVec2 rb = pb - b->position; // vector from center of mass of body "b" to the anchor point in world space.
-
-		jacobian.Zero();
-		// Load the joint constraint jacobian matrix.
-
-		// Load the normal vector components of the jacobian for impulse application.
-		AeroVec2 J1 = -n;
-		jacobian[0][0] = J1.x; // coefficient for body "a" linear linear_velocity.x;
-		jacobian[0][1] = J1.y; // coefficient for body "a" linear linear_velocity.y;
-
-		real J2 = -ra.Cross(n);
-		jacobian[0][2] = J2; // coefficient for body "a" angular linear_velocity.
-
-		AeroVec2 J3 = n;
-		jacobian[0][3] = J3.x; // coefficient for body "b" linear linear_velocity.x;
-		jacobian[0][4] = J3.y; // coefficient for body "b" linear linear_velocity.y;
-
-		real J4 = rb.Cross(n);
-		jacobian[0][5] = J4; // coefficient for body "b" angular linear_velocity.
-
-		// Populate the tangent vector components of the jacobian for friction application.
+		n = a->LocalSpaceToWorldSpace(normal).UnitVector();
+
+		ra = pa - a->GetPosition(); // vector from center of mass of body "a" to the anchor point in world space.
+		rb = pb - b->GetPosition(); // vector from center of mass of body "b" to the anchor point in world space.
+
+		invMassA = a->IsStatic() ? 0.0 : a->GetInvMass();
+		invInertiaA = a->IsStatic() ? 0.0 : a->GetInvInertia();
+		invMassB = b->IsStatic() ? 0.0 : b->GetInvMass();
+		invInertiaB = b->IsStatic() ? 0.0 : b->GetInvInertia();
+		states = &a->GetStates();
+		stateA = a->GetStateIndex();
+		stateB = b->GetStateIndex();
+
+		// The jacobian of the normal row is [-n, -ra x n, n, rb x n], so J * M^-1 * J^T reduces to a scalar.
+		const real raCrossN = ra.Cross(n);
+		const real rbCrossN = rb.Cross(n);
+		const real kNormal = invMassA + invMassB + invInertiaA * raCrossN * raCrossN + invInertiaB * rbCrossN * rbCrossN;
+		normalMass = kNormal > 0.0 ? 1.0 / kNormal : 0.0;
+
+		// The tangent row has the same shape with the tangent in place of the normal.
 		friction = std::max(a->friction, b->friction);
-		if (friction > 0.0) {
-			const AeroVec2 t = n.Normal();
-
-			J1 = -t;
-			jacobian[1][0] = J1.x; // coefficient for body "a" linear linear_velocity.x;
-			jacobian[1][1] = J1.y; // coefficient for body "a" linear linear_velocity.y;
-
-			J2 = -ra.Cross(t);
-			jacobian[1][2] = J2; // coefficient for body "a" angular linear_velocity.
-
-			J3 = t;
-			jacobian[1][3] = J3.x; // coefficient for body "b" linear linear_velocity.x;
-			jacobian[1][4] = J3.y; // coefficient for body "b" linear linear_velocity.y;
-
-			J4 = rb.Cross(t);
-			jacobian[1][5] = J4; // coefficient for body "b" angular linear_velocity.
+		t = n.Normal();
+		const real raCrossT = ra.Cross(t);
+		const real rbCrossT = rb.Cross(t);
+		const real kTangent = invMassA + invMassB + invInertiaA * raCrossT * raCrossT + invInertiaB * rbCrossT * rbCrossT;
+		tangentMass = kTangent > 0.0 ? 1.0 / kTangent : 0.0;
+		if (friction <= 0.0) {
+			tangentImpulse = 0.0;
 		}
 
-		auto impulses = jacobian.Transpose() * cachedLambda;
+		// Calculate the relative linear_velocity pre-impulse normal to compute elasticity.
+		// This has to happen before warm starting, otherwise the cached impulse is bounced back as restitution.
+		// RelativeVelocity gives the velocity of B relative to A, the restitution wants A relative to B.
+		real vrelX, vrelY;
+		RelativeVelocity(vrelX, vrelY);
+		const real vrelDotNormal = -(vrelX * n.x + vrelY * n.y);
 
 		// Apply warm starting.
-		a->ApplyImpulseLinear(AeroVec2(impulses[0], impulses[1]));
-		a->ApplyImpulseAngular(impulses[2]);
-		 
-		b->ApplyImpulseLinear(AeroVec2(impulses[3], impulses[4]));
-		b->ApplyImpulseAngular(impulses[5]);
+		const AeroVec2 impulse = n * normalImpulse + t * tangentImpulse;
+		a->ApplyImpulseAtPoint(-impulse, ra);
+		b->ApplyImpulseAtPoint(impulse, rb);
 
 		// Compute the bias factor (baumgarte stabilization)
-		constexpr real beta = 0.2f;
 		// Compute the positional error
 		real C = (pb - pa).Dot(-n);
 		C = std::min(0.0, C + 0.01);
 		
-		// Calculate the relative linear_velocity pre-impulse normal to compute elasticity.
-		const AeroVec2 va = a->linear_velocity + AeroVec2(-a->angular_velocity * ra.y, a->angular_velocity * ra.x);
-		const AeroVec2 vb = b->linear_velocity + AeroVec2(-b->angular_velocity * rb.y, a->angular_velocity * rb.x);
-		const real vrelDotNormal = (va - vb).Dot(n);
 		const real e = std::min(a->restitution, b->restitution);
-		bias = (beta / dt) * C + (e * vrelDotNormal);
+		restitutionBias = e * vrelDotNormal;
+		bias = (beta / dt) * C + restitutionBias;
 	}
 
 	void PenetrationConstraint::Solve(void)
 	{
-		const MatrixMxN v = GetVelocities();
-		const MatrixMxN invM = GetInvM();
-		const MatrixMxN Jt = jacobian.Transpose();
+		SolveRows(true);
+	}
 
-		// Lambda = -(J * V + b) / (J * M^-1 * J^T)
-		MatrixMxN lambdaNumerator = (jacobian * v * -1.0);
-		lambdaNumerator[0][0] -= bias;
-		const MatrixMxN lambdaDenominator = jacobian * invM * Jt;
+	void PenetrationConstraint::Relax(void)
+	{
+		SolveRows(false);
+	}
 
-		// (J * M^-1 * J^T) * Lambda = -(J * V + b) [Ax = B]
-		// Accumulate impulses and clamp it within constraint limits.
-		auto bVec = VecN<2>();
-		bVec[0] = lambdaNumerator[0][0];
-		bVec[1] = lambdaNumerator[1][0];
-		auto lambda = MatrixMxN<2, 2>::SolveGaussSeidel(lambdaDenominator, bVec);
-		const VecN<2> oldLambda = cachedLambda;
-		cachedLambda += lambda;
-		cachedLambda[0] = (cachedLambda[0] < 0.0f) ? 0.0f : cachedLambda[0];
-
-		// Setting tangent/friction lambda value to a fraction of normal impulse.
-		if (friction > 0.0) {
-			const real max = cachedLambda[0] * friction;
-			cachedLambda[1] = std::clamp(cachedLambda[1], -max, max);
+	void PenetrationConstraint::SolveRows(const bool useBias)
+	{
+		if (isBlockPartner) return;
+
+		if (blockPartner == nullptr) {
+			SolveNormal(useBias);
+			SolveTangent();
+		}
+		else if (useBlock) {
+			// Friction first so it is bounded by the normal impulses of the last iteration, like a single point.
+			SolveTangent();
+			blockPartner->SolveTangent();
+			SolveBlockNormal(useBias);
 		}
-		lambda = cachedLambda - oldLambda;
+		else {
+			SolveNormal(useBias);
+			SolveTangent();
+			blockPartner->SolveNormal(useBias);
+			blockPartner->SolveTangent();
+		}
+	}
 
-		// Compute the final impulses
-		auto impulses = Jt * lambda;
+	void PenetrationConstraint::SolveNormal(const bool useBias)
+	{
+		// Everything is spelled out on scalars, this runs for every contact on every iteration.
+		// Lambda = -(J * V + b) / (J * M^-1 * J^T), accumulated and clamped so the contact only pushes.
+		real vrelX, vrelY;
+		RelativeVelocity(vrelX, vrelY);
+		const real oldNormalImpulse = normalImpulse;
+		const real rowBias = useBias ? bias : restitutionBias;
+		normalImpulse = std::max(oldNormalImpulse - (vrelX * n.x + vrelY * n.y + rowBias) * normalMass, make_real<real>(0.0));
+		const real normalDelta = normalImpulse - oldNormalImpulse;
+		ApplyImpulse(n.x * normalDelta, n.y * normalDelta);
+	}
 
-		// Apply the impulses to bodies a and b
-		a->ApplyImpulseLinear(AeroVec2(impulses[0], impulses[1]));
-		a->ApplyImpulseAngular(impulses[2]);
-		 
-		b->ApplyImpulseLinear(AeroVec2(impulses[3], impulses[4]));
-		b->ApplyImpulseAngular(impulses[5]);
+	void PenetrationConstraint::SolveTangent()
+	{
+		// Friction is limited by the normal impulse, it sees the velocities after the normal impulse.
+		if (friction <= 0.0) return;
+
+		real vrelX, vrelY;
+		RelativeVelocity(vrelX, vrelY);
+		const real max = normalImpulse * friction;
+		const real oldTangentImpulse = tangentImpulse;
+		tangentImpulse = std::clamp(oldTangentImpulse - (vrelX * t.x + vrelY * t.y) * tangentMass, -max, max);
+		const real tangentDelta = tangentImpulse - oldTangentImpulse;
+		ApplyImpulse(t.x * tangentDelta, t.y * tangentDelta);
+	}
+
+	void PenetrationConstraint::SolveBlockNormal(const bool useBias)
+	{
+		// Solves the LCP  w = K * x + q,  x >= 0,  w >= 0,  x_i * w_i = 0  for the accumulated normal
+		// impulses x of both points, where w is the residual J * V + bias of each row. With two rows the
+		// four possible sets of active points are simply tried in turn (total enumeration).
+		PenetrationConstraint& p = *blockPartner;
+
+		real vrelX, vrelY;
+		RelativeVelocity(vrelX, vrelY);
+		const real w1 = vrelX * n.x + vrelY * n.y + (useBias ? bias : restitutionBias);
+		p.RelativeVelocity(vrelX, vrelY);
+		const real w2 = vrelX * p.n.x + vrelY * p.n.y + (useBias ? p.bias : p.restitutionBias);
+
+		// q = w - K * x at the impulses accumulated so far.
+		const real x1Old = normalImpulse;
+		const real x2Old = p.normalImpulse;
+		const real q1 = w1 - (k11 * x1Old + k12 * x2Old);
+		const real q2 = w2 - (k12 * x1Old + k22 * x2Old);
+
+		real x1, x2;
+		if ((x1 = -(blockMass11 * q1 + blockMass12 * q2)) >= 0.0 &&
+			(x2 = -(blockMass12 * q1 + blockMass22 * q2)) >= 0.0) {
+			// Both points push.
+		}
+		else if ((x1 = -q1 * normalMass) >= 0.0 && k12 * x1 + q2 >= 0.0) {
+			// Only the first point pushes, the second one separates.
+			x2 = 0.0;
+		}
+		else if ((x2 = -q2 * p.normalMass) >= 0.0 && k12 * x2 + q1 >= 0.0) {
+			// Only the second point pushes.
+			x1 = 0.0;
+		}
+		else if (q1 >= 0.0 && q2 >= 0.0) {
+			// Both points separate.
+			x1 = x2 = 0.0;
+		}
+		else {
+			// No case holds because of round-off, keep the impulses of the last iteration.
+			return;
+		}
+
+		const real delta1 = x1 - x1Old;
+		const real delta2 = x2 - x2Old;
+		ApplyImpulse(n.x * delta1, n.y * delta1);
+		p.ApplyImpulse(p.n.x * delta2, p.n.y * delta2);
+		normalImpulse = x1;
+		p.normalImpulse = x2;
 	}
 
 	void PenetrationConstraint::PostSolve(void) {
 		
 	}
+
+	void PenetrationConstraint::RelativeVelocity(real& x, real& y) const
+	{
+		const AeroVec2& va = states->linear_velocities[stateA];
+		const AeroVec2& vb = states->linear_velocities[stateB];
+		const real wa = states->angular_velocities[stateA];
+		const real wb = states->angular_velocities[stateB];
+		x = vb.x - wb * rb.y - va.x + wa * ra.y;
+		y = vb.y + wb * rb.x - va.y - wa * ra.x;
+	}
+
+	void PenetrationConstraint::ApplyImpulse(const real x, const real y) const
+	{
+		// Static bodies are shared by islands solved in parallel, so they must not even be written to.
+		if (invMassA > 0.0) {
+			AeroVec2& va = states->linear_velocities[stateA];
+			va.x -= x * invMassA;
+			va.y -= y * invMassA;
+			states->angular_velocities[stateA] -= (ra.x * y - ra.y * x) * invInertiaA;
+		}
+		if (invMassB > 0.0) {
+			AeroVec2& vb = states->linear_velocities[stateB];
+			vb.x += x * invMassB;
+			vb.y += y * invMassB;
+			states->angular_velocities[stateB] += (rb.x * y - rb.y * x) * invInertiaB;
+		}
+	}
+
+	void PenetrationConstraint::SetCachedImpulses(const real normalImpulse, const real tangentImpulse)
+	{
+		this->normalImpulse = normalImpulse;
+		this->tangentImpulse = tangentImpulse;
+	}
+
+	void PenetrationConstraint::LinkBlock(PenetrationConstraint& partner)
+	{
+		blockPartner = &partner;
+		partner.isBlockPartner = true;
+	}
+
+	bool PenetrationConstraint::IsBlockPartner() const
+	{
+		return isBlockPartner;
+	}
+
+	real PenetrationConstraint::GetNormalImpulse() const
+	{
+		return normalImpulse;
+	}
+
+	real PenetrationConstraint::GetTangentImpulse() const
+	{
+		return tangentImpulse;
+	}
 }
\ No newline at end of file
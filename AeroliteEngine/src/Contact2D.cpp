@@ -17,14 +17,14 @@ namespace Aerolite {
     {
         if(a->IsStatic() && b->IsStatic()) return;
         
-        float da = depth / (a->inv_mass + b->inv_mass) * a->inv_mass;
-        float db = depth / (a->inv_mass + b->inv_mass) * b->inv_mass;
+        float da = depth / (a->GetInvMass() + b->GetInvMass()) * a->GetInvMass();
+        float db = depth / (a->GetInvMass() + b->GetInvMass()) * b->GetInvMass();
         
-        a->position -= (normal * da);
-        b->position += (normal * db);
+        a->SetPosition(a->GetPosition() - (normal * da));
+        b->SetPosition(b->GetPosition() + (normal * db));
 
-        a->shape->UpdateVertices(a->rotation, a->position);
-        b->shape->UpdateVertices(b->rotation, b->position);
+        a->UpdateWorldVertices();
+        b->UpdateWorldVertices();
     }
 
     void Contact2D::ResolveImpulse()
@@ -40,14 +40,14 @@ namespace Aerolite {
 
         // Calculate the radius vectors from the center of mass of each object to the contact point.
         // These vectors are used in the torque calculations.
-        AeroVec2 ra = end - a->position;
-        AeroVec2 rb = start - b->position;
+        AeroVec2 ra = end - a->GetPosition();
+        AeroVec2 rb = start - b->GetPosition();
 
         // Calculate the velocities at the point of contact for each object.
         // This includes both linear and angular contributions.
         // The formula is: linear_velocity = linear_velocity + angular_velocity cross radius_vector
-        AeroVec2 va = a->linear_velocity + AeroVec2(-a->angular_velocity * ra.y, a->angular_velocity * ra.x);
-        AeroVec2 vb = b->linear_velocity + AeroVec2(-b->angular_velocity * rb.y, b->angular_velocity * rb.x);
+        AeroVec2 va = a->GetLinearVelocity() + AeroVec2(-a->GetAngularVelocity() * ra.y, a->GetAngularVelocity() * ra.x);
+        AeroVec2 vb = b->GetLinearVelocity() + AeroVec2(-b->GetAngularVelocity() * rb.y, b->GetAngularVelocity() * rb.x);
 
         // Compute the relative linear_velocity at the point of contact.
         // This is the linear_velocity of object A relative to object B at the contact point.
@@ -64,9 +64,9 @@ namespace Aerolite {
         // coefficient of restitution.
         // The formula is: j = -(1 + e) * vrelDotNormal / (inv_massA + inv_massB + termA + termB)
         // where termA and termB are additional terms that account for the objects' rotational inertia.
-        const float impulseMagnitudeN = -(1 + e) * vrelDotNormal / ((a->inv_mass + b->inv_mass)
-            + (ra.Cross(normal) * ra.Cross(normal)) * a->inv_inertia
-            + (rb.Cross(normal) * rb.Cross(normal)) * b->inv_inertia);
+        const float impulseMagnitudeN = -(1 + e) * vrelDotNormal / ((a->GetInvMass() + b->GetInvMass())
+            + (ra.Cross(normal) * ra.Cross(normal)) * a->GetInvInertia()
+            + (rb.Cross(normal) * rb.Cross(normal)) * b->GetInvInertia());
 
         // Calculate the normal component of the impulse.
         // jN is the impulse vector along the collision normal.
@@ -86,9 +86,9 @@ namespace Aerolite {
         // This calculation is similar to the normal impulse, but uses the tangential component of the relative linear_velocity.
         // The coefficient 'f' represents the friction coefficient, which controls how much friction is applied.
         // The formula also includes restitution 'e' and the inverse masses and moment of inertia of the objects.
-        const real impulseMagnitudeT = f * -(1 + e) * vrelDotTangent / ((a->inv_mass + b->inv_mass)
-            + (ra.Cross(tangent) * ra.Cross(tangent)) * a->inv_inertia
-            + (rb.Cross(tangent) * rb.Cross(tangent)) * b->inv_inertia);
+        const real impulseMagnitudeT = f * -(1 + e) * vrelDotTangent / ((a->GetInvMass() + b->GetInvMass())
+            + (ra.Cross(tangent) * ra.Cross(tangent)) * a->GetInvInertia()
+            + (rb.Cross(tangent) * rb.Cross(tangent)) * b->GetInvInertia());
 
         // Calculate the tangential impulse vector.
         // This is the impulse due to friction, acting along the tangent at the point of contact.
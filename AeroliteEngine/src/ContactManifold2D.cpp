@@ -0,0 +1,105 @@
+#include <cassert>
+#include "ContactManifold2D.h"
+
+namespace Aerolite {
+
+    // Points closer than this (in a's local space) are treated as the same contact
+    // when the feature ids of the old and new point do not match.
+    constexpr real PROXIMITY_MATCH_TOLERANCE_SQUARED = 4.0;
+
+    void ContactManifoldCache2D::Clear()
+    {
+        m_manifolds.clear();
+        m_touched.clear();
+    }
+
+    void ContactManifoldCache2D::BeginStep()
+    {
+        ++m_stamp;
+        m_touched.clear();
+    }
+
+    void ContactManifoldCache2D::AddManifold(const BroadPhasePair& pair, const std::span<const Contact2D> contacts,
+                                             std::pmr::vector<PenetrationConstraint>& penetrations)
+    {
+        ContactManifold2D& manifold = m_manifolds[pair.id_pair];
+        const bool isPersistent = manifold.stamp + 1 == m_stamp &&
+            manifold.generation_a == pair.a->handle.generation && manifold.generation_b == pair.b->handle.generation;
+
+        // The previous points, none if the manifold is new or belongs to bodies that were removed since.
+        const std::array<ContactPoint2D, ContactManifold2D::MAX_POINTS> previous = manifold.points;
+        const std::span<const ContactPoint2D> oldPoints(previous.data(), isPersistent ? manifold.point_count : 0);
+        manifold.point_count = 0;
+        manifold.first_constraint = penetrations.size();
+        manifold.stamp = m_stamp;
+        manifold.generation_a = pair.a->handle.generation;
+        manifold.generation_b = pair.b->handle.generation;
+
+        for (const auto& contact : contacts) {
+            ContactPoint2D point;
+            point.feature_id = contact.feature_id;
+            point.local_point = contact.a->WorldSpaceToLocalSpace(contact.start);
+
+            // Match the new point against the points of the previous step.
+            const ContactPoint2D* match = nullptr;
+            for (const auto& old : oldPoints) {
+                if (old.feature_id == point.feature_id) {
+                    match = &old;
+                    break;
+                }
+            }
+            if (match == nullptr) {
+                real closest = PROXIMITY_MATCH_TOLERANCE_SQUARED;
+                for (const auto& old : oldPoints) {
+                    const real distance = (old.local_point - point.local_point).MagnitudeSquared();
+                    if (distance < closest) {
+                        closest = distance;
+                        match = &old;
+                    }
+                }
+            }
+            if (match != nullptr) {
+                point.normal_impulse = match->normal_impulse;
+                point.tangent_impulse = match->tangent_impulse;
+            }
+
+            auto& constraint = penetrations.emplace_back(contact.a, contact.b, contact.start, contact.end, contact.normal);
+            constraint.SetCachedImpulses(point.normal_impulse, point.tangent_impulse);
+            assert(manifold.point_count < ContactManifold2D::MAX_POINTS && "Too many contact points for a manifold");
+            manifold.points[manifold.point_count++] = point;
+        }
+
+        m_touched.push_back(&manifold);
+    }
+
+    void ContactManifoldCache2D::LinkBlocks(std::pmr::vector<PenetrationConstraint>& penetrations) const
+    {
+        for (const ContactManifold2D* manifold : m_touched) {
+            if (manifold->point_count == 2) {
+                penetrations[manifold->first_constraint].LinkBlock(penetrations[manifold->first_constraint + 1]);
+            }
+        }
+    }
+
+    void ContactManifoldCache2D::StoreImpulses(const std::pmr::vector<PenetrationConstraint>& penetrations)
+    {
+        for (ContactManifold2D* manifold : m_touched) {
+            for (std::size_t i = 0; i < manifold->point_count; ++i) {
+                const PenetrationConstraint& constraint = penetrations[manifold->first_constraint + i];
+                manifold->points[i].normal_impulse = constraint.GetNormalImpulse();
+                manifold->points[i].tangent_impulse = constraint.GetTangentImpulse();
+            }
+        }
+    }
+
+    void ContactManifoldCache2D::EndStep()
+    {
+        std::erase_if(m_manifolds, [this](const auto& entry) { return entry.second.stamp != m_stamp; });
+        m_touched.clear();
+    }
+
+    std::size_t ContactManifoldCache2D::Size() const
+    {
+        return m_manifolds.size();
+    }
+}
@@ -1,8 +1,100 @@
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <limits>
+#include "AeroSimd.h"
 #include "Shape.h"
 
+namespace
+{
+    using Aerolite::PolygonLanes;
+    using Aerolite::real;
+
+    constexpr std::size_t BLOCK = PolygonLanes::PADDING; // Edges searched together by FindMinimumSeparation.
+
+    // For the edges [edge, edge + BLOCK) of polygon, writes the smallest projection of the other vertices on the
+    // edge normal, measured from the first vertex of the edge, and the index of the first vertex reaching it.
+    using SeparationBlock = void (*)(const PolygonLanes& polygon, std::size_t edge, const PolygonLanes& other,
+                                     real* minSeparation, real* minVertex);
+
+#ifdef AERO_SIMD_SSE2
+    void SeparationBlockSse2(const PolygonLanes& polygon, const std::size_t edge, const PolygonLanes& other,
+                             real* minSeparation, real* minVertex)
+    {
+        for (std::size_t half = 0; half < BLOCK; half += 2) {
+            const std::size_t i = edge + half;
+            const __m128d ax = _mm_loadu_pd(polygon.x + i);
+            const __m128d ay = _mm_loadu_pd(polygon.y + i);
+            const __m128d nx = _mm_loadu_pd(polygon.normal_x + i);
+            const __m128d ny = _mm_loadu_pd(polygon.normal_y + i);
+            __m128d best = _mm_set1_pd(std::numeric_limits<real>::max());
+            __m128d bestVertex = _mm_setzero_pd();
+            for (std::size_t j = 0; j < other.count; ++j) {
+                const __m128d dx = _mm_sub_pd(_mm_set1_pd(other.x[j]), ax);
+                const __m128d dy = _mm_sub_pd(_mm_set1_pd(other.y[j]), ay);
+                const __m128d projection = _mm_add_pd(_mm_mul_pd(dx, nx), _mm_mul_pd(dy, ny));
+                // SSE2 has no blend, the comparison mask selects between the old and the new values.
+                const __m128d less = _mm_cmplt_pd(projection, best);
+                best = _mm_or_pd(_mm_and_pd(less, projection), _mm_andnot_pd(less, best));
+                bestVertex = _mm_or_pd(_mm_and_pd(less, _mm_set1_pd(static_cast<real>(j))), _mm_andnot_pd(less, bestVertex));
+            }
+            _mm_storeu_pd(minSeparation + half, best);
+            _mm_storeu_pd(minVertex + half, bestVertex);
+        }
+    }
+
+    AERO_SIMD_TARGET_AVX void SeparationBlockAvx(const PolygonLanes& polygon, const std::size_t edge, const PolygonLanes& other,
+                                                 real* minSeparation, real* minVertex)
+    {
+        const __m256d ax = _mm256_loadu_pd(polygon.x + edge);
+        const __m256d ay = _mm256_loadu_pd(polygon.y + edge);
+        const __m256d nx = _mm256_loadu_pd(polygon.normal_x + edge);
+        const __m256d ny = _mm256_loadu_pd(polygon.normal_y + edge);
+        __m256d best = _mm256_set1_pd(std::numeric_limits<real>::max());
+        __m256d bestVertex = _mm256_setzero_pd();
+        for (std::size_t j = 0; j < other.count; ++j) {
+            const __m256d dx = _mm256_sub_pd(_mm256_set1_pd(other.x[j]), ax);
+            const __m256d dy = _mm256_sub_pd(_mm256_set1_pd(other.y[j]), ay);
+            const __m256d projection = _mm256_add_pd(_mm256_mul_pd(dx, nx), _mm256_mul_pd(dy, ny));
+            const __m256d less = _mm256_cmp_pd(projection, best, _CMP_LT_OQ);
+            best = _mm256_blendv_pd(best, projection, less);
+            bestVertex = _mm256_blendv_pd(bestVertex, _mm256_set1_pd(static_cast<real>(j)), less);
+        }
+        _mm256_storeu_pd(minSeparation, best);
+        _mm256_storeu_pd(minVertex, bestVertex);
+    }
+#else
+    void SeparationBlockScalar(const PolygonLanes& polygon, const std::size_t edge, const PolygonLanes& other,
+                               real* minSeparation, real* minVertex)
+    {
+        for (std::size_t lane = 0; lane < BLOCK; ++lane) {
+            const std::size_t i = edge + lane;
+            real best = std::numeric_limits<real>::max();
+            real bestVertex = 0;
+            for (std::size_t j = 0; j < other.count; ++j) {
+                const real projection = (other.x[j] - polygon.x[i]) * polygon.normal_x[i] +
+                    (other.y[j] - polygon.y[i]) * polygon.normal_y[i];
+                if (projection < best) {
+                    best = projection;
+                    bestVertex = static_cast<real>(j);
+                }
+            }
+            minSeparation[lane] = best;
+            minVertex[lane] = bestVertex;
+        }
+    }
+#endif
+
+    SeparationBlock SelectSeparationBlock()
+    {
+#ifdef AERO_SIMD_SSE2
+        return Aerolite::Simd::HasAvx() ? &SeparationBlockAvx : &SeparationBlockSse2;
+#else
+        return &SeparationBlockScalar;
+#endif
+    }
+}
+
 Aerolite::CircleShape::CircleShape(const real radius)
 {
     this->radius = radius;
@@ -23,26 +115,16 @@ Aerolite::real Aerolite::CircleShape::GetMomentOfInertia() const
     return 0.5f * (radius * radius);
 }
 
-void Aerolite::CircleShape::UpdateVertices(real angle, const AeroVec2& position)
-{   
-    return; // Circles don't have vertices, so nothing to do here.
-}
-
 Aerolite::BoxShape::BoxShape(const real width, const real height)
 {
     this->width = width;
     this->height = height;
 
-    // Initializing the local and world vertices too the same set. 
     this->localVertices.emplace_back(-width / 2.0, -height / 2.0);
     this->localVertices.emplace_back(width / 2.0, -height / 2.0);
     this->localVertices.emplace_back(width / 2.0, height / 2.0);
     this->localVertices.emplace_back(-width / 2.0, height / 2.0);
-
-    this->worldVertices.emplace_back(-width / 2.0, -height / 2.0);
-    this->worldVertices.emplace_back(width / 2.0, -height / 2.0);
-    this->worldVertices.emplace_back(width / 2.0, height / 2.0);
-    this->worldVertices.emplace_back(-width / 2.0, height / 2.0);
+    ComputeNormals();
 }
 
 Aerolite::ShapeType Aerolite::BoxShape::GetType() const
@@ -63,8 +145,8 @@ Aerolite::PolygonShape::PolygonShape(const std::vector<AeroVec2>& vertices)
 {
     for (auto& vertex : vertices) {
         localVertices.emplace_back(vertex);
-        worldVertices.emplace_back(vertex);
     }
+    ComputeNormals();
 }
 
 Aerolite::ShapeType Aerolite::PolygonShape::GetType() const
@@ -105,46 +187,46 @@ std::shared_ptr<Aerolite::PolygonShape> Aerolite::PolygonShape::CreateRegularPol
     return std::make_shared<PolygonShape>(vertices);
 }
 
-Aerolite::AeroVec2 Aerolite::PolygonShape::EdgeAt(int index) const
+Aerolite::AeroVec2 Aerolite::PolygonShape::EdgeAt(const std::span<const AeroVec2> vertices, int index)
 {
 	const int curVertex = index;
-	const int nextVertex = (index + 1) % worldVertices.size();
-    return (worldVertices[nextVertex] - worldVertices[curVertex]);
+	const int nextVertex = (index + 1) % vertices.size();
+    return (vertices[nextVertex] - vertices[curVertex]);
 }
 
-Aerolite::AeroVec2 Aerolite::PolygonShape::GeometricCenter(void) const
+Aerolite::AeroVec2 Aerolite::PolygonShape::GeometricCenter(const PolygonLanes& polygon)
 {
 	real sumX = 0.0f;
 	real sumY = 0.0f;
 
-    for (const auto v : worldVertices)
+    for (std::size_t i = 0; i < polygon.count; i++)
     {
-	    sumX += v.x;
-        sumY += v.y;
+	    sumX += polygon.x[i];
+        sumY += polygon.y[i];
     }
 
-    return AeroVec2(sumX / static_cast<real>(worldVertices.size()),
-                    sumY / static_cast<real>(worldVertices.size()));
+    return AeroVec2(sumX / static_cast<real>(polygon.count),
+                    sumY / static_cast<real>(polygon.count));
 }
 
-int Aerolite::PolygonShape::FindIncidentEdgeIndex(const AeroVec2& referenceEdgeNormal) const
+int Aerolite::PolygonShape::FindIncidentEdgeIndex(const PolygonLanes& polygon, const AeroVec2& referenceEdgeNormal)
 {
     int indexIncidentEdge = 0;
     real minProj = std::numeric_limits<real>::max();
-    for (int i = 0; i < this->worldVertices.size(); i++)
+    for (std::size_t i = 0; i < polygon.count; i++)
     {
-        auto edgeNormal = EdgeAt(i).Normal();
-        const auto proj = edgeNormal.Dot(referenceEdgeNormal);
+        // The normals are kept rotated with the body, no square root is needed here.
+        const auto proj = polygon.normal_x[i] * referenceEdgeNormal.x + polygon.normal_y[i] * referenceEdgeNormal.y;
         if (proj < minProj) {
             minProj = proj;
-            indexIncidentEdge = i;
+            indexIncidentEdge = static_cast<int>(i);
         }
     }
 
     return indexIncidentEdge;
 }
 
-int Aerolite::PolygonShape::ClipLineSegmentToLine(const std::vector<AeroVec2>& contactsIn, std::vector<AeroVec2>& contactsOut, const AeroVec2& c0, const AeroVec2& c1)
+int Aerolite::PolygonShape::ClipLineSegmentToLine(const std::array<AeroVec2, 2>& contactsIn, std::array<AeroVec2, 2>& contactsOut, const AeroVec2& c0, const AeroVec2& c1)
 {
     // Start with no output points.
     int numOut = 0;
@@ -174,45 +256,55 @@ int Aerolite::PolygonShape::ClipLineSegmentToLine(const std::vector<AeroVec2>& c
     return numOut;
 }
 
-Aerolite::real Aerolite::PolygonShape::FindMinimumSeparation(const PolygonShape& other, int& indexReferenceEdge, AeroVec2& supportPoint) const
+Aerolite::real Aerolite::PolygonShape::FindMinimumSeparation(const PolygonLanes& polygon, const PolygonLanes& other,
+                                                             int& indexReferenceEdge, AeroVec2& supportPoint)
 {
+    static const SeparationBlock searchBlock = SelectSeparationBlock();
+
 	real separation = std::numeric_limits<real>::lowest();
 
-    for (int i = 0; i < worldVertices.size(); i++)
+    for (std::size_t edge = 0; edge < polygon.count; edge += BLOCK)
     {
-	    AeroVec2 va = worldVertices[i];
-	    AeroVec2 normal = EdgeAt(i).Normal().UnitVector();
+        real minSeparation[BLOCK];
+        real minVertex[BLOCK];
+        searchBlock(polygon, edge, other, minSeparation, minVertex);
 
-	    real minSep = std::numeric_limits <real>::max();
-        AeroVec2 minVertex;
-        for (auto vb : other.worldVertices)
+        // The padding lanes past the last edge are ignored. Edges are taken in order, so ties go to the first one.
+        const std::size_t lanes = std::min(BLOCK, polygon.count - edge);
+        for (std::size_t lane = 0; lane < lanes; ++lane)
         {
-	        const real projection = (vb - va).Dot(normal);
-            if (projection < minSep) {
-                minSep = projection;
-                minVertex = vb;
+            if (minSeparation[lane] > separation)
+            {
+                separation = minSeparation[lane];
+                indexReferenceEdge = static_cast<int>(edge + lane);
+                supportPoint = other.Vertex(static_cast<std::size_t>(minVertex[lane]));
             }
         }
 
-        if (minSep > separation)
-        {
-            separation = minSep;
-            indexReferenceEdge = i;
-            supportPoint = minVertex;
-        }
-
         if (separation > 0) return separation;
     }
 
     return separation;
 }
 
-void Aerolite::PolygonShape::UpdateVertices(const real angle, const AeroVec2& position)
+void Aerolite::PolygonShape::TransformVertices(const real angle, const AeroVec2& position, const std::span<AeroVec2> worldVertices) const
 {
-    // Rotate first, then translate.
+    // Rotate first, then translate. The same sine and cosine serve every vertex.
+    const real cos = std::cos(angle);
+    const real sin = std::sin(angle);
     for (int i = 0; i < localVertices.size(); i++)
     {
-        worldVertices[i] = localVertices[i].Rotate(angle);
+        const AeroVec2& local = localVertices[i];
+        worldVertices[i] = AeroVec2(local.x * cos - local.y * sin, local.x * sin + local.y * cos);
         worldVertices[i] += position;
     }
 }
+
+void Aerolite::PolygonShape::ComputeNormals()
+{
+    localNormals.resize(localVertices.size());
+    for (std::size_t i = 0; i < localVertices.size(); i++)
+    {
+        localNormals[i] = EdgeAt(localVertices, static_cast<int>(i)).Normal();
+    }
+}
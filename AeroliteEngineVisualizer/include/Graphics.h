@@ -5,6 +5,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <AeroVec2.h>
+#include <span>
 #include <vector>
 
 struct Graphics {
@@ -24,8 +25,8 @@ struct Graphics {
     static void DrawFillCircle(int x, int y, int radius, Uint32 color);
     static void DrawRect(int x, int y, int width, int height, Uint32 color);
     static void DrawFillRect(int x, int y, int width, int height, Uint32 color);
-    static void DrawPolygon(int x, int y, const std::vector<Aerolite::AeroVec2>& vertices, Uint32 color);
-    static void DrawFillPolygon(int x, int y, const std::vector<Aerolite::AeroVec2>& vertices, Uint32 color);
+    static void DrawPolygon(int x, int y, std::span<const Aerolite::AeroVec2> vertices, Uint32 color);
+    static void DrawFillPolygon(int x, int y, std::span<const Aerolite::AeroVec2> vertices, Uint32 color);
     static void DrawTexture(int x, int y, int width, int height, float rotation, SDL_Texture* texture);
 };
 
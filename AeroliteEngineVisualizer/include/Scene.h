@@ -27,6 +27,9 @@ namespace Aerolite {
         virtual ~Scene() = default;
 
         void UpdatePhysicsProperties(const real friction, const real restitution) const;
+        // Vertices of a polygon at the given pose, for drawing a body at an interpolated pose.
+        // The body's own world vertices are left alone, the world collides with them.
+        static std::vector<AeroVec2> GetPoseVertices(const PolygonShape& polygon, const AeroVec2& position, real rotation);
         AeroWorld2D* GetWorld() const { return world.get(); }
     };
 
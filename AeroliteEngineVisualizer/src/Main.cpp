@@ -75,7 +75,7 @@ int main(int argc, char* args[]) {
         }
 
         if (ImGui::CollapsingHeader("Broadphase Options")) {
-            static const char* broadPhaseAlgNames[] = { "Brute Force", "Spatial Hash Grid" };
+            static const char* broadPhaseAlgNames[] = { "Brute Force", "Spatial Hash Grid", "Bounding Volume Hierarchy", "Sweep and Prune" };
             static int currentAlg = 0; // default to Brute Force
 
             // Dropdown to select broad phase algorithm
@@ -29,8 +29,9 @@ namespace Aerolite {
             int x, y;
             SDL_GetMouseState(&x, &y);
             const auto bodies = world->GetBodies();
-            bodies[0]->position.x = x;
-            bodies[0]->position.y = y;
+            bodies[0]->SetPosition(AeroVec2(x, y));
+            // The body is static, the world does not move its vertices for the collisions.
+            bodies[0]->UpdateWorldVertices();
             break;
         }
 
@@ -40,23 +41,15 @@ namespace Aerolite {
     // Update function (called several times per second to update objects)
     ///////////////////////////////////////////////////////////////////////////////
     void AirplaneShootingScene::Update() {
-        // Check if we are too fast, and if so, waste some milliseconds until we reach
-        // MILLISECONDS_PER_FRAME.
-        const int timeToWait = MILLISECS_PER_FRAME - (SDL_GetTicks() - timePreviousFrame);
-        if (timeToWait > 0) {
-            SDL_Delay(timeToWait);
-        }
-
-        // Calculate the delta time factor in seconds to be used when we update objects
-        float deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
-        if (deltaTime > 0.016) {
-            deltaTime = 0.016;
-        }
+        // Calculate the frame time in seconds. The renderer waits for the display's vertical sync and the
+        // world runs fixed steps out of the frame time, capping how many it catches up on, so the frame is
+        // neither delayed nor clamped here.
+        const real deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
 
         // Set the time of the current frame to be used in the next one.
         timePreviousFrame = SDL_GetTicks();
 
-        world->Update(deltaTime);
+        world->Step(deltaTime);
     }
 
     ///////////////////////////////////////////////////////////////////////////////
@@ -65,22 +58,20 @@ namespace Aerolite {
     void AirplaneShootingScene::Render() {
         Graphics::ClearScreen(0xFF000000);
         const auto bodies = world->GetBodies();
+        const real alpha = world->GetInterpolationAlpha();
         int i = 0;
         for (const auto& body : bodies) {
+            // Draw every body between its last two fixed steps, so motion is smooth at any frame rate.
+            const AeroVec2 position = body->GetInterpolatedPosition(alpha);
+            const real rotation = body->GetInterpolatedRotation(alpha);
             if (body->shape->GetType() == Circle) {
-                const auto circleShape = std::dynamic_pointer_cast<CircleShape>(body->shape);
-                Graphics::DrawCircle(body->position.x, body->position.y, circleShape->radius, body->rotation, 0xFFFFFFFF);
-            }
-            else  if (body->shape->GetType() == Box) {
-                const auto boxShape = std::dynamic_pointer_cast<BoxShape>(body->shape);
-                boxShape->UpdateVertices(body->rotation, body->position);
-                Graphics::DrawPolygon(body->position.x, body->position.y, boxShape->worldVertices, m_bodyColors[i++]);
+                const auto circleShape = std::dynamic_pointer_cast<const CircleShape>(body->shape);
+                Graphics::DrawCircle(position.x, position.y, circleShape->radius, rotation, 0xFFFFFFFF);
             }
-            else if (body->shape->GetType() == Polygon)
+            else if (body->shape->GetType() == Box || body->shape->GetType() == Polygon)
             {
-                const auto polygonShape = std::dynamic_pointer_cast<PolygonShape>(body->shape);
-                polygonShape->UpdateVertices(body->rotation, body->position);
-                Graphics::DrawPolygon(body->position.x, body->position.y, polygonShape->worldVertices, m_bodyColors[i++]);
+                const auto& polygonShape = static_cast<const PolygonShape&>(*body->shape);
+                Graphics::DrawPolygon(position.x, position.y, GetPoseVertices(polygonShape, position, rotation), m_bodyColors[i++]);
             }
 
             auto contacts = world->GetContacts();
@@ -36,27 +36,27 @@ namespace Aerolite {
         // Add a stack of boxes
         for (int i = 1; i <= 4; i++) {
             const float mass = 10.0f / static_cast<real>(i);
-            const auto box = world->CreateBody2D(std::make_shared<BoxShape>(50, 50), 600, floor->position.y - i * 55, mass);
+            const auto box = world->CreateBody2D(std::make_shared<BoxShape>(50, 50), 600, floor->GetPosition().y - i * 55, mass);
             box->SetFriction(0.9f);
             box->SetRestitution(0.1f);
         }
 
         // Add structure with blocks
-        const auto plank1 = world->CreateBody2D(std::make_shared<BoxShape>(50, 150), Graphics::Width() / make_real<real>(2.0) + 20, floor->position.y - 100, make_real<real>(5.0));
-        const auto plank2 = world->CreateBody2D(std::make_shared<BoxShape>(50, 150), Graphics::Width() / make_real<real>(2.0) + 180, floor->position.y - 100, make_real<real>(5.0));
-        const auto plank3 = world->CreateBody2D(std::make_shared<BoxShape>(250, 25), Graphics::Width() / make_real<real>(2.0) + 100.0f, floor->position.y - 200, make_real<real>(2.0));
+        const auto plank1 = world->CreateBody2D(std::make_shared<BoxShape>(50, 150), Graphics::Width() / make_real<real>(2.0) + 20, floor->GetPosition().y - 100, make_real<real>(5.0));
+        const auto plank2 = world->CreateBody2D(std::make_shared<BoxShape>(50, 150), Graphics::Width() / make_real<real>(2.0) + 180, floor->GetPosition().y - 100, make_real<real>(5.0));
+        const auto plank3 = world->CreateBody2D(std::make_shared<BoxShape>(250, 25), Graphics::Width() / make_real<real>(2.0) + 100.0f, floor->GetPosition().y - 200, make_real<real>(2.0));
 
 
         // Add a triangle polygon
         const std::vector triangleVertices = { Vec2(30, 30), Vec2(-30, 30), Vec2(0, -30) };
-        auto triangle = world->CreateBody2D(std::make_shared<PolygonShape>(triangleVertices), plank3->position.x, plank3->position.y - 50, make_real<real>(0.5));
+        auto triangle = world->CreateBody2D(std::make_shared<PolygonShape>(triangleVertices), plank3->GetPosition().x, plank3->GetPosition().y - 50, make_real<real>(0.5));
 
         // Add a pyramid of boxes
         const int numRows = 5;
         for (int col = 0; col < numRows; col++) {
             for (int row = 0; row < col; row++) {
-                const float x = plank3->position.x + 200.0f + col * 50.0f - row * 25.0f;
-                const float y = floor->position.y - 50.0f - row * 52.0f;
+                const float x = plank3->GetPosition().x + 200.0f + col * 50.0f - row * 25.0f;
+                const float y = floor->GetPosition().y - 50.0f - row * 52.0f;
                 const float mass = 5.0f / (row + 1.0f);
                 const auto box = world->CreateBody2D(std::make_shared<BoxShape>(50, 50), x, y, mass);
                 box->SetFriction(0.9f);
@@ -75,8 +75,8 @@ namespace Aerolite {
         for (int i = 1; i <= numSteps; i++) {
 
             // Calculate the position of the new step
-            const real x = lastStep->position.x + 30 + i;
-            const real y = lastStep->position.y + 20;
+            const real x = lastStep->GetPosition().x + 30 + i;
+            const real y = lastStep->GetPosition().y + 20;
 
             // Set the mass for the current step (0.0 for the last step, 3.0 for others)
             const real mass = (i == numSteps) ? 0.0f : 3.0f;
@@ -85,17 +85,17 @@ namespace Aerolite {
             auto step = world->CreateBody2D(std::make_shared<CircleShape>(15), x, y, mass);
 
             // Connect the current step to the previous step using a joint constraint
-            world->AddJointConstraint(lastStep, step, step->position);
+            world->AddJointConstraint(lastStep, step, step->GetPosition());
 
             // Update lastStep to be the current step for the next iteration
             lastStep = step;
         }
 
-        auto endStep = world->CreateBody2D(std::make_shared<BoxShape>(80, 20), lastStep->position.x + 60, lastStep->position.y - 20, make_real<real>(0.0));
+        auto endStep = world->CreateBody2D(std::make_shared<BoxShape>(80, 20), lastStep->GetPosition().x + 60, lastStep->GetPosition().y - 20, make_real<real>(0.0));
 
-        auto pig1 = world->CreateBody2D(std::make_shared<CircleShape>(30), plank1->position.x + 80, floor->position.y - 50, make_real<real>(3.0));
-        auto pig2 = world->CreateBody2D(std::make_shared<CircleShape>(30), plank2->position.x + 400, floor->position.y - 50, make_real<real>(3.0));
-        auto pig3 = world->CreateBody2D(std::make_shared<CircleShape>(30), plank2->position.x + 460, floor->position.y - 50, make_real<real>(3.0));
+        auto pig1 = world->CreateBody2D(std::make_shared<CircleShape>(30), plank1->GetPosition().x + 80, floor->GetPosition().y - 50, make_real<real>(3.0));
+        auto pig2 = world->CreateBody2D(std::make_shared<CircleShape>(30), plank2->GetPosition().x + 400, floor->GetPosition().y - 50, make_real<real>(3.0));
+        auto pig3 = world->CreateBody2D(std::make_shared<CircleShape>(30), plank2->GetPosition().x + 460, floor->GetPosition().y - 50, make_real<real>(3.0));
         auto pig4 = world->CreateBody2D(std::make_shared<CircleShape>(30), 220, 130, make_real<real>(1.0));
 
         for (auto& body : world->GetBodies())
@@ -185,23 +185,15 @@ namespace Aerolite {
     // Update function (called several times per second to update objects)
     ///////////////////////////////////////////////////////////////////////////////
     void FiveDollarFlappyBirdScene::Update() {
-        // Check if we are too fast, and if so, waste some milliseconds until we reach
-        // MILLISECONDS_PER_FRAME.
-        const int time_to_wait = MILLISECS_PER_FRAME - (SDL_GetTicks() - timePreviousFrame);
-        if (time_to_wait > 0) {
-            SDL_Delay(time_to_wait);
-        }
-
-        // Calculate the delta time factor in seconds to be used when we update objects
-        real delta_time = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
-        if (delta_time > 0.016f) {
-            delta_time = 0.016f;
-        }
+        // Calculate the frame time in seconds. The renderer waits for the display's vertical sync and the
+        // world runs fixed steps out of the frame time, capping how many it catches up on, so the frame is
+        // neither delayed nor clamped here.
+        const real delta_time = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
 
         // Set the time of the current frame to be used in the next one.
         timePreviousFrame = SDL_GetTicks();
 
-        world->Update(delta_time);
+        world->Step(delta_time);
     }
 
     ///////////////////////////////////////////////////////////////////////////////
@@ -209,19 +201,19 @@ namespace Aerolite {
     ///////////////////////////////////////////////////////////////////////////////
     void FiveDollarFlappyBirdScene::Render() {
         Graphics::ClearScreen(0xFF000000);
+        const real alpha = world->GetInterpolationAlpha();
         int i = 0;
         for (const auto& body : world->GetBodies()) {
+            // Draw every body between its last two fixed steps, so motion is smooth at any frame rate.
+            const AeroVec2 position = body->GetInterpolatedPosition(alpha);
+            const real rotation = body->GetInterpolatedRotation(alpha);
             if (body->shape->GetType() == Circle) {
-                const auto circleShape = std::dynamic_pointer_cast<CircleShape>(body->shape);
-                Graphics::DrawCircle(body->position.x, body->position.y, circleShape->radius, body->rotation, m_bodyColors[i++]);
-            }
-            else  if (body->shape->GetType() == Box) {
-                const auto boxShape = std::dynamic_pointer_cast<BoxShape>(body->shape);
-                Graphics::DrawFillPolygon(body->position.x, body->position.y, boxShape->worldVertices, m_bodyColors[i++]);
+                const auto circleShape = std::dynamic_pointer_cast<const CircleShape>(body->shape);
+                Graphics::DrawCircle(position.x, position.y, circleShape->radius, rotation, m_bodyColors[i++]);
             }
-            else  if (body->shape->GetType() == Polygon) {
-                const auto boxShape = std::dynamic_pointer_cast<PolygonShape>(body->shape);
-                Graphics::DrawFillPolygon(body->position.x, body->position.y, boxShape->worldVertices, m_bodyColors[i++]);
+            else  if (body->shape->GetType() == Box || body->shape->GetType() == Polygon) {
+                const auto& polygonShape = static_cast<const PolygonShape&>(*body->shape);
+                Graphics::DrawFillPolygon(position.x, position.y, GetPoseVertices(polygonShape, position, rotation), m_bodyColors[i++]);
             }
         }
 
@@ -21,10 +21,10 @@ namespace Aerolite {
         }
 
         for (int i = 0; i < numBodies - 1; i++) {
-            std::vector<std::shared_ptr<AeroBody2D>>& bodies = world->GetBodies();
+            const auto bodies = world->GetBodies();
             const auto a = bodies[i];
             const auto b = bodies[i + 1];
-            world->AddJointConstraint(a, b, a->position);
+            world->AddJointConstraint(a, b, a->GetPosition());
         }
 
     }
@@ -70,23 +70,15 @@ namespace Aerolite {
     // Update function (called several times per second to update objects)
     ///////////////////////////////////////////////////////////////////////////////
     void JointConstraintScene::Update() {
-        // Check if we are too fast, and if so, waste some milliseconds until we reach
-        // MILLISECONDS_PER_FRAME.
-        const int timeToWait = MILLISECS_PER_FRAME - (SDL_GetTicks() - timePreviousFrame);
-        if (timeToWait > 0) {
-            SDL_Delay(timeToWait);
-        }
-
-        // Calculate the delta time factor in seconds to be used when we update objects
-        float deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
-        if (deltaTime > 0.016) {
-            deltaTime = 0.016;
-        }
+        // Calculate the frame time in seconds. The renderer waits for the display's vertical sync and the
+        // world runs fixed steps out of the frame time, capping how many it catches up on, so the frame is
+        // neither delayed nor clamped here.
+        const real deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
 
         // Set the time of the current frame to be used in the next one.
         timePreviousFrame = SDL_GetTicks();
 
-        world->Update(deltaTime);
+        world->Step(deltaTime);
     }
 
     ///////////////////////////////////////////////////////////////////////////////
@@ -94,18 +86,22 @@ namespace Aerolite {
     ///////////////////////////////////////////////////////////////////////////////
     void JointConstraintScene::Render() {
         Graphics::ClearScreen(0xFF000000);
+        const real alpha = world->GetInterpolationAlpha();
         for (const auto& body : world->GetBodies()) {
+            // Draw every body between its last two fixed steps, so motion is smooth at any frame rate.
+            const AeroVec2 position = body->GetInterpolatedPosition(alpha);
+            const real rotation = body->GetInterpolatedRotation(alpha);
             if (body->shape->GetType() == Circle) {
-                const auto circleShape = std::dynamic_pointer_cast<CircleShape>(body->shape);
-                Graphics::DrawCircle(body->position.x, body->position.y, circleShape->radius, body->rotation, 0xFFFFFFFF);
+                const auto circleShape = std::dynamic_pointer_cast<const CircleShape>(body->shape);
+                Graphics::DrawCircle(position.x, position.y, circleShape->radius, rotation, 0xFFFFFFFF);
             }
             else  if (body->shape->GetType() == Box) {
-                const auto boxShape = std::dynamic_pointer_cast<BoxShape>(body->shape);
-                Graphics::DrawFillPolygon(body->position.x, body->position.y, boxShape->worldVertices, 0xFFFFFFFF);
+                const auto& polygonShape = static_cast<const PolygonShape&>(*body->shape);
+                Graphics::DrawFillPolygon(position.x, position.y, GetPoseVertices(polygonShape, position, rotation), 0xFFFFFFFF);
             }
             else  if (body->shape->GetType() == Polygon) {
-                const auto boxShape = std::dynamic_pointer_cast<PolygonShape>(body->shape);
-                Graphics::DrawFillPolygon(body->position.x, body->position.y, boxShape->worldVertices, 0xFFFF0000);
+                const auto& polygonShape = static_cast<const PolygonShape&>(*body->shape);
+                Graphics::DrawFillPolygon(position.x, position.y, GetPoseVertices(polygonShape, position, rotation), 0xFFFF0000);
             }
         }
 
@@ -23,7 +23,7 @@ namespace Aerolite {
 
             // Create the body with the shape and add it to the world
             const auto body = world->CreateBody2D(std::make_shared<CircleShape>(radius), position.x, position.y, /* Mass */ 1.0);
-            body->linear_velocity = linearVelocity;
+            body->SetLinearVelocity(linearVelocity);
         }
     }
 
@@ -60,40 +60,35 @@ namespace Aerolite {
     // Update function (called several times per second to update objects)
     ///////////////////////////////////////////////////////////////////////////////
     void LargeParticleTestScene::Update() {
-        // Check if we are too fast, and if so, waste some milliseconds until we reach
-        // MILLISECONDS_PER_FRAME.
-        const int timeToWait = MILLISECS_PER_FRAME - (SDL_GetTicks() - timePreviousFrame);
-        if (timeToWait > 0) {
-            SDL_Delay(timeToWait);
-        }
-
-        // Calculate the delta time factor in seconds to be used when we update objects
-        real deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
-        if (deltaTime > 0.016) {
-            deltaTime = 0.016;
-        }
+        // Calculate the frame time in seconds. The renderer waits for the display's vertical sync and the
+        // world runs fixed steps out of the frame time, capping how many it catches up on, so the frame is
+        // neither delayed nor clamped here.
+        const real deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
 
         // Set the time of the current frame to be used in the next one.
         timePreviousFrame = SDL_GetTicks();
 
-        world->Update(deltaTime);
+        world->Step(deltaTime);
 
         for (const auto& body : world->GetBodies())
         {
             if (body->shape->GetType() == Circle)
             {
-                const auto circleShape = std::dynamic_pointer_cast<CircleShape>(body->shape);
+                const auto circleShape = std::dynamic_pointer_cast<const CircleShape>(body->shape);
                 const real radius = circleShape->radius;
+                const AeroVec2 position = body->GetPosition();
+                AeroVec2 velocity = body->GetLinearVelocity();
 
                 // Check collision with left and right boundaries
-                if (body->position.x - radius < 0 || body->position.x + radius > Graphics::Width()) {
-                    body->linear_velocity.x = -body->linear_velocity.x;
+                if (position.x - radius < 0 || position.x + radius > Graphics::Width()) {
+                    velocity.x = -velocity.x;
                 }
 
                 // Check collision with top and bottom boundaries
-                if (body->position.y - radius < 0 || body->position.y + radius > Graphics::Height()) {
-                    body->linear_velocity.y = -body->linear_velocity.y;
+                if (position.y - radius < 0 || position.y + radius > Graphics::Height()) {
+                    velocity.y = -velocity.y;
                 }
+                body->SetLinearVelocity(velocity);
             }
         }
     }
@@ -104,14 +99,18 @@ namespace Aerolite {
     void LargeParticleTestScene::Render() {
         Graphics::ClearScreen(0xFF000000);
         const auto bodies = world->GetBodies();
+        const real alpha = world->GetInterpolationAlpha();
         for (const auto& body : bodies) {
+            // Draw every body between its last two fixed steps, so motion is smooth at any frame rate.
+            const AeroVec2 position = body->GetInterpolatedPosition(alpha);
+            const real rotation = body->GetInterpolatedRotation(alpha);
             if (body->shape->GetType() == Circle) {
-                const auto circleShape = std::dynamic_pointer_cast<CircleShape>(body->shape);
-                Graphics::DrawCircle(body->position.x, body->position.y, circleShape->radius, body->rotation, 0xFFFFFFFF);
+                const auto circleShape = std::dynamic_pointer_cast<const CircleShape>(body->shape);
+                Graphics::DrawCircle(position.x, position.y, circleShape->radius, rotation, 0xFFFFFFFF);
             }
             else  if (body->shape->GetType() == Box) {
-                const auto boxShape = std::dynamic_pointer_cast<BoxShape>(body->shape);
-                Graphics::DrawPolygon(body->position.x, body->position.y, boxShape->worldVertices, 0xFFFFFFFF);
+                const auto& polygonShape = static_cast<const PolygonShape&>(*body->shape);
+                Graphics::DrawPolygon(position.x, position.y, GetPoseVertices(polygonShape, position, rotation), 0xFFFFFFFF);
             }
         }
 
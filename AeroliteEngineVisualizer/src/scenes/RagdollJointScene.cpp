@@ -17,19 +17,19 @@ namespace Aerolite {
 
         // Add rag doll parts (rigid bodies)
         const auto bob = world->CreateBody2D(std::make_shared< CircleShape>(5), Graphics::Width() / make_real<real>(2.0), Graphics::Height() / make_real<real>(2.0), make_real<real>(0.0));
-        const auto head = world->CreateBody2D(std::make_shared< CircleShape>(25), bob->position.x, bob->position.y + 70, make_real<real>(5.0));
-        const auto torso = world->CreateBody2D(std::make_shared< BoxShape>(50, 100), head->position.x, head->position.y + 80, make_real<real>(3.0));
-        const auto leftArm = world->CreateBody2D(std::make_shared<BoxShape>(15, 70), torso->position.x - 32, torso->position.y - 10, make_real<real>(1.0));
-        const auto rightArm = world->CreateBody2D(std::make_shared<BoxShape>(15, 70), torso->position.x + 32, torso->position.y - 10, make_real<real>(1.0));
-        const auto leftLeg = world->CreateBody2D(std::make_shared<BoxShape>(20, 90), torso->position.x - 20, torso->position.y + 97, make_real<real>(1.0));
-        const auto rightLeg = world->CreateBody2D(std::make_shared<BoxShape>(20, 90), torso->position.x + 20, torso->position.y + 97, make_real<real>(1.0));
-
-        world->AddJointConstraint(bob, head, bob->position);
-        world->AddJointConstraint(head, torso, head->position + Vec2(0, 25));
-        world->AddJointConstraint(torso, leftArm, torso->position + Vec2(-28, -45));
-        world->AddJointConstraint(torso, rightArm, torso->position + Vec2(+28, -45));
-        world->AddJointConstraint(torso, leftLeg, torso->position + Vec2(-20, 50));
-        world->AddJointConstraint(torso, rightLeg, torso->position + Vec2(20, 50));
+        const auto head = world->CreateBody2D(std::make_shared< CircleShape>(25), bob->GetPosition().x, bob->GetPosition().y + 70, make_real<real>(5.0));
+        const auto torso = world->CreateBody2D(std::make_shared< BoxShape>(50, 100), head->GetPosition().x, head->GetPosition().y + 80, make_real<real>(3.0));
+        const auto leftArm = world->CreateBody2D(std::make_shared<BoxShape>(15, 70), torso->GetPosition().x - 32, torso->GetPosition().y - 10, make_real<real>(1.0));
+        const auto rightArm = world->CreateBody2D(std::make_shared<BoxShape>(15, 70), torso->GetPosition().x + 32, torso->GetPosition().y - 10, make_real<real>(1.0));
+        const auto leftLeg = world->CreateBody2D(std::make_shared<BoxShape>(20, 90), torso->GetPosition().x - 20, torso->GetPosition().y + 97, make_real<real>(1.0));
+        const auto rightLeg = world->CreateBody2D(std::make_shared<BoxShape>(20, 90), torso->GetPosition().x + 20, torso->GetPosition().y + 97, make_real<real>(1.0));
+
+        world->AddJointConstraint(bob, head, bob->GetPosition());
+        world->AddJointConstraint(head, torso, head->GetPosition() + Vec2(0, 25));
+        world->AddJointConstraint(torso, leftArm, torso->GetPosition() + Vec2(-28, -45));
+        world->AddJointConstraint(torso, rightArm, torso->GetPosition() + Vec2(+28, -45));
+        world->AddJointConstraint(torso, leftLeg, torso->GetPosition() + Vec2(-20, 50));
+        world->AddJointConstraint(torso, rightLeg, torso->GetPosition() + Vec2(20, 50));
 
         const auto floor = world->CreateBody2D(std::make_shared<BoxShape>(Graphics::Width() - 50, 50),
             Graphics::Width() / make_real<real>(2.0), Graphics::Height() - 50, make_real<real>(0.0));
@@ -80,10 +80,10 @@ namespace Aerolite {
             int x, y;
             SDL_GetMouseState(&x, &y);
             const auto mouse = Vec2(x, y);
-            const std::shared_ptr<AeroBody2D> bob = world->GetBodies()[0];
-            const Vec2 direction = (mouse - bob->position).UnitVector();
+            AeroBody2D* bob = world->GetBodies()[0];
+            const Vec2 direction = (mouse - bob->GetPosition()).UnitVector();
             const real speed = make_real<real>(5.0);
-            bob->position += direction * speed;
+            bob->SetPosition(bob->GetPosition() + direction * speed);
         }
 
     }
@@ -92,23 +92,15 @@ namespace Aerolite {
     // Update function (called several times per second to update objects)
     ///////////////////////////////////////////////////////////////////////////////
     void RagdollJointScene::Update() {
-        // Check if we are too fast, and if so, waste some milliseconds until we reach
-        // MILLISECONDS_PER_FRAME.
-        const int timeToWait = MILLISECS_PER_FRAME - (SDL_GetTicks() - timePreviousFrame);
-        if (timeToWait > 0) {
-            SDL_Delay(timeToWait);
-        }
-
-        // Calculate the delta time factor in seconds to be used when we update objects
-        float deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
-        if (deltaTime > 0.016) {
-            deltaTime = 0.016;
-        }
+        // Calculate the frame time in seconds. The renderer waits for the display's vertical sync and the
+        // world runs fixed steps out of the frame time, capping how many it catches up on, so the frame is
+        // neither delayed nor clamped here.
+        const real deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
 
         // Set the time of the current frame to be used in the next one.
         timePreviousFrame = SDL_GetTicks();
 
-        world->Update(deltaTime);
+        world->Step(deltaTime);
     }
 
     ///////////////////////////////////////////////////////////////////////////////
@@ -117,9 +109,13 @@ namespace Aerolite {
     void RagdollJointScene::Render() {
         Graphics::ClearScreen(0xFF000000);
 
+        // Draw every body between its last two fixed steps, so motion is smooth at any frame rate.
+        const real alpha = world->GetInterpolationAlpha();
         const auto bob = world->GetBodies()[0];
         const auto head = world->GetBodies()[1];
-        Graphics::DrawLine(bob->position.x, bob->position.y, head->position.x, head->position.y, 0xFFFFFFFF);
+        const AeroVec2 bobPosition = bob->GetInterpolatedPosition(alpha);
+        const AeroVec2 headPosition = head->GetInterpolatedPosition(alpha);
+        Graphics::DrawLine(bobPosition.x, bobPosition.y, headPosition.x, headPosition.y, 0xFFFFFFFF);
 
         for (const auto& joint : world->GetConstraints()) {
             if (debug) {
@@ -129,17 +125,19 @@ namespace Aerolite {
         }
 
         for (const auto& body : world->GetBodies()) {
+            const AeroVec2 position = body->GetInterpolatedPosition(alpha);
+            const real rotation = body->GetInterpolatedRotation(alpha);
             if (body->shape->GetType() == Circle) {
-                const auto circleShape = std::dynamic_pointer_cast<CircleShape>(body->shape);
-                Graphics::DrawCircle(body->position.x, body->position.y, circleShape->radius, body->rotation, 0xFFFFFFFF);
+                const auto circleShape = std::dynamic_pointer_cast<const CircleShape>(body->shape);
+                Graphics::DrawCircle(position.x, position.y, circleShape->radius, rotation, 0xFFFFFFFF);
             }
             else  if (body->shape->GetType() == Box) {
-                const auto boxShape = std::dynamic_pointer_cast<BoxShape>(body->shape);
-                Graphics::DrawPolygon(body->position.x, body->position.y, boxShape->worldVertices, 0xFFFFFFFF);
+                const auto& polygonShape = static_cast<const PolygonShape&>(*body->shape);
+                Graphics::DrawPolygon(position.x, position.y, GetPoseVertices(polygonShape, position, rotation), 0xFFFFFFFF);
             }
             else  if (body->shape->GetType() == Polygon) {
-                const auto boxShape = std::dynamic_pointer_cast<PolygonShape>(body->shape);
-                Graphics::DrawPolygon(body->position.x, body->position.y, boxShape->worldVertices, 0xFFFF0000);
+                const auto& polygonShape = static_cast<const PolygonShape&>(*body->shape);
+                Graphics::DrawPolygon(position.x, position.y, GetPoseVertices(polygonShape, position, rotation), 0xFFFF0000);
             }
         }
     }
@@ -15,6 +15,13 @@ namespace Aerolite {
 			body->SetRestitution(restitution);
 		}
 	}
+
+	std::vector<AeroVec2> Scene::GetPoseVertices(const PolygonShape& polygon, const AeroVec2& position, const real rotation)
+	{
+		std::vector<AeroVec2> vertices(polygon.localVertices.size());
+		polygon.TransformVertices(rotation, position, vertices);
+		return vertices;
+	}
 }
 
 
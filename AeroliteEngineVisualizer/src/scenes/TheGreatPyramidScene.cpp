@@ -30,13 +30,16 @@ namespace Aerolite {
         auto rightWall = world->CreateBody2D(std::make_shared<BoxShape>(50, Graphics::Height() * 10), Graphics::Width(),
             Graphics::Height() / make_real<real>(2.0) - 35, make_real<real>(0.0));
 
+        // Every box of the pyramid shares one shape.
+        const auto boxShape = std::make_shared<BoxShape>(50, 50);
+
         // Flipping the pyramid around
         for (int row = 0; row < pyramidHeight; ++row) {
             for (int col = 0; col <= row; ++col) {
                 const float baseY = 40.0f;
                 const float x = (Graphics::Width() / 2.0f) + (col - row / 2.0f) * 50.0f; // Center the pyramid
                 const float y = baseY + row * 50.0f; // Stack rows upwards
-                const auto box = world->CreateBody2D(std::make_shared<BoxShape>(50, 50), x, y, 1.0f);
+                const auto box = world->CreateBody2D(boxShape, x, y, 1.0f);
                 box->friction = 0.5f;
                 box->restitution = 0.1f;
             }
@@ -75,23 +78,16 @@ namespace Aerolite {
     // Update function (called several times per second to update objects)
     ///////////////////////////////////////////////////////////////////////////////
     void TheGreatPyramidScene::Update() {
-        // Check if we are too fast, and if so, waste some milliseconds until we reach
-        // MILLISECONDS_PER_FRAME.
-        const int timeToWait = MILLISECS_PER_FRAME - (SDL_GetTicks() - timePreviousFrame);
-        if (timeToWait > 0) {
-            SDL_Delay(timeToWait);
-        }
-
-        // Calculate the delta time factor in seconds to be used when we update objects
-        float deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
-        if (deltaTime > 0.016) {
-            deltaTime = 0.016;
-        }
+        // Calculate the frame time in seconds. The renderer waits for the display's vertical sync and the
+        // world runs fixed steps out of the frame time, capping how many it catches up on, so the frame is
+        // neither delayed nor clamped here.
+        const real deltaTime = (SDL_GetTicks() - timePreviousFrame) / 1000.0f;
 
         // Set the time of the current frame to be used in the next one.
         timePreviousFrame = SDL_GetTicks();
 
-        world->Update(deltaTime);
+        // Step on the world's step thread while this frame renders the snapshot of the previous step.
+        world->StepAsync(deltaTime);
     }
 
     ///////////////////////////////////////////////////////////////////////////////
@@ -106,25 +102,26 @@ namespace Aerolite {
         ImGui::End();
 
         Graphics::ClearScreen(0xFF000000);
-        const auto bodies = world->GetBodies();
+        // The world is stepping, only its snapshot may be read.
+        const AeroWorldSnapshot2D& snapshot = world->GetSnapshot();
         int i = 0;
-        for (const auto& body : bodies) {
-            if (body->shape->GetType() == Circle) {
-                const auto circleShape = std::dynamic_pointer_cast<CircleShape>(body->shape);
-                Graphics::DrawFillCircle(body->position.x, body->position.y, circleShape->radius, m_bodyColors[i++]);
-            }
-            else  if (body->shape->GetType() == Box) {
-                const auto boxShape = std::dynamic_pointer_cast<BoxShape>(body->shape);
-                boxShape->UpdateVertices(body->rotation, body->position);
-                Graphics::DrawFillPolygon(body->position.x, body->position.y, boxShape->worldVertices, m_bodyColors[i++]);
+        for (const auto& body : snapshot.bodies) {
+            // Draw every body between its last two fixed steps, so motion is smooth at any frame rate.
+            const AeroVec2 position = body.GetInterpolatedPosition(snapshot.interpolation_alpha);
+            const real rotation = body.GetInterpolatedRotation(snapshot.interpolation_alpha);
+            if (body.shape->GetType() == Circle) {
+                const auto circleShape = std::dynamic_pointer_cast<const CircleShape>(body.shape);
+                Graphics::DrawFillCircle(position.x, position.y, circleShape->radius, m_bodyColors[i++]);
             }
-            else if (body->shape->GetType() == Polygon)
+            else if (body.shape->GetType() == Box || body.shape->GetType() == Polygon)
             {
-                const auto polygonShape = std::dynamic_pointer_cast<PolygonShape>(body->shape);
-                polygonShape->UpdateVertices(body->rotation, body->position);
-                Graphics::DrawFillPolygon(body->position.x, body->position.y, polygonShape->worldVertices, m_bodyColors[i++]);
+                const auto polygonShape = std::dynamic_pointer_cast<const PolygonShape>(body.shape);
+                Graphics::DrawFillPolygon(position.x, position.y, GetPoseVertices(*polygonShape, position, rotation), m_bodyColors[i++]);
             }
         }
+
+        // Hand the world back to this thread, the scene selector and the physics options change it between frames.
+        world->WaitForStep();
     }
 }
 